@@ -19,6 +19,7 @@
 #include <directive.h>
 #include <instruction.h>
 #include <operand.h>
+#include <section.h>
 #include <statement.h>
 #include <symtab.h>
 
@@ -26,7 +27,7 @@
 /**
  * encode_directive
  */
-Assembler_Status encode_directive(Encoding_Entity** encoded_directive,
+Assembler_Status encode_directive(Section* section,
 	const Symbol_Table* symtab,
 	const Directive* directive,
 	const size_t program_counter)
@@ -35,13 +36,22 @@ Assembler_Status encode_directive(Encoding_Entity** encoded_directive,
 	// Included to prevent non-use warning.
 	(void)program_counter;
 
-	size_t total_len = 0;
 	size_t count = 0;
 	size_t fill_size = 0;
 	size_t string_len;
+	/** The size of each value encoded by a data directive. */
+	size_t value_size = 0;
+	/** The value encoded by a data or fill directive. */
+	uint32_t value = 0;
+	/** The space in the section that the directive's data is encoded in. */
 	uint8_t* data = NULL;
-	size_t curr_pos = 0;
-	uint32_t* word_data = NULL;
+	/** The status of writing the directive data. */
+	Assembler_Status status = ASSEMBLER_STATUS_SUCCESS;
+
+	if(!section) {
+		fprintf(stderr, "Error: Invalid section provided to encoding function\n");
+		return CODEGEN_ERROR_INVALID_ARGS;
+	}
 
 	if(!symtab) {
 		fprintf(stderr, "Error: Invalid symbol table provided to encoding function\n");
@@ -53,16 +63,9 @@ Assembler_Status encode_directive(Encoding_Entity** encoded_directive,
 		return CODEGEN_ERROR_INVALID_ARGS;
 	}
 
-	*encoded_directive = malloc(sizeof(Encoding_Entity));
-	if(!encoded_directive) {
-		fprintf(stderr, "Error: Error allocating encoding entity\n");
-		return ASSEMBLER_ERROR_BAD_ALLOC;
-	}
-
-	(*encoded_directive)->n_reloc_entries = 0;
-	(*encoded_directive)->reloc_entries = NULL;
-	(*encoded_directive)->next = NULL;
-
+	// The data encoded for each directive must match the size calculated for it
+	// by `get_statement_size`, since the offsets of any following labels are
+	// derived from it.
 	switch(directive->type) {
 		case DIRECTIVE_ASCII:
 			if(directive->opseq.n_operands < 1) {
@@ -72,20 +75,14 @@ Assembler_Status encode_directive(Encoding_Entity** encoded_directive,
 			for(size_t i = 0; i < directive->opseq.n_operands; i++) {
 				// Iterate through each string operand.
 				string_len = strlen(directive->opseq.operands[i].string_literal);
-				curr_pos = total_len;
-				total_len += string_len;
-				data = realloc(data, total_len);
-				if(!data) {
-					fprintf(stderr, "Error: Error allocating directive data\n");
-					return ASSEMBLER_ERROR_BAD_ALLOC;
-				}
-
-				memcpy(data + curr_pos, &directive->opseq.operands[i].string_literal,
+				status = section_write(section, directive->opseq.operands[i].string_literal,
 					string_len);
+				if(!get_status(status)) {
+					// Error message printed in callee.
+					return status;
+				}
 			}
 
-			(*encoded_directive)->size = total_len;
-			(*encoded_directive)->data = data;
 			break;
 		case DIRECTIVE_STRING:
 		case DIRECTIVE_ASCIZ:
@@ -95,89 +92,123 @@ Assembler_Status encode_directive(Encoding_Entity** encoded_directive,
 
 			for(size_t i = 0; i < directive->opseq.n_operands; i++) {
 				string_len = strlen(directive->opseq.operands[i].string_literal);
-				curr_pos = total_len;
-				total_len += (1 + string_len);    // Take NUL terminator into account.
 
-				data = realloc(data, total_len);
-				if(!data) {
-					fprintf(stderr, "Error: Error allocating directive data\n");
-					return CODEGEN_ERROR_BAD_ALLOC;
+				// Take NUL terminator into account.
+				status = section_write(section, directive->opseq.operands[i].string_literal,
+					string_len + 1);
+				if(!get_status(status)) {
+					// Error message printed in callee.
+					return status;
 				}
-
-				memcpy(data + curr_pos, directive->opseq.operands[i].string_literal, string_len);
-
-				// Add NULL terminator.
-				data[total_len - 1] = '\0';
 			}
 
-			(*encoded_directive)->size = total_len;
-			(*encoded_directive)->data = data;
 			break;
 		case DIRECTIVE_BYTE:
-			break;
-		case DIRECTIVE_FILL:
-			break;
-		case DIRECTIVE_LONG:
-			break;
 		case DIRECTIVE_SHORT:
-			break;
-		case DIRECTIVE_SIZE:
-			break;
-		case DIRECTIVE_SKIP:
-			break;
-		case DIRECTIVE_SPACE:
+		case DIRECTIVE_LONG:
 		case DIRECTIVE_WORD:
 			if(directive->opseq.n_operands < 1) {
 				return CODEGEN_ERROR_OPERAND_COUNT_MISMATCH;
 			}
 
-			total_len = sizeof(uint32_t) * directive->opseq.n_operands;
+			if(directive->type == DIRECTIVE_BYTE) {
+				value_size = sizeof(uint8_t);
+			} else if(directive->type == DIRECTIVE_SHORT) {
+				value_size = sizeof(uint16_t);
+			} else {
+				value_size = sizeof(uint32_t);
+			}
 
-			word_data = malloc(total_len);
-			if(!word_data) {
-				fprintf(stderr, "Error: Error allocating directive data.\n");
+			data = section_append(section, value_size * directive->opseq.n_operands);
+			if(!data) {
+				// Error message printed in callee.
 				return ASSEMBLER_ERROR_BAD_ALLOC;
 			}
 
 			for(size_t i = 0; i < directive->opseq.n_operands; i++) {
-				// Create an array of each of the word operands.
+				// Encode each of the value operands.
 				if(directive->opseq.operands[i].type == OPERAND_TYPE_SYMBOL) {
 					Symbol* symbol = symtab_find_symbol(symtab,
-						directive->opseq.operands[i].string_literal);
+						directive->opseq.operands[i].symbol);
 					if(!symbol) {
-						// cleanup.
-						free(word_data);
-
 						fprintf(stderr, "Error: Error finding symbol `%s`\n",
-							directive->opseq.operands[i].string_literal);
+							string_pool_get(symtab->string_pool, directive->opseq.operands[i].symbol));
 						return CODEGEN_ERROR_MISSING_SYMBOL;
 					}
 
-					word_data[i] = symbol->offset;
+					value = symbol->offset;
 				} else if(directive->opseq.operands[i].type == OPERAND_TYPE_NUMERIC_LITERAL) {
-					word_data[i] = directive->opseq.operands[i].numeric_literal;
+					value = directive->opseq.operands[i].numeric_literal;
 				} else {
-					// cleanup.
-					free(word_data);
 					return CODEGEN_ERROR_BAD_OPERAND_TYPE;
 				}
+
+				// Values are truncated to the directive's size, in the target's
+				// little-endian byte order.
+				for(size_t b = 0; b < value_size; b++) {
+					data[(i * value_size) + b] = (value >> (b * 8)) & 0xFF;
+				}
 			}
 
-			data = malloc(total_len);
-			if(!data) {
-				// cleanup.
-				free(word_data);
+			break;
+		case DIRECTIVE_FILL:
+			if(directive->opseq.n_operands < 1) {
+				return CODEGEN_ERROR_OPERAND_COUNT_MISMATCH;
+			}
+
+			// The size and value operands are optional, as per GAS docs.
+			count = directive->opseq.operands[0].numeric_literal;
+			fill_size = 1;
+			if(directive->opseq.n_operands > 1) {
+				fill_size = directive->opseq.operands[1].numeric_literal;
+			}
+
+			if(fill_size > 8) {
+				fill_size = 8;
+			}
+
+			if(directive->opseq.n_operands > 2) {
+				value = directive->opseq.operands[2].numeric_literal;
+			}
+
+			data = section_append(section, count * fill_size);
+			if(!data && count * fill_size > 0) {
+				// Error message printed in callee.
+				return ASSEMBLER_ERROR_BAD_ALLOC;
+			}
+
+			for(size_t i = 0; i < count; i++) {
+				// Any bytes beyond the width of the value are zero.
+				for(size_t b = 0; b < fill_size; b++) {
+					data[(i * fill_size) + b] = b < sizeof(uint32_t) ?
+						(value >> (b * 8)) & 0xFF : 0;
+				}
+			}
 
-				fprintf(stderr, "Error: Error allocating directive data");
+			break;
+		case DIRECTIVE_SKIP:
+		case DIRECTIVE_SPACE:
+			if(directive->opseq.n_operands < 1) {
+				return CODEGEN_ERROR_OPERAND_COUNT_MISMATCH;
+			}
+
+			count = directive->opseq.operands[0].numeric_literal;
+			if(directive->opseq.n_operands > 1) {
+				value = directive->opseq.operands[1].numeric_literal;
+			}
+
+			data = section_append(section, count);
+			if(!data && count > 0) {
+				// Error message printed in callee.
 				return ASSEMBLER_ERROR_BAD_ALLOC;
 			}
 
-			memcpy(data, word_data, total_len);
-			(*encoded_directive)->size = total_len;
-			(*encoded_directive)->data = data;
-			(*encoded_directive)->next = NULL;
+			if(count > 0) {
+				memset(data, value & 0xFF, count);
+			}
 
-			free(word_data);
+			break;
+		case DIRECTIVE_SIZE:
 			break;
 		// Non-encoded directives.
 		case DIRECTIVE_ALIGN:
@@ -200,7 +231,7 @@ Assembler_Status encode_directive(Encoding_Entity** encoded_directive,
 /**
  * encode_i_type
  */
-Assembler_Status encode_i_type(Encoding_Entity** encoded_instruction,
+Assembler_Status encode_i_type(Section* section,
 	const Symbol_Table* symbol_table,
 	const uint8_t opcode,
 	const uint8_t rs,
@@ -211,29 +242,15 @@ Assembler_Status encode_i_type(Encoding_Entity** encoded_instruction,
 	/** The 'immediate' field encoding. */
 	uint32_t immediate = 0;
 	/** The instruction encoding. */
-	uint32_t* encoding = NULL;
-
-	*encoded_instruction = malloc(sizeof(Encoding_Entity));
-	if(!*encoded_instruction) {
-		fprintf(stderr, "Error: Error allocating encoded instruction\n");
-
-		return ASSEMBLER_ERROR_BAD_ALLOC;
-	}
-
-	(*encoded_instruction)->n_reloc_entries = 0;
-	(*encoded_instruction)->reloc_entries = NULL;
-
-	encoding = malloc(sizeof(uint32_t));
-	if(!*encoded_instruction) {
-		fprintf(stderr, "Error: Error allocating instruction encoding\n");
-
-		return ASSEMBLER_ERROR_BAD_ALLOC;
-	}
+	uint32_t encoding = 0;
+	/** The relocation type required by a symbolic immediate. */
+	uint32_t reloc_type = R_MIPS_PC16;
+	/** The status of writing the encoding. */
+	Assembler_Status status = ASSEMBLER_STATUS_SUCCESS;
 
-	*encoding = 0;
-	*encoding |= opcode << 26;
-	*encoding |= rs << 21;
-	*encoding |= rt << 16;
+	encoding |= opcode << 26;
+	encoding |= rs << 21;
+	encoding |= rt << 16;
 
 	if(imm.type == OPERAND_TYPE_NUMERIC_LITERAL) {
 		// If the operand is a numeric literal, the raw value is encoded.
@@ -244,67 +261,47 @@ Assembler_Status encode_i_type(Encoding_Entity** encoded_instruction,
 		// symbol can be linked correctly.
 		Symbol* symbol = symtab_find_symbol(symbol_table, imm.symbol);
 		if(!symbol) {
-			fprintf(stderr, "Error: Error finding symbol `%s`", imm.symbol);
-
-			// cleanup.
-			free(encoding);
-			free(*encoded_instruction);
+			fprintf(stderr, "Error: Error finding symbol `%s`",
+				string_pool_get(symbol_table->string_pool, imm.symbol));
 
 			return ASSEMBLER_ERROR_MISSING_SYMBOL;
 		}
 
 		immediate = symbol->offset;
 
-		(*encoded_instruction)->n_reloc_entries = 1;
-		(*encoded_instruction)->reloc_entries = malloc(sizeof(Reloc_Entry));
-		if(!(*encoded_instruction)->reloc_entries) {
-			fprintf(stderr, "Error: Error allocating relocation entries");
-
-			// cleanup.
-			free(encoding);
-			free(*encoded_instruction);
-
-			return ASSEMBLER_ERROR_BAD_ALLOC;
-		}
-
-		(*encoded_instruction)->reloc_entries[0].symbol_name = imm.symbol;
-		(*encoded_instruction)->reloc_entries[0].offset = program_counter;
 		if(imm.flags.mask == OPERAND_MASK_HIGH) {
 			// If this is the higher component of a symbol.
 			// Most likely the result of a macro expansion. Refer to the macro
 			// expansion logic for the relevant architecture.
-			(*encoded_instruction)->reloc_entries[0].type = R_MIPS_HI16;
+			reloc_type = R_MIPS_HI16;
 		} else if(imm.flags.mask == OPERAND_MASK_LOW) {
-			(*encoded_instruction)->reloc_entries[0].type = R_MIPS_LO16;
-		} else {
-			(*encoded_instruction)->reloc_entries[0].type = R_MIPS_PC16;
+			reloc_type = R_MIPS_LO16;
+		}
+
+		status = section_add_reloc_entry(section, imm.symbol, program_counter,
+			reloc_type);
+		if(!get_status(status)) {
+			// Error message printed in callee.
+			return status;
 		}
 	} else {
 		// If the immediate is of any other type, it is an error.
 		fprintf(stderr, "Error: Bad operand type `%u` for immediate type instruction",
 			imm.type);
 
-		// cleanup.
-		free(encoding);
-		free(*encoded_instruction);
-
 		return CODEGEN_ERROR_BAD_OPERAND_TYPE;
 	}
 
-	*encoding |= immediate & 0xFFFF;
-
-	(*encoded_instruction)->size = 4;
-	(*encoded_instruction)->data = (uint8_t*)encoding;
-	(*encoded_instruction)->next = NULL;
+	encoding |= immediate & 0xFFFF;
 
-	return ASSEMBLER_STATUS_SUCCESS;
+	return section_write(section, &encoding, sizeof(uint32_t));
 }
 
 
 /**
  * encode_r_type
  */
-Assembler_Status encode_r_type(Encoding_Entity** encoded_instruction,
+Assembler_Status encode_r_type(Section* section,
 	const uint8_t opcode,
 	const uint8_t rd,
 	const uint8_t rs,
@@ -313,48 +310,24 @@ Assembler_Status encode_r_type(Encoding_Entity** encoded_instruction,
 	const uint8_t func)
 {
 	/** The instruction encoding. */
-	uint32_t* encoding = NULL;
+	uint32_t encoding = 0;
 
-	*encoded_instruction = malloc(sizeof(Encoding_Entity));
-	if(!*encoded_instruction) {
-		fprintf(stderr, "Error allocating encoded instruction.\n");
-		return ASSEMBLER_ERROR_BAD_ALLOC;
-	}
-
-	// The encoding entity is declared on the heap, since a pointer to this data
-	// will be stored in the `encoded_instruction` entity.
-	encoding = malloc(sizeof(uint32_t));
-	if(!encoding) {
-		// Cleanup instruction data.
-		free(*encoded_instruction);
-
-		fprintf(stderr, "Error allocating instruction encoding\n");
-		return ASSEMBLER_ERROR_BAD_ALLOC;
-	}
-
-	*encoding = opcode << 26;
-	*encoding |= rs << 21;
-	*encoding |= rt << 16;
-	*encoding |= rd << 11;
+	encoding = opcode << 26;
+	encoding |= rs << 21;
+	encoding |= rt << 16;
+	encoding |= rd << 11;
 	// Truncated to 5 bits.
-	*encoding |= (sa & 0x1F) << 6;
-	*encoding |= func;
-
-	(*encoded_instruction)->n_reloc_entries = 0;
-	(*encoded_instruction)->reloc_entries = NULL;
+	encoding |= (sa & 0x1F) << 6;
+	encoding |= func;
 
-	(*encoded_instruction)->size = 4;
-	(*encoded_instruction)->data = (uint8_t*)encoding;
-	(*encoded_instruction)->next = NULL;
-
-	return ASSEMBLER_STATUS_SUCCESS;
+	return section_write(section, &encoding, sizeof(uint32_t));
 }
 
 
 /**
  * encode_offset_type
  */
-Assembler_Status encode_offset_type(Encoding_Entity** encoded_instruction,
+Assembler_Status encode_offset_type(Section* section,
 	const uint8_t opcode,
 	const uint8_t rt,
 	const Operand offset_reg)
@@ -364,7 +337,7 @@ Assembler_Status encode_offset_type(Encoding_Entity** encoded_instruction,
 	/** The 'base' field encoding. */
 	uint8_t base = 0;
 	/** The instruction encoding. */
-	uint32_t* encoding = NULL;
+	uint32_t encoding = 0;
 
 	// Unlike GAS, this assembler currently does not support using symbols as an offset value.
 	if(offset_reg.type != OPERAND_TYPE_REGISTER) {
@@ -373,46 +346,23 @@ Assembler_Status encode_offset_type(Encoding_Entity** encoded_instruction,
 		return ASSEMBLER_ERROR_BAD_ALLOC;
 	}
 
-	*encoded_instruction = malloc(sizeof(Encoding_Entity));
-	if(!*encoded_instruction) {
-		fprintf(stderr, "Error: Error allocating encoded instruction\n");
-		return ASSEMBLER_ERROR_BAD_ALLOC;
-	}
-
 	// Truncate to 16bits.
 	offset = offset_reg.offset & 0xFFFF;
 	base = encode_operand_register(offset_reg.reg);
 
-	encoding = malloc(sizeof(uint32_t));
-	if(!encoding) {
-		// cleanup.
-		free(*encoded_instruction);
-
-		fprintf(stderr, "Error: Error allocating encoded instruction data\n");
-		return ASSEMBLER_ERROR_BAD_ALLOC;
-	}
+	encoding = opcode << 26;
+	encoding |= base << 21;
+	encoding |= rt << 16;
+	encoding |= offset;
 
-	*encoding = opcode << 26;
-	*encoding |= base << 21;
-	*encoding |= rt << 16;
-	*encoding |= offset;
-
-	(*encoded_instruction)->n_reloc_entries = 0;
-	(*encoded_instruction)->reloc_entries = NULL;
-
-	(*encoded_instruction)->size = 4;
-
-	(*encoded_instruction)->data = (uint8_t*)encoding;
-	(*encoded_instruction)->next = NULL;
-
-	return ASSEMBLER_STATUS_SUCCESS;
+	return section_write(section, &encoding, sizeof(uint32_t));
 }
 
 
 /**
  * encode_j_type
  */
-Assembler_Status encode_j_type(Encoding_Entity** encoded_instruction,
+Assembler_Status encode_j_type(Section* section,
 	const Symbol_Table* symbol_table,
 	const uint8_t opcode,
 	const Operand imm,
@@ -421,322 +371,372 @@ Assembler_Status encode_j_type(Encoding_Entity** encoded_instruction,
 	/** The immediate value to encode. */
 	uint32_t immediate = 0;
 	/** The instruction encoding. */
-	uint32_t* encoding = NULL;
+	uint32_t encoding = 0;
+	/** The status of writing the encoding. */
+	Assembler_Status status = ASSEMBLER_STATUS_SUCCESS;
 
 	if(!symbol_table) {
 		fprintf(stderr, "Error: Invalid symbol table provided to encoding function\n");
 		return ASSEMBLER_ERROR_MISSING_SYMBOL;
 	}
 
-	*encoded_instruction = malloc(sizeof(Encoding_Entity));
-	if(!*encoded_instruction) {
-		fprintf(stderr, "Error: Error allocating encoded instruction\n");
-
-		return ASSEMBLER_ERROR_BAD_ALLOC;
-	}
-
-	(*encoded_instruction)->n_reloc_entries = 0;
-	(*encoded_instruction)->reloc_entries = NULL;
-
 	if(imm.type == OPERAND_TYPE_NUMERIC_LITERAL) {
 		immediate = imm.numeric_literal;
 	} else if(imm.type == OPERAND_TYPE_SYMBOL) {
 		Symbol* symbol = symtab_find_symbol(symbol_table, imm.symbol);
+		if(!symbol) {
+			fprintf(stderr, "Error: Error finding symbol `%s`\n",
+				string_pool_get(symbol_table->string_pool, imm.symbol));
 
-		(*encoded_instruction)->n_reloc_entries = 1;
-		(*encoded_instruction)->reloc_entries = malloc(sizeof(Reloc_Entry));
-		if(!(*encoded_instruction)->reloc_entries) {
-			fprintf(stderr, "Error: Error allocating relocation entries\n");
-
-			// cleanup.
-			free(*encoded_instruction);
-
-			return ASSEMBLER_ERROR_BAD_ALLOC;
+			return CODEGEN_ERROR_MISSING_SYMBOL;
 		}
 
-		(*encoded_instruction)->reloc_entries[0].type = R_MIPS_26;
-		(*encoded_instruction)->reloc_entries[0].symbol_name = symbol->name;
-		(*encoded_instruction)->reloc_entries[0].offset = program_counter;
+		status = section_add_reloc_entry(section, symbol->name, program_counter,
+			R_MIPS_26);
+		if(!get_status(status)) {
+			// Error message printed in callee.
+			return status;
+		}
 
 		immediate = symbol->offset;
 	} else {
 		fprintf(stderr, "Error: Bad operand type for jump type instruction");
 
-		// cleanup.
-		free(*encoded_instruction);
-
 		return ASSEMBLER_ERROR_BAD_OPERAND_TYPE;
 	}
 
 	immediate = (immediate & 0x0FFFFFFF) >> 2;
 
-	encoding = malloc(sizeof(uint32_t));
-	if(!encoding) {
-		fprintf(stderr, "Error: Error allocating encoded instruction data\n");
-
-		// cleanup.
-		free(*encoded_instruction);
-
-		return ASSEMBLER_ERROR_BAD_ALLOC;
-	}
-
-	*encoding = opcode << 26;
+	encoding = opcode << 26;
 
 	// Truncate to 26bits.
-	*encoding |= (immediate & 0x7FFFFFF);
-
-	(*encoded_instruction)->size = 4;
-	(*encoded_instruction)->data = (uint8_t*)encoding;
-	(*encoded_instruction)->next = NULL;
+	encoding |= (immediate & 0x7FFFFFF);
 
-	return ASSEMBLER_STATUS_SUCCESS;
+	return section_write(section, &encoding, sizeof(uint32_t));
 }
 
 /**
- * encode_instruction
+ * @brief The encoding fields of an instruction.
+ * Holds the fields of an instruction that are supplied by its operands, or
+ * fixed by its instruction description.
  */
-Assembler_Status encode_instruction(Encoding_Entity** encoded_instruction,
-	const Symbol_Table* symtab,
-	const Instruction* instruction,
-	const size_t program_counter)
-{
-	if(!symtab) {
-		fprintf(stderr, "Error: Invalid symbol table provided to encoding function\n");
-		return CODEGEN_ERROR_INVALID_ARGS;
-	}
-
-	if(!instruction) {
-		fprintf(stderr, "Error: Invalid instruction provided to encoding function\n");
-		return CODEGEN_ERROR_INVALID_ARGS;
-	}
-
-	/** The 'opcode' field encoding. */
-	uint8_t opcode = 0;
-	/** The 'func' field encoding. */
-	uint8_t func = 0;
+typedef struct {
 	/** The 'rd' field encoding. */
-	uint8_t rd = 0;
+	uint8_t rd;
 	/** The 'rs' field encoding. */
-	uint8_t rs = 0;
+	uint8_t rs;
 	/** The 'rt' field encoding. */
-	uint8_t rt = 0;
+	uint8_t rt;
 	/** The 'sa' field encoding. */
-	uint8_t sa = 0;
-	/** The status of the encoding process. */
-	Assembler_Status status = ASSEMBLER_STATUS_SUCCESS;
+	uint8_t sa;
+	/** The immediate, offset or jump target operand. */
+	Operand imm;
+} Instruction_Fields;
 
-	switch(instruction->opcode) {
-		case OPCODE_ADD:
-		case OPCODE_ADDU:
-		case OPCODE_AND:
-		case OPCODE_MUH:
-		case OPCODE_MUHU:
-		case OPCODE_MUL:
-		case OPCODE_MULU:
-		case OPCODE_OR:
-		case OPCODE_SUB:
-		case OPCODE_SUBU:
-			if(!check_operand_count(3, &instruction->opseq)) {
-				return CODEGEN_ERROR_OPERAND_COUNT_MISMATCH;
-			}
 
-			if(instruction->opcode == OPCODE_ADD) {
-				func = 0x20;
-			} else if(instruction->opcode == OPCODE_ADDU) {
-				func = 0x21;
-			} else if(instruction->opcode == OPCODE_AND) {
-				func = 0x24;
-			} else if(instruction->opcode == OPCODE_MUH) {
-				sa = 0x3;
-				func = 0x18;
-			} else if(instruction->opcode == OPCODE_MUHU) {
-				sa = 0x3;
-				func = 0x19;
-			} else if(instruction->opcode == OPCODE_MUL) {
-				sa = 0x2;
-				func = 0x18;
-			} else if(instruction->opcode == OPCODE_MULU) {
-				sa = 0x2;
-				func = 0x19;
-			} else if(instruction->opcode == OPCODE_OR) {
-				func = 0x25;
-			} else if(instruction->opcode == OPCODE_SUB) {
-				func = 0x22;
-			} else if(instruction->opcode == OPCODE_SUBU) {
-				func = 0x23;
-			}
+/**
+ * @brief Maps an instruction's operands onto its encoding fields.
+ *
+ * Checks that an instruction can be encoded, and that its operands match its
+ * operand signature, then maps the operands onto the encoding fields.
+ * @param description The description of the instruction's opcode.
+ * @param instruction The instruction to map the operands of.
+ * @param fields A pointer to the resulting encoding fields.
+ * @return The status of the operation.
+ */
+static Assembler_Status map_instruction_operands(const Instruction_Description* description,
+	const Instruction* instruction,
+	Instruction_Fields* fields)
+{
+	/** The instruction's operands. */
+	const Operand* operands = instruction->opseq.operands;
+
+	fields->rd = 0;
+	fields->rs = 0;
+	fields->rt = description->rt;
+	fields->sa = description->sa;
+	fields->imm = (Operand){ 0 };
+
+	if(description->deprecated) {
+		fprintf(stderr, "Instruction deprecated in `MIPS32r6`\n");
+		return CODEGEN_ERROR_DEPRECATED_OPCODE;
+	}
 
-			rd = encode_operand_register(instruction->opseq.operands[0].reg);
-			rs = encode_operand_register(instruction->opseq.operands[1].reg);
-			rt = encode_operand_register(instruction->opseq.operands[2].reg);
-			status = encode_r_type(encoded_instruction, opcode, rd, rs, rt, 0, func);
-			if(!get_status(status)) {
-				return status;
-			}
+	if(description->type == INSTRUCTION_TYPE_UNKNOWN) {
+		fprintf(stderr, "Error: Unrecognised Opcode\n");
+		return CODEGEN_ERROR_BAD_OPCODE;
+	}
 
-			break;
-		case OPCODE_ADDI:
-		case OPCODE_ADDIU:
-		case OPCODE_ANDI:
-		case OPCODE_BEQ:
-		case OPCODE_BGEZ:
-		case OPCODE_BNE:
-		case OPCODE_ORI:
-			if(!check_operand_count(3, &instruction->opseq)) {
+	switch(description->signature) {
+		case OPERAND_SIGNATURE_NONE:
+			// @TODO: Investigate use of the `SYSCALL` `code` field.
+			if(!check_operand_count(0, &instruction->opseq)) {
 				return CODEGEN_ERROR_OPERAND_COUNT_MISMATCH;
 			}
 
-			if(instruction->opcode == OPCODE_ADDI) {
-				opcode = 0x8;
-			} else if(instruction->opcode == OPCODE_ADDIU) {
-				opcode = 0x9;
-			} else if(instruction->opcode == OPCODE_ANDI) {
-				opcode = 0xC;
-			} else if(instruction->opcode == OPCODE_BEQ) {
-				opcode = 0x4;
-			} else if(instruction->opcode == OPCODE_BGEZ) {
-				opcode = 0x14;
-			} else if(instruction->opcode == OPCODE_BNE) {
-				opcode = 0x5;
-			} else if(instruction->opcode == OPCODE_ORI) {
-				opcode = 0xD;
-			}
-
-			rs = encode_operand_register(instruction->opseq.operands[1].reg);
-			rt = encode_operand_register(instruction->opseq.operands[0].reg);
-
-			status = encode_i_type(encoded_instruction, symtab, opcode, rs, rt,
-				instruction->opseq.operands[2], program_counter);
 			break;
-		case OPCODE_LB:
-		case OPCODE_LBU:
-		case OPCODE_LW:
-		case OPCODE_SB:
-		case OPCODE_SH:
-		case OPCODE_SW:
-			if(instruction->opcode == OPCODE_LB) {
-				opcode = 0x20;
-			} else if(instruction->opcode == OPCODE_LBU) {
-				opcode = 0x24;
-			} else if(instruction->opcode == OPCODE_LW) {
-				opcode = 0x23;
-			} else if(instruction->opcode == OPCODE_SB) {
-				opcode = 0x28;
-			} else if(instruction->opcode == OPCODE_SH) {
-				opcode = 0x29;
-			} else if(instruction->opcode == OPCODE_SW) {
-				opcode = 0x2B;
-			}
-
-			if(!check_operand_count(2, &instruction->opseq)) {
+		case OPERAND_SIGNATURE_IMM:
+		case OPERAND_SIGNATURE_TARGET:
+			if(!check_operand_count(1, &instruction->opseq)) {
 				return CODEGEN_ERROR_OPERAND_COUNT_MISMATCH;
 			}
 
-			rt = encode_operand_register(instruction->opseq.operands[0].reg);
-			status = encode_offset_type(encoded_instruction, opcode, rt,
-				instruction->opseq.operands[1]);
+			fields->imm = operands[0];
 			break;
-		case OPCODE_BAL:
-			if(!check_operand_count(1, &instruction->opseq)) {
+		case OPERAND_SIGNATURE_RD_RS:
+			// The destination register is optional, defaulting to `$ra`.
+			if(instruction->opseq.n_operands == 1) {
+				fields->rd = encode_operand_register(REGISTER_$RA);
+				fields->rs = encode_operand_register(operands[0].reg);
+			} else if(instruction->opseq.n_operands == 2) {
+				fields->rd = encode_operand_register(operands[0].reg);
+				fields->rs = encode_operand_register(operands[1].reg);
+			} else {
 				return CODEGEN_ERROR_OPERAND_COUNT_MISMATCH;
 			}
 
-			status = encode_i_type(encoded_instruction, symtab, 1, 0, 0x11,
-				instruction->opseq.operands[2], program_counter);
 			break;
-		case OPCODE_J:
-		case OPCODE_JAL:
-			if(!check_operand_count(1, &instruction->opseq)) {
+		case OPERAND_SIGNATURE_RD_RS_RT:
+			if(!check_operand_count(3, &instruction->opseq)) {
 				return CODEGEN_ERROR_OPERAND_COUNT_MISMATCH;
 			}
 
-			if(instruction->opcode == OPCODE_J) {
-				opcode = 0x2;
-			} else if(instruction->opcode == OPCODE_J) {
-				opcode = 0x3;
-			}
-
-			status = encode_j_type(encoded_instruction, symtab, opcode,
-				instruction->opseq.operands[0], program_counter);
+			fields->rd = encode_operand_register(operands[0].reg);
+			fields->rs = encode_operand_register(operands[1].reg);
+			fields->rt = encode_operand_register(operands[2].reg);
 			break;
-		case OPCODE_JALR:
-			if(!check_operand_count(1, &instruction->opseq)) {
+		case OPERAND_SIGNATURE_RD_RT_SA:
+			if(!check_operand_count(3, &instruction->opseq)) {
 				return CODEGEN_ERROR_OPERAND_COUNT_MISMATCH;
 			}
 
-			if(instruction->opseq.n_operands == 1) {
-				rd = 0x1F;
-			} else {
-				rd = encode_operand_register(instruction->opseq.operands[0].reg);
-				rs = encode_operand_register(instruction->opseq.operands[1].reg);
-			}
-
-			status = encode_r_type(encoded_instruction, 0, rd, rs, 0, 0, 0x9);
+			fields->rd = encode_operand_register(operands[0].reg);
+			fields->rt = encode_operand_register(operands[1].reg);
+			fields->sa = operands[2].numeric_literal;
 			break;
-		case OPCODE_JR:
+		case OPERAND_SIGNATURE_RS:
 			if(!check_operand_count(1, &instruction->opseq)) {
 				return CODEGEN_ERROR_OPERAND_COUNT_MISMATCH;
 			}
 
-			rs = encode_operand_register(instruction->opseq.operands[0].reg);
-			status = encode_r_type(encoded_instruction, 0, 0, rs, 0, 0, 0x9);
+			fields->rs = encode_operand_register(operands[0].reg);
 			break;
-		case OPCODE_LUI:
+		case OPERAND_SIGNATURE_RS_IMM:
 			if(!check_operand_count(2, &instruction->opseq)) {
 				return CODEGEN_ERROR_OPERAND_COUNT_MISMATCH;
 			}
 
-			rt = encode_operand_register(instruction->opseq.operands[0].reg);
-			status = encode_i_type(encoded_instruction, symtab, 0xF, 0, rt,
-				instruction->opseq.operands[1], program_counter);
+			fields->rs = encode_operand_register(operands[0].reg);
+			fields->imm = operands[1];
 			break;
-		case OPCODE_MULT:
-		case OPCODE_MULTU:
-			fprintf(stderr, "Instruction deprecated in `MIPS32r6`\n");
-			status = CODEGEN_ERROR_DEPRECATED_OPCODE;
-
-			break;
-		case OPCODE_NOP:
-			if(!check_operand_count(0, &instruction->opseq)) {
+		case OPERAND_SIGNATURE_RT_IMM:
+		case OPERAND_SIGNATURE_RT_OFFSET:
+			if(!check_operand_count(2, &instruction->opseq)) {
 				return CODEGEN_ERROR_OPERAND_COUNT_MISMATCH;
 			}
 
-			status = encode_r_type(encoded_instruction, 0, 0, 0, 0, 0, 0);
+			fields->rt = encode_operand_register(operands[0].reg);
+			fields->imm = operands[1];
 			break;
-		case OPCODE_SLL:
+		case OPERAND_SIGNATURE_RT_RS_IMM:
 			if(!check_operand_count(3, &instruction->opseq)) {
 				return CODEGEN_ERROR_OPERAND_COUNT_MISMATCH;
 			}
 
-			rd = encode_operand_register(instruction->opseq.operands[0].reg);
-			sa = instruction->opseq.operands[2].numeric_literal;
-			status = encode_r_type(encoded_instruction, 0, rd, 0, rt, sa, 0x0);
-			break;
-		case OPCODE_SYSCALL:
-			// @TODO: Investigate use of `code` field.
-			status = encode_r_type(encoded_instruction, 0, 0, 0, 0, 0, 0xC);
+			fields->rt = encode_operand_register(operands[0].reg);
+			fields->rs = encode_operand_register(operands[1].reg);
+			fields->imm = operands[2];
 			break;
-		case OPCODE_UNKNOWN:
+		default:
+			fprintf(stderr, "Error: Unknown operand signature\n");
+			return CODEGEN_ERROR_BAD_OPCODE;
+	}
+
+	return ASSEMBLER_STATUS_SUCCESS;
+}
+
+
+/**
+ * encode_instruction
+ */
+Assembler_Status encode_instruction(Section* section,
+	const Symbol_Table* symtab,
+	const Instruction* instruction,
+	const size_t program_counter)
+{
+	if(!symtab) {
+		fprintf(stderr, "Error: Invalid symbol table provided to encoding function\n");
+		return CODEGEN_ERROR_INVALID_ARGS;
+	}
+
+	if(!instruction) {
+		fprintf(stderr, "Error: Invalid instruction provided to encoding function\n");
+		return CODEGEN_ERROR_INVALID_ARGS;
+	}
+
+	/** The description of the instruction's encoding. */
+	const Instruction_Description* description =
+		get_instruction_description(instruction->opcode);
+	/** The instruction's encoding fields. */
+	Instruction_Fields fields;
+	/** The status of the encoding process. */
+	Assembler_Status status = map_instruction_operands(description, instruction,
+		&fields);
+	if(!get_status(status)) {
+		// Error message printed in callee.
+		return status;
+	}
+
+	// Any generated errors will be propagated upwards from the encoding functions.
+	switch(description->type) {
+		case INSTRUCTION_TYPE_IMMEDIATE:
+			return encode_i_type(section, symtab, description->opcode, fields.rs,
+				fields.rt, fields.imm, program_counter);
+		case INSTRUCTION_TYPE_JUMP:
+			return encode_j_type(section, symtab, description->opcode,
+				fields.imm, program_counter);
+		case INSTRUCTION_TYPE_OFFSET:
+			return encode_offset_type(section, description->opcode, fields.rt,
+				fields.imm);
+		case INSTRUCTION_TYPE_REGISTER:
+			return encode_r_type(section, description->opcode, fields.rd, fields.rs,
+				fields.rt, fields.sa, description->func);
+		case INSTRUCTION_TYPE_UNKNOWN:
 		default:
 			fprintf(stderr, "Error: Unrecognised Opcode\n");
 			return CODEGEN_ERROR_BAD_OPCODE;
 	}
+}
+
 
-	// The status code will have been set by the encoding function.
-	// Any generated errors will be propagated upwards from here.
-	return status;
+/**
+ * encode_instruction_batch
+ */
+Assembler_Status encode_instruction_batch(const Symbol_Table* symtab,
+	const Instruction* instructions,
+	const size_t n_instructions,
+	const size_t program_counter,
+	uint32_t* encoding,
+	Reloc_Entry* reloc_entries,
+	size_t* n_reloc_entries)
+{
+	/** The description of the instruction currently being encoded. */
+	const Instruction_Description* description = NULL;
+	/** The encoding fields of the instruction currently being encoded. */
+	Instruction_Fields fields;
+	/** The immediate field encoding. */
+	uint32_t immediate = 0;
+	/** The number of relocation entries generated. */
+	size_t n_relocs = 0;
+	/** The status of the encoding process. */
+	Assembler_Status status = ASSEMBLER_STATUS_SUCCESS;
+
+	// The arguments are validated once for the whole batch.
+	if(!symtab || (n_instructions > 0 && (!instructions || !encoding)) ||
+		!reloc_entries || !n_reloc_entries) {
+		fprintf(stderr, "Error: Invalid arguments provided to batch encoding function\n");
+		return CODEGEN_ERROR_INVALID_ARGS;
+	}
+
+	for(size_t i = 0; i < n_instructions; i++) {
+		description = get_instruction_description(instructions[i].opcode);
+		status = map_instruction_operands(description, &instructions[i], &fields);
+		if(!get_status(status)) {
+			// Error message printed in callee.
+			return status;
+		}
+
+		encoding[i] = (uint32_t)description->opcode << 26;
+
+		switch(description->type) {
+			case INSTRUCTION_TYPE_REGISTER:
+				encoding[i] |= fields.rs << 21;
+				encoding[i] |= fields.rt << 16;
+				encoding[i] |= fields.rd << 11;
+				encoding[i] |= (fields.sa & 0x1F) << 6;
+				encoding[i] |= description->func;
+
+				continue;
+			case INSTRUCTION_TYPE_OFFSET:
+				if(fields.imm.type != OPERAND_TYPE_REGISTER) {
+					fprintf(stderr, "Error: Bad operand type `%u` for offset-type instruction\n",
+						fields.imm.type);
+					return CODEGEN_ERROR_BAD_OPERAND_TYPE;
+				}
+
+				encoding[i] |= encode_operand_register(fields.imm.reg) << 21;
+				encoding[i] |= fields.rt << 16;
+				encoding[i] |= fields.imm.offset & 0xFFFF;
+
+				continue;
+			case INSTRUCTION_TYPE_IMMEDIATE:
+				encoding[i] |= fields.rs << 21;
+				encoding[i] |= fields.rt << 16;
+				break;
+			case INSTRUCTION_TYPE_JUMP:
+				break;
+			case INSTRUCTION_TYPE_UNKNOWN:
+			default:
+				fprintf(stderr, "Error: Unrecognised Opcode\n");
+				return CODEGEN_ERROR_BAD_OPCODE;
+		}
+
+		// Immediate and jump type instructions encode either a numeric literal, or
+		// the offset of a symbol with a relocation entry so that it can be linked.
+		if(fields.imm.type == OPERAND_TYPE_NUMERIC_LITERAL) {
+			immediate = fields.imm.numeric_literal;
+		} else if(fields.imm.type == OPERAND_TYPE_SYMBOL) {
+			Symbol* symbol = symtab_find_symbol(symtab, fields.imm.symbol);
+			if(!symbol) {
+				fprintf(stderr, "Error: Error finding symbol `%s`\n",
+					string_pool_get(symtab->string_pool, fields.imm.symbol));
+				return CODEGEN_ERROR_MISSING_SYMBOL;
+			}
+
+			immediate = symbol->offset;
+
+			reloc_entries[n_relocs].symbol_name = fields.imm.symbol;
+			reloc_entries[n_relocs].offset = program_counter + (i * sizeof(uint32_t));
+			if(description->type == INSTRUCTION_TYPE_JUMP) {
+				reloc_entries[n_relocs].type = R_MIPS_26;
+			} else if(fields.imm.flags.mask == OPERAND_MASK_HIGH) {
+				reloc_entries[n_relocs].type = R_MIPS_HI16;
+			} else if(fields.imm.flags.mask == OPERAND_MASK_LOW) {
+				reloc_entries[n_relocs].type = R_MIPS_LO16;
+			} else {
+				reloc_entries[n_relocs].type = R_MIPS_PC16;
+			}
+
+			n_relocs++;
+		} else {
+			fprintf(stderr, "Error: Bad operand type `%u` for immediate operand\n",
+				fields.imm.type);
+			return CODEGEN_ERROR_BAD_OPERAND_TYPE;
+		}
+
+		if(description->type == INSTRUCTION_TYPE_JUMP) {
+			// Truncate to 26bits.
+			encoding[i] |= ((immediate & 0x0FFFFFFF) >> 2) & 0x3FFFFFF;
+		} else {
+			encoding[i] |= immediate & 0xFFFF;
+		}
+	}
+
+	*n_reloc_entries = n_relocs;
+
+	return ASSEMBLER_STATUS_SUCCESS;
 }
 
 /**
  * get_encoding_as_string
  */
-char* get_encoding_as_string(const Encoding_Entity* encoded_instruction)
+char* get_encoding_as_string(const uint8_t* encoded_instruction)
 {
 	/** Integer representation of the instruction encoding. */
-	uint32_t encoding_representation = encoded_instruction->data[0] << 24;
-	encoding_representation |= encoded_instruction->data[1] << 16;
-	encoding_representation |= encoded_instruction->data[2] << 8;
-	encoding_representation |= encoded_instruction->data[3];
+	uint32_t encoding_representation = encoded_instruction[0] << 24;
+	encoding_representation |= encoded_instruction[1] << 16;
+	encoding_representation |= encoded_instruction[2] << 8;
+	encoding_representation |= encoded_instruction[3];
 
 	/** The required length for the string representation. */
 	int required_len = snprintf(NULL, 0, "0x%x", encoding_representation);
@@ -746,7 +746,7 @@ char* get_encoding_as_string(const Encoding_Entity* encoded_instruction)
 	}
 
 	/** Buffer to hold the representation of the encoding. */
-	char* representation = malloc(required_len);
+	char* representation = malloc(required_len + 1);
 
 	// Write to the string representation buffer.
 	snprintf(representation, required_len + 1, "0x%x", encoding_representation);
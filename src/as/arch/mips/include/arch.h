@@ -10,6 +10,10 @@
 #ifndef ARCH_H
 #define ARCH_H 1
 
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
 
 /**
  * @brief Opcode type.
@@ -111,10 +115,60 @@ typedef enum {
 	INSTRUCTION_TYPE_UNKNOWN,
 	INSTRUCTION_TYPE_IMMEDIATE,
 	INSTRUCTION_TYPE_JUMP,
+	INSTRUCTION_TYPE_OFFSET,
 	INSTRUCTION_TYPE_REGISTER
 } Instruction_Type;
 
 
+/**
+ * @brief Operand signatures.
+ * This enumerated type describes how an instruction's operands are mapped onto
+ * the fields of its encoding.
+ */
+typedef enum {
+	OPERAND_SIGNATURE_NONE,
+	OPERAND_SIGNATURE_IMM,
+	OPERAND_SIGNATURE_RD_RS,
+	OPERAND_SIGNATURE_RD_RS_RT,
+	OPERAND_SIGNATURE_RD_RT_SA,
+	OPERAND_SIGNATURE_RS,
+	OPERAND_SIGNATURE_RS_IMM,
+	OPERAND_SIGNATURE_RT_IMM,
+	OPERAND_SIGNATURE_RT_OFFSET,
+	OPERAND_SIGNATURE_RT_RS_IMM,
+	OPERAND_SIGNATURE_TARGET
+} Operand_Signature;
+
+
+/**
+ * @brief Instruction description type.
+ * Describes the encoding of a single opcode. Any encoding field not supplied by
+ * the instruction's operands is taken from the description.
+ */
+typedef struct {
+	/** The mnemonic of the instruction. */
+	const char* mnemonic;
+	/** The encoding format of the instruction. */
+	Instruction_Type type;
+	/** How the operands map onto the encoding fields. */
+	Operand_Signature signature;
+	/** The 'opcode' field encoding. */
+	uint8_t opcode;
+	/** The fixed 'rt' field encoding, used by the `REGIMM` instructions. */
+	uint8_t rt;
+	/** The fixed 'sa' field encoding, used by the `MIPS32r6` multiply instructions. */
+	uint8_t sa;
+	/** The 'func' field encoding. */
+	uint8_t func;
+	/** The encoded size of the instruction in bytes. */
+	size_t size;
+	/** Whether the instruction is followed by a branch delay slot. */
+	bool delay_slot;
+	/** Whether the instruction was removed in `MIPS32r6`. */
+	bool deprecated;
+} Instruction_Description;
+
+
 /**
  * @brief Encodes a register operand.
  * 
@@ -124,4 +178,15 @@ typedef enum {
  */
 uint8_t encode_operand_register(Register reg);
 
+/**
+ * @brief Gets the description of an opcode.
+ *
+ * Returns the entry in the instruction description table for the provided
+ * opcode. Opcodes which cannot be encoded directly, such as pseudo-instructions,
+ * have a type of `INSTRUCTION_TYPE_UNKNOWN`.
+ * @param opcode The opcode to get the description of.
+ * @return A pointer to the instruction description. This is never NULL.
+ */
+const Instruction_Description* get_instruction_description(const Opcode opcode);
+
 #endif
@@ -12,6 +12,8 @@
 #define CODEGEN_H 1
 
 #include <as.h>
+#include <instruction.h>
+#include <section.h>
 #include <symtab.h>
 #include <stdbool.h>
 #include <stdint.h>
@@ -21,8 +23,9 @@
 /**
  * @brief Encodes an I type instruction.
  *
- * Encodes an I-type instruction entity, creating an `Encoding_Entity` instance representing
- * the generated machine code entities to be written into the executable.
+ * Encodes an I-type instruction entity, writing the generated machine code to the end
+ * of the section's data.
+ * @param section The section that the instruction is encoded in.
  * @param symbol_table The symbol table. This is scanned to find any symbols referenced
  * in instruction operands.
  * @param opcode The operand encoding.
@@ -30,9 +33,9 @@
  * @param rt The rt field to encode.
  * @param imm The imm operand to encode.
  * @param program_counter The current program_counter.
- * @return The encoded instruction entity. Returns `NULL` in case of error.
+ * @return The status of the operation.
  */
-Assembler_Status encode_i_type(Encoding_Entity** encoded_instruction,
+Assembler_Status encode_i_type(Section* section,
 	const Symbol_Table* symtab,
 	const uint8_t opcode,
 	const uint8_t rs,
@@ -43,18 +46,19 @@ Assembler_Status encode_i_type(Encoding_Entity** encoded_instruction,
 /**
  * @brief Encodes a J type instruction.
  *
- * Encodes a J-type instruction entity, creating an `Encoding_Entity` instance representing
- * the generated machine code entities to be written into the executable.
+ * Encodes a J-type instruction entity, writing the generated machine code to the end
+ * of the section's data.
  * See: https://stackoverflow.com/questions/7877407/jump-instruction-in-mips-assembly#7877528
  * https://stackoverflow.com/questions/6950230/how-to-calculate-jump-target-address-and-branch-target-address
+ * @param section The section that the instruction is encoded in.
  * @param symtab The symbol table. This is scanned to find any symbols referenced
  * in instruction operands.
  * @param opcode The operand encoding.
  * @param imm The imm operand to encode.
  * @param program_counter The current program_counter.
- * @return The encoded instruction entity. Returns `NULL` in case of error.
+ * @return The status of the operation.
  */
-Assembler_Status encode_j_type(Encoding_Entity** encoded_instruction,
+Assembler_Status encode_j_type(Section* section,
 	const Symbol_Table* symtab,
 	const uint8_t opcode,
 	const Operand imm,
@@ -63,14 +67,15 @@ Assembler_Status encode_j_type(Encoding_Entity** encoded_instruction,
 /**
  * @brief Encodes an offset type instruction.
  *
- * Encodes an offset type instruction entity, creating an `Encoding_Entity` instance representing
- * the generated machine code entities to be written into the executable.
+ * Encodes an offset type instruction entity, writing the generated machine code to the end
+ * of the section's data.
+ * @param section The section that the instruction is encoded in.
  * @param opcode The operand encoding.
  * @param rt The rt field to encode.
  * @param reg The reg operand to encode.
- * @return The encoded instruction entity. Returns `NULL` in case of error.
+ * @return The status of the operation.
  */
-Assembler_Status encode_offset_type(Encoding_Entity** encoded_instruction,
+Assembler_Status encode_offset_type(Section* section,
 	const uint8_t opcode,
 	const uint8_t rt,
 	const Operand offset_reg);
@@ -78,17 +83,18 @@ Assembler_Status encode_offset_type(Encoding_Entity** encoded_instruction,
 /**
  * @brief Encodes an r-type type instruction.
  *
- * Encodes an r-type instruction entity, creating an `Encoding_Entity` instance representing
- * the generated machine code entities to be written into the executable.
+ * Encodes an r-type instruction entity, writing the generated machine code to the end
+ * of the section's data.
+ * @param section The section that the instruction is encoded in.
  * @param opcode The operand encoding.
  * @param rd The rd field to encode.
  * @param rt The rt field to encode.
  * @param rs The rs field to encode.
  * @param sa The sa field to encode.
  * @param func The func field to encode.
- * @return The encoded instruction entity. Returns `NULL` in case of error.
+ * @return The status of the operation.
  */
-Assembler_Status encode_r_type(Encoding_Entity** encoded_instruction,
+Assembler_Status encode_r_type(Section* section,
 	const uint8_t opcode,
 	const uint8_t rd,
 	const uint8_t rs,
@@ -96,4 +102,34 @@ Assembler_Status encode_r_type(Encoding_Entity** encoded_instruction,
 	const uint8_t sa,
 	const uint8_t func);
 
+/**
+ * @brief Encodes a batch of instructions.
+ *
+ * Encodes a contiguous run of instructions into a caller-provided buffer. The
+ * arguments are validated once for the whole batch, and the machine code is
+ * written directly into @p encoding rather than being appended to a section.
+ * Any relocation entries required are written to @p reloc_entries, with offsets
+ * relative to the start of the section.
+ * @param symtab The symbol table. This is scanned to find any symbols referenced
+ * in instruction operands.
+ * @param instructions The instructions to encode. These must have had their
+ * macros expanded.
+ * @param n_instructions The number of instructions to encode.
+ * @param program_counter The program counter of the first instruction.
+ * @param encoding The buffer to write the encoded instructions to. This must have
+ * room for @p n_instructions words.
+ * @param reloc_entries The buffer to write the relocation entries to. Each
+ * instruction requires at most one entry, so this must have room for
+ * @p n_instructions entries.
+ * @param n_reloc_entries A pointer to the resulting number of relocation entries.
+ * @return The status of the operation.
+ */
+Assembler_Status encode_instruction_batch(const Symbol_Table* symtab,
+	const Instruction* instructions,
+	const size_t n_instructions,
+	const size_t program_counter,
+	uint32_t* encoding,
+	Reloc_Entry* reloc_entries,
+	size_t* n_reloc_entries);
+
 #endif
@@ -19,9 +19,11 @@
  * This function expands any branching instructions to insert a NOP in the branch
  * delay slot. This funcionality is as-per GCC's functionality.
  * @param macro The branching instruction statement.
+ * @param arena The arena that the inserted statement is allocated from.
  * @warning @p macro is modified in this function.
  */
-Assembler_Status expand_branch_delay(Statement* macro);
+Assembler_Status expand_branch_delay(Statement* macro,
+	Arena* arena);
 
 /**
  * @brief Expands a `la` or `li` psuedo-instruction.
@@ -31,10 +33,13 @@ Assembler_Status expand_branch_delay(Statement* macro);
  * The resulting instructions are highly dependent on the format of the statements,
  * with different formats of operands yielding different results.
  * @param macro The pseudo-instruction statement.
+ * @param arena The arena that any added statements and operands are allocated
+ * from.
  * @warning @macro is modified in this function. Additional statements may be
  * appended to the end of this statement.
  */
-Assembler_Status expand_macro_la(Statement* macro);
+Assembler_Status expand_macro_la(Statement* macro,
+	Arena* arena);
 
 /**
  * @brief Expands a `move` pseudo-instruction.
@@ -43,8 +48,10 @@ Assembler_Status expand_macro_la(Statement* macro);
  * analogous to adding a number to $0 and storing the result in a register. So
  * the instruction is converted to this form.
  * @param macro The `move` instruction statement.
+ * @param arena The arena that the resized operands are allocated from.
  * @warning @p macro is modified in this function.
  */
-Assembler_Status expand_macro_move(Statement* macro);
+Assembler_Status expand_macro_move(Statement* macro,
+	Arena* arena);
 
 #endif
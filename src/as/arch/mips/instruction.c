@@ -17,86 +17,120 @@
 
 
 /**
- * get_opcode_string
+ * The instruction description table, indexed by opcode.
+ * Each entry contains: the mnemonic, the encoding format, the operand signature,
+ * the 'opcode', 'rt', 'sa' and 'func' fields, the encoded size, whether the
+ * instruction has a branch delay slot, and whether it is deprecated.
+ * Opcodes with an unknown type are pseudo-instructions that are expanded prior to
+ * encoding, or instructions that are not yet supported by the code generator.
  */
-const char* get_opcode_string(const Opcode op)
+static const Instruction_Description instruction_descriptions[] = {
+	[OPCODE_UNKNOWN] = { "UNKNOWN", INSTRUCTION_TYPE_UNKNOWN, OPERAND_SIGNATURE_NONE,
+		0x0, 0x0, 0x0, 0x0, 0, false, false },
+	[OPCODE_ADD] = { "ADD", INSTRUCTION_TYPE_REGISTER, OPERAND_SIGNATURE_RD_RS_RT,
+		0x0, 0x0, 0x0, 0x20, 4, false, false },
+	[OPCODE_ADDI] = { "ADDI", INSTRUCTION_TYPE_IMMEDIATE, OPERAND_SIGNATURE_RT_RS_IMM,
+		0x8, 0x0, 0x0, 0x0, 4, false, false },
+	[OPCODE_ADDIU] = { "ADDIU", INSTRUCTION_TYPE_IMMEDIATE, OPERAND_SIGNATURE_RT_RS_IMM,
+		0x9, 0x0, 0x0, 0x0, 4, false, false },
+	[OPCODE_ADDU] = { "ADDU", INSTRUCTION_TYPE_REGISTER, OPERAND_SIGNATURE_RD_RS_RT,
+		0x0, 0x0, 0x0, 0x21, 4, false, false },
+	[OPCODE_AND] = { "AND", INSTRUCTION_TYPE_REGISTER, OPERAND_SIGNATURE_RD_RS_RT,
+		0x0, 0x0, 0x0, 0x24, 4, false, false },
+	[OPCODE_ANDI] = { "ANDI", INSTRUCTION_TYPE_IMMEDIATE, OPERAND_SIGNATURE_RT_RS_IMM,
+		0xC, 0x0, 0x0, 0x0, 4, false, false },
+	[OPCODE_BAL] = { "BAL", INSTRUCTION_TYPE_IMMEDIATE, OPERAND_SIGNATURE_IMM,
+		0x1, 0x11, 0x0, 0x0, 4, true, false },
+	[OPCODE_BEQ] = { "BEQ", INSTRUCTION_TYPE_IMMEDIATE, OPERAND_SIGNATURE_RT_RS_IMM,
+		0x4, 0x0, 0x0, 0x0, 4, true, false },
+	[OPCODE_BEQZ] = { "BEQZ", INSTRUCTION_TYPE_UNKNOWN, OPERAND_SIGNATURE_NONE,
+		0x0, 0x0, 0x0, 0x0, 4, true, false },
+	[OPCODE_BGEZ] = { "BGEZ", INSTRUCTION_TYPE_IMMEDIATE, OPERAND_SIGNATURE_RS_IMM,
+		0x1, 0x1, 0x0, 0x0, 4, true, false },
+	[OPCODE_BNE] = { "BNE", INSTRUCTION_TYPE_IMMEDIATE, OPERAND_SIGNATURE_RT_RS_IMM,
+		0x5, 0x0, 0x0, 0x0, 4, true, false },
+	[OPCODE_BLEZ] = { "BLEZ", INSTRUCTION_TYPE_UNKNOWN, OPERAND_SIGNATURE_NONE,
+		0x0, 0x0, 0x0, 0x0, 4, true, false },
+	[OPCODE_DIV] = { "DIV", INSTRUCTION_TYPE_UNKNOWN, OPERAND_SIGNATURE_NONE,
+		0x0, 0x0, 0x0, 0x0, 4, false, false },
+	[OPCODE_J] = { "J", INSTRUCTION_TYPE_JUMP, OPERAND_SIGNATURE_TARGET,
+		0x2, 0x0, 0x0, 0x0, 4, true, false },
+	[OPCODE_JAL] = { "JAL", INSTRUCTION_TYPE_JUMP, OPERAND_SIGNATURE_TARGET,
+		0x3, 0x0, 0x0, 0x0, 4, true, false },
+	[OPCODE_JALR] = { "JALR", INSTRUCTION_TYPE_REGISTER, OPERAND_SIGNATURE_RD_RS,
+		0x0, 0x0, 0x0, 0x9, 4, true, false },
+	[OPCODE_JR] = { "JR", INSTRUCTION_TYPE_REGISTER, OPERAND_SIGNATURE_RS,
+		0x0, 0x0, 0x0, 0x9, 4, true, false },
+	[OPCODE_LA] = { "LA", INSTRUCTION_TYPE_UNKNOWN, OPERAND_SIGNATURE_NONE,
+		0x0, 0x0, 0x0, 0x0, 4, false, false },
+	[OPCODE_LB] = { "LB", INSTRUCTION_TYPE_OFFSET, OPERAND_SIGNATURE_RT_OFFSET,
+		0x20, 0x0, 0x0, 0x0, 4, false, false },
+	[OPCODE_LBU] = { "LBU", INSTRUCTION_TYPE_OFFSET, OPERAND_SIGNATURE_RT_OFFSET,
+		0x24, 0x0, 0x0, 0x0, 4, false, false },
+	[OPCODE_LHU] = { "LHU", INSTRUCTION_TYPE_UNKNOWN, OPERAND_SIGNATURE_NONE,
+		0x0, 0x0, 0x0, 0x0, 4, false, false },
+	[OPCODE_LI] = { "LI", INSTRUCTION_TYPE_UNKNOWN, OPERAND_SIGNATURE_NONE,
+		0x0, 0x0, 0x0, 0x0, 4, false, false },
+	[OPCODE_LUI] = { "LUI", INSTRUCTION_TYPE_IMMEDIATE, OPERAND_SIGNATURE_RT_IMM,
+		0xF, 0x0, 0x0, 0x0, 4, false, false },
+	[OPCODE_LW] = { "LW", INSTRUCTION_TYPE_OFFSET, OPERAND_SIGNATURE_RT_OFFSET,
+		0x23, 0x0, 0x0, 0x0, 4, false, false },
+	[OPCODE_MOVE] = { "MOVE", INSTRUCTION_TYPE_UNKNOWN, OPERAND_SIGNATURE_NONE,
+		0x0, 0x0, 0x0, 0x0, 4, false, false },
+	[OPCODE_MUH] = { "MUH", INSTRUCTION_TYPE_REGISTER, OPERAND_SIGNATURE_RD_RS_RT,
+		0x0, 0x0, 0x3, 0x18, 4, false, false },
+	[OPCODE_MUHU] = { "MUHU", INSTRUCTION_TYPE_REGISTER, OPERAND_SIGNATURE_RD_RS_RT,
+		0x0, 0x0, 0x3, 0x19, 4, false, false },
+	[OPCODE_MUL] = { "MUL", INSTRUCTION_TYPE_REGISTER, OPERAND_SIGNATURE_RD_RS_RT,
+		0x0, 0x0, 0x2, 0x18, 4, false, false },
+	[OPCODE_MULU] = { "MULU", INSTRUCTION_TYPE_REGISTER, OPERAND_SIGNATURE_RD_RS_RT,
+		0x0, 0x0, 0x2, 0x19, 4, false, false },
+	[OPCODE_MULT] = { "MULT", INSTRUCTION_TYPE_REGISTER, OPERAND_SIGNATURE_RD_RS_RT,
+		0x0, 0x0, 0x0, 0x18, 4, false, true },
+	[OPCODE_MULTU] = { "MULTU", INSTRUCTION_TYPE_REGISTER, OPERAND_SIGNATURE_RD_RS_RT,
+		0x0, 0x0, 0x0, 0x19, 4, false, true },
+	[OPCODE_NOR] = { "NOR", INSTRUCTION_TYPE_UNKNOWN, OPERAND_SIGNATURE_NONE,
+		0x0, 0x0, 0x0, 0x0, 4, false, false },
+	[OPCODE_NOP] = { "NOP", INSTRUCTION_TYPE_REGISTER, OPERAND_SIGNATURE_NONE,
+		0x0, 0x0, 0x0, 0x0, 4, false, false },
+	[OPCODE_OR] = { "OR", INSTRUCTION_TYPE_REGISTER, OPERAND_SIGNATURE_RD_RS_RT,
+		0x0, 0x0, 0x0, 0x25, 4, false, false },
+	[OPCODE_ORI] = { "ORI", INSTRUCTION_TYPE_IMMEDIATE, OPERAND_SIGNATURE_RT_RS_IMM,
+		0xD, 0x0, 0x0, 0x0, 4, false, false },
+	[OPCODE_SB] = { "SB", INSTRUCTION_TYPE_OFFSET, OPERAND_SIGNATURE_RT_OFFSET,
+		0x28, 0x0, 0x0, 0x0, 4, false, false },
+	[OPCODE_SH] = { "SH", INSTRUCTION_TYPE_OFFSET, OPERAND_SIGNATURE_RT_OFFSET,
+		0x29, 0x0, 0x0, 0x0, 4, false, false },
+	[OPCODE_SLL] = { "SLL", INSTRUCTION_TYPE_REGISTER, OPERAND_SIGNATURE_RD_RT_SA,
+		0x0, 0x0, 0x0, 0x0, 4, false, false },
+	[OPCODE_SUB] = { "SUB", INSTRUCTION_TYPE_REGISTER, OPERAND_SIGNATURE_RD_RS_RT,
+		0x0, 0x0, 0x0, 0x22, 4, false, false },
+	[OPCODE_SUBU] = { "SUBU", INSTRUCTION_TYPE_REGISTER, OPERAND_SIGNATURE_RD_RS_RT,
+		0x0, 0x0, 0x0, 0x23, 4, false, false },
+	[OPCODE_SW] = { "SW", INSTRUCTION_TYPE_OFFSET, OPERAND_SIGNATURE_RT_OFFSET,
+		0x2B, 0x0, 0x0, 0x0, 4, false, false },
+	[OPCODE_SYSCALL] = { "SYSCALL", INSTRUCTION_TYPE_REGISTER, OPERAND_SIGNATURE_NONE,
+		0x0, 0x0, 0x0, 0xC, 4, false, false },
+};
+
+
+/**
+ * get_instruction_description
+ */
+const Instruction_Description* get_instruction_description(const Opcode opcode)
 {
-	if(op == OPCODE_ADDIU) {
-		return "ADDIU";
-	} else if(op == OPCODE_ADDI) {
-		return "ADDI";
-	} else if(op == OPCODE_ADDU) {
-		return "ADDU";
-	} else if(op == OPCODE_ADD) {
-		return "ADD";
-	} else if(op == OPCODE_BAL) {
-		return "BAL";
-	} else if(op == OPCODE_BEQZ) {
-		return "BEQZ";
-	} else if(op == OPCODE_BEQ) {
-		return "BEQ";
-	} else if(op == OPCODE_BGEZ) {
-		return "BGEZ";
-	} else if(op == OPCODE_BNE) {
-		return "BNE";
-	} else if(op == OPCODE_BLEZ) {
-		return "BLEZ";
-	} else if(op == OPCODE_DIV) {
-		return "DIV";
-	} else if(op == OPCODE_JALR) {
-		return "JALR";
-	} else if(op == OPCODE_JAL) {
-		return "JAL";
-	} else if(op == OPCODE_JR) {
-		return "JR";
-	} else if(op == OPCODE_J) {
-		return "J";
-	} else if(op == OPCODE_LA) {
-		return "LA";
-	} else if(op == OPCODE_LBU) {
-		return "LBU";
-	} else if(op == OPCODE_LB) {
-		return "LB";
-	} else if(op == OPCODE_LHU) {
-		return "LHU";
-	} else if(op == OPCODE_LI) {
-		return "LI";
-	} else if(op == OPCODE_LUI) {
-		return "LUI";
-	} else if(op == OPCODE_LW) {
-		return "LW";
-	} else if(op == OPCODE_MUHU) {
-		return "MUHU";
-	} else if(op == OPCODE_MUH) {
-		return "MUH";
-	} else if(op == OPCODE_MUL) {
-		return "MUL";
-	} else if(op == OPCODE_MULU) {
-		return "MULU";
-	} else if(op == OPCODE_NOR) {
-		return "NOR";
-	} else if(op == OPCODE_NOP) {
-		return "NOP";
-	} else if(op == OPCODE_ORI) {
-		return "ORI";
-	} else if(op == OPCODE_OR) {
-		return "OR";
-	} else if(op == OPCODE_SB) {
-		return "SB";
-	} else if(op == OPCODE_SH) {
-		return "SH";
-	} else if(op == OPCODE_SLL) {
-		return "SLL";
-	} else if(op == OPCODE_SUBU) {
-		return "SUBU";
-	} else if(op == OPCODE_SUB) {
-		return "SUB";
-	} else if(op == OPCODE_SW) {
-		return "SW";
-	} else if(op == OPCODE_SYSCALL) {
-		return "SYSCALL";
+	if((size_t)opcode >= sizeof(instruction_descriptions) / sizeof(Instruction_Description)) {
+		return &instruction_descriptions[OPCODE_UNKNOWN];
 	}
 
-	return "UNKNOWN";
+	return &instruction_descriptions[opcode];
 }
 
+
+/**
+ * get_opcode_string
+ */
+const char* get_opcode_string(const Opcode op)
+{
+	return get_instruction_description(op)->mnemonic;
+}
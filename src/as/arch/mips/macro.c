@@ -14,18 +14,19 @@
 
 #include <stdlib.h>
 #include <string.h>
+#include <arena.h>
 #include <as.h>
 #include <macro.h>
 #include <statement.h>
+#include <trace.h>
 
 /**
  * expand_macro_la
  */
-Assembler_Status expand_macro_la(Statement* macro)
+Assembler_Status expand_macro_la(Statement* macro,
+	Arena* arena)
 {
-#if DEBUG_MACRO == 1
-	printf("Debug Macro: Expanding `LA` pseudo-instruction\n");
-#endif
+	TRACE(TRACE_CHANNEL_MACRO, "Debug Macro: Expanding `LA` pseudo-instruction\n");
 
 	if(!check_operand_count(2, &macro->instruction.opseq)) {
 		// Check operand length is equal to 2, if not abort.
@@ -42,7 +43,7 @@ Assembler_Status expand_macro_la(Statement* macro)
 
 		// Create the expansion instruction.
 		// This instruction will be appended to the original instruction.
-		Statement* expansion = malloc(sizeof(Statement));
+		Statement* expansion = arena_alloc(arena, sizeof(Statement));
 		if(!expansion) {
 			fprintf(stderr, "Error: Error allocating statement for macro expansion\n");
 			return ASSEMBLER_ERROR_BAD_ALLOC;
@@ -54,10 +55,8 @@ Assembler_Status expand_macro_la(Statement* macro)
 		expansion->type = STATEMENT_TYPE_INSTRUCTION;
 		expansion->instruction.opcode = OPCODE_ORI;
 		expansion->instruction.opseq.n_operands = 3;
-		expansion->instruction.opseq.operands = malloc(sizeof(Operand) * 3);
+		expansion->instruction.opseq.operands = arena_alloc(arena, sizeof(Operand) * 3);
 		if(!expansion->instruction.opseq.operands) {
-			free(expansion);
-
 			fprintf(stderr, "Error: Error allocating operand sequence for macro expansion\n");
 			return ASSEMBLER_ERROR_BAD_ALLOC;
 		}
@@ -67,7 +66,7 @@ Assembler_Status expand_macro_la(Statement* macro)
 
 		expansion->instruction.opseq.operands[2].type = OPERAND_TYPE_SYMBOL;
 		expansion->instruction.opseq.operands[2].symbol =
-			strdup(macro->instruction.opseq.operands[1].symbol);
+			macro->instruction.opseq.operands[1].symbol;
 
 		// The expansion immediate operand will contain the lower half of the
 		// immediate value.
@@ -95,7 +94,7 @@ Assembler_Status expand_macro_la(Statement* macro)
 			// instruction loading the LSB.
 
 			// Create the expansion instruction to store the `ORI` instruction.
-			Statement* expansion = malloc(sizeof(Statement));
+			Statement* expansion = arena_alloc(arena, sizeof(Statement));
 			if(!expansion) {
 				fprintf(stderr, "Error allocating statement for macro expansion\n");
 				return ASSEMBLER_ERROR_BAD_ALLOC;
@@ -109,10 +108,8 @@ Assembler_Status expand_macro_la(Statement* macro)
 
 			// Use the modified operands from the original pseudo-instruction.
 			expansion->instruction.opseq.n_operands = 3;
-			expansion->instruction.opseq.operands = malloc(sizeof(Operand) * 3);
+			expansion->instruction.opseq.operands = arena_alloc(arena, sizeof(Operand) * 3);
 			if(!expansion->instruction.opseq.operands) {
-				free(expansion);
-
 				fprintf(stderr, "Error: Error allocating operand sequence for macro expansion\n");
 				return ASSEMBLER_ERROR_BAD_ALLOC;
 			}
@@ -143,14 +140,15 @@ Assembler_Status expand_macro_la(Statement* macro)
 
 			// The original instruction is modified to use the `ADDIU` opcode.
 			macro->instruction.opcode = OPCODE_ADDIU;
-			macro->instruction.opseq.n_operands = 3;
-			macro->instruction.opseq.operands = realloc(macro->instruction.opseq.operands,
-				sizeof(Operand) * 3);
+			macro->instruction.opseq.operands = arena_realloc(arena,
+				macro->instruction.opseq.operands,
+				sizeof(Operand) * macro->instruction.opseq.n_operands, sizeof(Operand) * 3);
 			if(!macro->instruction.opseq.operands) {
 				fprintf(stderr, "Error: Error allocating operand sequence for macro expansion\n");
 				return ASSEMBLER_ERROR_BAD_ALLOC;
 			}
 
+			macro->instruction.opseq.n_operands = 3;
 			macro->instruction.opseq.operands[2] = macro->instruction.opseq.operands[1];
 			macro->instruction.opseq.operands[1] = macro->instruction.opseq.operands[0];
 			macro->instruction.opseq.operands[0].type = OPERAND_TYPE_REGISTER;
@@ -169,14 +167,13 @@ Assembler_Status expand_macro_la(Statement* macro)
 /**
  * expand_branch_delay
  */
-Assembler_Status expand_branch_delay(Statement* macro)
+Assembler_Status expand_branch_delay(Statement* macro,
+	Arena* arena)
 {
-#if DEBUG_MACRO == 1
-	printf("Debug Macro: Expanding branch delay macro...\n");
-#endif
+	TRACE(TRACE_CHANNEL_MACRO, "Debug Macro: Expanding branch delay macro...\n");
 
 	// Create the expansion instruction which will store the inserted `NOP`.
-	Statement* expansion = malloc(sizeof(Statement));
+	Statement* expansion = arena_alloc(arena, sizeof(Statement));
 	if(!expansion) {
 		fprintf(stderr, "Error allocating statement for macro expansion\n");
 		return ASSEMBLER_ERROR_BAD_ALLOC;
@@ -203,11 +200,10 @@ Assembler_Status expand_branch_delay(Statement* macro)
 /**
  * expand_macro_move
  */
-Assembler_Status expand_macro_move(Statement* macro)
+Assembler_Status expand_macro_move(Statement* macro,
+	Arena* arena)
 {
-#if DEBUG_MACRO == 1
-	printf("Debug Macro: Expanding `MOVE` pseudo-instruction...\n");
-#endif
+	TRACE(TRACE_CHANNEL_MACRO, "Debug Macro: Expanding `MOVE` pseudo-instruction...\n");
 
 	if(!check_operand_count(2, &macro->instruction.opseq)) {
 		fprintf(stderr, "Operand count mismatch for `MOVE` pseudo-instruction\n");
@@ -218,14 +214,16 @@ Assembler_Status expand_macro_move(Statement* macro)
 	// one register and $zero so we replace the opcode with an `ADD`, and then
 	// add a final operand referencing the $zero register.
 	macro->instruction.opcode = OPCODE_ADD;
-	macro->instruction.opseq.n_operands = 3;
-	macro->instruction.opseq.operands = realloc(macro->instruction.opseq.operands,
-		sizeof(Operand) * 3);
+	macro->instruction.opseq.operands = arena_realloc(arena,
+		macro->instruction.opseq.operands,
+		sizeof(Operand) * macro->instruction.opseq.n_operands, sizeof(Operand) * 3);
 	if(!macro->instruction.opseq.operands) {
 		fprintf(stderr, "Error allocating operand sequence for macro expansion\n");
 		return ASSEMBLER_ERROR_BAD_ALLOC;
 	}
 
+	macro->instruction.opseq.n_operands = 3;
+
 	macro->instruction.opseq.operands[2].type = OPERAND_TYPE_REGISTER;
 	macro->instruction.opseq.operands[2].reg = REGISTER_$ZERO;
 
@@ -236,7 +234,8 @@ Assembler_Status expand_macro_move(Statement* macro)
 /**
  * expand_macros
  */
-Assembler_Status expand_macros(Statement* statements)
+Assembler_Status expand_macros(Statement* statements,
+	Arena* arena)
 {
 	/** Pointer to iterate over all statements. */
 	Statement* curr = statements;
@@ -248,22 +247,16 @@ Assembler_Status expand_macros(Statement* statements)
 			switch(curr->instruction.opcode) {
 				case OPCODE_LA:
 				case OPCODE_LI:
-					macro_process_status = expand_macro_la(curr);
-					break;
-				case OPCODE_BAL:
-				case OPCODE_BEQ:
-				case OPCODE_BEQZ:
-				case OPCODE_BGEZ:
-				case OPCODE_BLEZ:
-				case OPCODE_BNE:
-				case OPCODE_JAL:
-				case OPCODE_JR:
-					macro_process_status = expand_branch_delay(curr);
+					macro_process_status = expand_macro_la(curr, arena);
 					break;
 				case OPCODE_MOVE:
-					macro_process_status = expand_macro_move(curr);
+					macro_process_status = expand_macro_move(curr, arena);
 					break;
 				default:
+					if(get_instruction_description(curr->instruction.opcode)->delay_slot) {
+						macro_process_status = expand_branch_delay(curr, arena);
+					}
+
 					break;
 			}
 		}
@@ -7,98 +7,165 @@
  * @date 2019-03-09
  */
 
+#include <stdint.h>
 #include <string.h>
 #include "as.h"
 #include "parsing.h"
 
+/** The number of slots in the opcode mnemonic hash table. */
+#define OPCODE_HASH_TABLE_SIZE 64
+/** The length of the longest opcode mnemonic. */
+#define OPCODE_MAX_MNEMONIC_LENGTH 7
+
+
+/**
+ * @brief Opcode mnemonic table entry.
+ * Maps an opcode's lower-case mnemonic to its opcode.
+ */
+typedef struct {
+	const char* mnemonic;
+	size_t length;
+	Opcode opcode;
+} Opcode_Mnemonic;
+
+/**
+ * The value of each character in the opcode mnemonic hash.
+ * These values were chosen so that every mnemonic in `opcode_mnemonics` hashes
+ * to a distinct slot, making the hash perfect. Adding a mnemonic requires
+ * choosing values that keep it that way.
+ * Characters which do not occur in any mnemonic have a value of zero.
+ */
+static const uint8_t opcode_hash_values[128] = {
+	['a'] = 15,
+	['b'] = 16,
+	['c'] = 38,
+	['d'] = 47,
+	['e'] = 5,
+	['g'] = 19,
+	['h'] = 34,
+	['i'] = 49,
+	['j'] = 34,
+	['l'] = 24,
+	['m'] = 44,
+	['n'] = 16,
+	['o'] = 39,
+	['p'] = 42,
+	['q'] = 21,
+	['r'] = 26,
+	['s'] = 38,
+	['t'] = 6,
+	['u'] = 2,
+	['v'] = 4,
+	['w'] = 32,
+	['y'] = 28,
+	['z'] = 43,
+};
+
+/**
+ * Every recognised opcode mnemonic, stored at the slot its mnemonic hashes to.
+ */
+static const Opcode_Mnemonic opcode_mnemonics[OPCODE_HASH_TABLE_SIZE] = {
+	[0] = { "and", 3, OPCODE_AND },
+	[1] = { "lhu", 3, OPCODE_LHU },
+	[2] = { "beq", 3, OPCODE_BEQ },
+	[3] = { "andi", 4, OPCODE_ANDI },
+	[5] = { "j", 1, OPCODE_J },
+	[7] = { "syscall", 7, OPCODE_SYSCALL },
+	[8] = { "sb", 2, OPCODE_SB },
+	[11] = { "sub", 3, OPCODE_SUB },
+	[12] = { "mulu", 4, OPCODE_MULU },
+	[13] = { "multu", 5, OPCODE_MULTU },
+	[14] = { "nop", 3, OPCODE_NOP },
+	[16] = { "mult", 4, OPCODE_MULT },
+	[18] = { "bal", 3, OPCODE_BAL },
+	[22] = { "muhu", 4, OPCODE_MUHU },
+	[23] = { "bgez", 4, OPCODE_BGEZ },
+	[24] = { "jr", 2, OPCODE_JR },
+	[25] = { "beqz", 4, OPCODE_BEQZ },
+	[26] = { "lw", 2, OPCODE_LW },
+	[28] = { "blez", 4, OPCODE_BLEZ },
+	[29] = { "or", 2, OPCODE_OR },
+	[31] = { "add", 3, OPCODE_ADD },
+	[32] = { "move", 4, OPCODE_MOVE },
+	[33] = { "mul", 3, OPCODE_MUL },
+	[34] = { "addi", 4, OPCODE_ADDI },
+	[36] = { "jal", 3, OPCODE_JAL },
+	[38] = { "ori", 3, OPCODE_ORI },
+	[39] = { "jalr", 4, OPCODE_JALR },
+	[40] = { "sw", 2, OPCODE_SW },
+	[43] = { "div", 3, OPCODE_DIV },
+	[44] = { "sh", 2, OPCODE_SH },
+	[45] = { "bne", 3, OPCODE_BNE },
+	[46] = { "nor", 3, OPCODE_NOR },
+	[47] = { "lbu", 3, OPCODE_LBU },
+	[49] = { "sll", 3, OPCODE_SLL },
+	[51] = { "addu", 4, OPCODE_ADDU },
+	[52] = { "addiu", 5, OPCODE_ADDIU },
+	[53] = { "muh", 3, OPCODE_MUH },
+	[56] = { "la", 2, OPCODE_LA },
+	[58] = { "lb", 2, OPCODE_LB },
+	[60] = { "li", 2, OPCODE_LI },
+	[62] = { "subu", 4, OPCODE_SUBU },
+	[63] = { "lui", 3, OPCODE_LUI },
+};
+
+
+/**
+ * @brief Gets the hash value of a single mnemonic character.
+ * The value is case-insensitive.
+ * @param c The character.
+ * @return The character's value.
+ */
+static inline size_t opcode_hash_value(const char c)
+{
+	// Setting bit 5 converts upper-case letters to lower-case.
+	return opcode_hash_values[((unsigned char)c | 0x20) & 0x7F];
+}
+
+
+/**
+ * @brief Hashes an opcode mnemonic.
+ * The hash combines the mnemonic's length with its first three and last
+ * characters.
+ * @param opcode_symbol The mnemonic to hash.
+ * @param length The length of the mnemonic. Must be at least one.
+ * @return The mnemonic's slot in `opcode_mnemonics`.
+ */
+static inline size_t opcode_hash(const char* opcode_symbol,
+	const size_t length)
+{
+	/** The hash of the mnemonic. */
+	size_t hash = length + opcode_hash_value(opcode_symbol[0]) +
+		opcode_hash_value(opcode_symbol[length - 1]);
+
+	if(length > 1) {
+		hash += opcode_hash_value(opcode_symbol[1]);
+	}
+
+	if(length > 2) {
+		hash += opcode_hash_value(opcode_symbol[2]);
+	}
+
+	return hash % OPCODE_HASH_TABLE_SIZE;
+}
+
 
 /**
  * parse_opcode_symbol
  */
 Opcode parse_opcode_symbol(const char* opcode_symbol)
 {
-	if(!strncasecmp(opcode_symbol, "addiu", 5)) {
-		return OPCODE_ADDIU;
-	} else if(!strncasecmp(opcode_symbol, "addi", 4)) {
-		return OPCODE_ADDI;
-	} else if(!strncasecmp(opcode_symbol, "addu", 4)) {
-		return OPCODE_ADDU;
-	} else if(!strncasecmp(opcode_symbol, "add", 3)) {
-		return OPCODE_ADD;
-	} else if(!strncasecmp(opcode_symbol, "bal", 5)) {
-		return OPCODE_BAL;
-	} else if(!strncasecmp(opcode_symbol, "beqz", 4)) {
-		return OPCODE_BEQZ;
-	} else if(!strncasecmp(opcode_symbol, "beq", 3)) {
-		return OPCODE_BEQ;
-	} else if(!strncasecmp(opcode_symbol, "bgez", 4)) {
-		return OPCODE_BGEZ;
-	} else if(!strncasecmp(opcode_symbol, "bne", 3)) {
-		return OPCODE_BNE;
-	} else if(!strncasecmp(opcode_symbol, "blez", 4)) {
-		return OPCODE_BLEZ;
-	} else if(!strncasecmp(opcode_symbol, "div", 3)) {
-		return OPCODE_DIV;
-	} else if(!strncasecmp(opcode_symbol, "jalr", 4)) {
-		return OPCODE_JALR;
-	} else if(!strncasecmp(opcode_symbol, "jal", 3)) {
-		return OPCODE_JAL;
-	} else if(!strncasecmp(opcode_symbol, "jr", 2)) {
-		return OPCODE_JR;
-	} else if(!strncasecmp(opcode_symbol, "j", 1)) {
-		return OPCODE_J;
-	} else if(!strncasecmp(opcode_symbol, "la", 2)) {
-		return OPCODE_LA;
-	} else if(!strncasecmp(opcode_symbol, "lbu", 3)) {
-		return OPCODE_LBU;
-	} else if(!strncasecmp(opcode_symbol, "lb", 2)) {
-		return OPCODE_LB;
-	} else if(!strncasecmp(opcode_symbol, "lhu", 3)) {
-		return OPCODE_LHU;
-	} else if(!strncasecmp(opcode_symbol, "li", 2)) {
-		return OPCODE_LI;
-	} else if(!strncasecmp(opcode_symbol, "lui", 3)) {
-		return OPCODE_LUI;
-	} else if(!strncasecmp(opcode_symbol, "lw", 2)) {
-		return OPCODE_LW;
-	} else if(!strncasecmp(opcode_symbol, "move", 4)) {
-		return OPCODE_MOVE;
-	} else if(!strncasecmp(opcode_symbol, "muhu", 4)) {
-		return OPCODE_MUHU;
-	} else if(!strncasecmp(opcode_symbol, "muh", 3)) {
-		return OPCODE_MUH;
-	} else if(!strncasecmp(opcode_symbol, "multu", 4)) {
-		// Deprecated.
-		return OPCODE_MULTU;
-	} else if(!strncasecmp(opcode_symbol, "mulu", 4)) {
-		return OPCODE_MULU;
-	} else if(!strncasecmp(opcode_symbol, "mult", 4)) {
-		// Deprecated.
-		return OPCODE_MULT;
-	} else if(!strncasecmp(opcode_symbol, "mul", 3)) {
-		return OPCODE_MUL;
-	} else if(!strncasecmp(opcode_symbol, "nor", 3)) {
-		return OPCODE_NOR;
-	} else if(!strncasecmp(opcode_symbol, "nop", 3)) {
-		return OPCODE_NOP;
-	} else if(!strncasecmp(opcode_symbol, "ori", 3)) {
-		return OPCODE_ORI;
-	} else if(!strncasecmp(opcode_symbol, "or", 2)) {
-		return OPCODE_OR;
-	} else if(!strncasecmp(opcode_symbol, "sb", 2)) {
-		return OPCODE_SB;
-	} else if(!strncasecmp(opcode_symbol, "sh", 2)) {
-		return OPCODE_SH;
-	} else if(!strncasecmp(opcode_symbol, "sll", 3)) {
-		return OPCODE_SLL;
-	} else if(!strncasecmp(opcode_symbol, "subu", 4)) {
-		return OPCODE_SUBU;
-	} else if(!strncasecmp(opcode_symbol, "sub", 3)) {
-		return OPCODE_SUB;
-	} else if(!strncasecmp(opcode_symbol, "sw", 2)) {
-		return OPCODE_SW;
-	} else if(!strncasecmp(opcode_symbol, "syscall", 6)) {
-		return OPCODE_SYSCALL;
+	/** The length of the mnemonic. */
+	const size_t length = strnlen(opcode_symbol, OPCODE_MAX_MNEMONIC_LENGTH + 1);
+	/** The only table entry that the mnemonic can match. */
+	const Opcode_Mnemonic* entry = NULL;
+
+	if(length > 0 && length <= OPCODE_MAX_MNEMONIC_LENGTH) {
+		entry = &opcode_mnemonics[opcode_hash(opcode_symbol, length)];
+		if(entry->length == length &&
+			!strncasecmp(opcode_symbol, entry->mnemonic, length)) {
+			return entry->opcode;
+		}
 	}
 
 	fprintf(stderr, "Error: Unrecognised opcode: `%s`.\n", opcode_symbol);
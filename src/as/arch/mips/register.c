@@ -14,80 +14,196 @@
 #include "as.h"
 #include "parsing.h"
 
+/** The number of slots in the register name hash table. */
+#define REGISTER_HASH_TABLE_SIZE 64
+/** The length of the longest register name, excluding the register prefix. */
+#define REGISTER_MAX_NAME_LENGTH 4
+/** The number of general purpose registers. */
+#define REGISTER_COUNT 32
+
+
+/**
+ * @brief Register name table entry.
+ * Maps a register's lower-case ABI name, without the register prefix, to its
+ * register.
+ */
+typedef struct {
+	const char* name;
+	size_t length;
+	Register reg;
+} Register_Name;
+
+/**
+ * The value of each character in the register name hash.
+ * These values were chosen so that every name in `register_names` hashes to a
+ * distinct slot, making the hash perfect. Adding a name requires choosing
+ * values that keep it that way.
+ * Characters which do not occur in any name have a value of zero.
+ */
+static const uint8_t register_hash_values[128] = {
+	['0'] = 0,
+	['1'] = 30,
+	['2'] = 45,
+	['3'] = 31,
+	['4'] = 7,
+	['5'] = 6,
+	['6'] = 43,
+	['7'] = 47,
+	['8'] = 58,
+	['9'] = 34,
+	['a'] = 31,
+	['e'] = 48,
+	['f'] = 18,
+	['g'] = 44,
+	['k'] = 36,
+	['o'] = 24,
+	['p'] = 21,
+	['r'] = 35,
+	['s'] = 4,
+	['t'] = 49,
+	['v'] = 52,
+	['z'] = 9,
+};
+
+/**
+ * Every register ABI name, stored at the slot its name hashes to.
+ */
+static const Register_Name register_names[REGISTER_HASH_TABLE_SIZE] = {
+	[1] = { "t4", 2, REGISTER_$T4 },
+	[2] = { "s1", 2, REGISTER_$S1 },
+	[3] = { "at", 2, REGISTER_$AT },
+	[4] = { "s3", 2, REGISTER_$S3 },
+	[6] = { "s0", 2, REGISTER_$S0 },
+	[9] = { "t6", 2, REGISTER_$T6 },
+	[13] = { "t2", 2, REGISTER_$T2 },
+	[17] = { "t7", 2, REGISTER_$T7 },
+	[18] = { "s5", 2, REGISTER_$S5 },
+	[20] = { "s4", 2, REGISTER_$S4 },
+	[24] = { "gp", 2, REGISTER_$GP },
+	[28] = { "s6", 2, REGISTER_$S6 },
+	[29] = { "a1", 2, REGISTER_$A1 },
+	[31] = { "a3", 2, REGISTER_$A3 },
+	[32] = { "s2", 2, REGISTER_$S2 },
+	[33] = { "a0", 2, REGISTER_$A0 },
+	[34] = { "k1", 2, REGISTER_$K1 },
+	[35] = { "ra", 2, REGISTER_$RA },
+	[36] = { "s7", 2, REGISTER_$S7 },
+	[38] = { "k0", 2, REGISTER_$K0 },
+	[39] = { "t8", 2, REGISTER_$T8 },
+	[45] = { "zero", 4, REGISTER_$ZERO },
+	[47] = { "t1", 2, REGISTER_$T1 },
+	[48] = { "sp", 2, REGISTER_$SP },
+	[49] = { "t3", 2, REGISTER_$T3 },
+	[50] = { "v1", 2, REGISTER_$V1 },
+	[51] = { "t0", 2, REGISTER_$T0 },
+	[54] = { "v0", 2, REGISTER_$V0 },
+	[55] = { "t9", 2, REGISTER_$T9 },
+	[58] = { "s8", 2, REGISTER_$FP },
+	[59] = { "a2", 2, REGISTER_$A2 },
+	[62] = { "fp", 2, REGISTER_$FP },
+	[63] = { "t5", 2, REGISTER_$T5 },
+};
+
+
+/**
+ * @brief Gets the hash value of a single register name character.
+ * The value is case-insensitive.
+ * @param c The character.
+ * @return The character's value.
+ */
+static inline size_t register_hash_value(const char c)
+{
+	// Setting bit 5 converts upper-case letters to lower-case, and leaves
+	// digits unchanged.
+	return register_hash_values[((unsigned char)c | 0x20) & 0x7F];
+}
+
+
+/**
+ * @brief Decodes a numeric register name.
+ * Accepts the numbers `0` to `31`, without leading zeroes.
+ * @param number The register number, without the register prefix.
+ * @param length The length of the register number.
+ * @return The matching register, or `REGISTER_NONE` if the number is invalid.
+ */
+static Register decode_register_number(const char* number,
+	const size_t length)
+{
+	/** The decoded register number. */
+	size_t value = 0;
+
+	if(length == 0 || length > 2) {
+		return REGISTER_NONE;
+	}
+
+	// Leading zeroes are not permitted.
+	if(length == 2 && number[0] == '0') {
+		return REGISTER_NONE;
+	}
+
+	for(size_t i = 0; i < length; i++) {
+		if(number[i] < '0' || number[i] > '9') {
+			return REGISTER_NONE;
+		}
+
+		value = (value * 10) + (size_t)(number[i] - '0');
+	}
+
+	if(value >= REGISTER_COUNT) {
+		return REGISTER_NONE;
+	}
+
+	// The registers are enumerated in the order of their numbers.
+	return (Register)(REGISTER_$ZERO + value);
+}
+
 
 /**
  * parse_register_symbol
  */
 Register parse_register_symbol(const char* reg_symbol)
 {
-	if(!strncasecmp(reg_symbol, "0", 1) || !strncasecmp(reg_symbol, "$0", 2) ||
-		!strncasecmp(reg_symbol, "$zero", 5)) {
-
-		return REGISTER_$ZERO;
-	} else if(!strncasecmp(reg_symbol, "$1", 2) || !strncasecmp(reg_symbol, "$at", 3)) {
-		return REGISTER_$AT;
-	} else if(!strncasecmp(reg_symbol, "$2", 2) || !strncasecmp(reg_symbol, "$v0", 3)) {
-		return REGISTER_$V0;
-	} else if(!strncasecmp(reg_symbol, "$3", 2) || !strncasecmp(reg_symbol, "$v1", 3)) {
-		return REGISTER_$V1;
-	} else if(!strncasecmp(reg_symbol, "$4", 2) || !strncasecmp(reg_symbol, "$a0", 3)) {
-		return REGISTER_$A0;
-	} else if(!strncasecmp(reg_symbol, "$5", 2) || !strncasecmp(reg_symbol, "$a1", 3)) {
-		return REGISTER_$A1;
-	} else if(!strncasecmp(reg_symbol, "$6", 2) || !strncasecmp(reg_symbol, "$a2", 3)) {
-		return REGISTER_$A2;
-	} else if(!strncasecmp(reg_symbol, "$7", 2) || !strncasecmp(reg_symbol, "$a3", 3)) {
-		return REGISTER_$A3;
-	} else if(!strncasecmp(reg_symbol, "$8", 2) || !strncasecmp(reg_symbol, "$t0", 3)) {
-		return REGISTER_$T0;
-	} else if(!strncasecmp(reg_symbol, "$9", 2) || !strncasecmp(reg_symbol, "$t1", 3)) {
-		return REGISTER_$T1;
-	} else if(!strncasecmp(reg_symbol, "$10", 3) || !strncasecmp(reg_symbol, "$t2", 3)) {
-		return REGISTER_$T2;
-	} else if(!strncasecmp(reg_symbol, "$11", 3) || !strncasecmp(reg_symbol, "$t3", 3)) {
-		return REGISTER_$T3;
-	} else if(!strncasecmp(reg_symbol, "$12", 3) || !strncasecmp(reg_symbol, "$t4", 3)) {
-		return REGISTER_$T4;
-	} else if(!strncasecmp(reg_symbol, "$13", 3) || !strncasecmp(reg_symbol, "$t5", 3)) {
-		return REGISTER_$T5;
-	} else if(!strncasecmp(reg_symbol, "$14", 3) || !strncasecmp(reg_symbol, "$t6", 3)) {
-		return REGISTER_$T6;
-	} else if(!strncasecmp(reg_symbol, "$15", 3) || !strncasecmp(reg_symbol, "$t7", 3)) {
-		return REGISTER_$T7;
-	} else if(!strncasecmp(reg_symbol, "$16", 3) || !strncasecmp(reg_symbol, "$s0", 3)) {
-		return REGISTER_$S0;
-	} else if(!strncasecmp(reg_symbol, "$17", 3) || !strncasecmp(reg_symbol, "$s1", 3)) {
-		return REGISTER_$S1;
-	} else if(!strncasecmp(reg_symbol, "$18", 3) || !strncasecmp(reg_symbol, "$s2", 3)) {
-		return REGISTER_$S2;
-	} else if(!strncasecmp(reg_symbol, "$19", 3) || !strncasecmp(reg_symbol, "$s3", 3)) {
-		return REGISTER_$S3;
-	} else if(!strncasecmp(reg_symbol, "$20", 3) || !strncasecmp(reg_symbol, "$s4", 3)) {
-		return REGISTER_$S4;
-	} else if(!strncasecmp(reg_symbol, "$21", 3) || !strncasecmp(reg_symbol, "$s5", 3)) {
-		return REGISTER_$S5;
-	} else if(!strncasecmp(reg_symbol, "$22", 3) || !strncasecmp(reg_symbol, "$s6", 3)) {
-		return REGISTER_$S6;
-	} else if(!strncasecmp(reg_symbol, "$23", 3) || !strncasecmp(reg_symbol, "$s7", 3)) {
-		return REGISTER_$S7;
-	} else if(!strncasecmp(reg_symbol, "$24", 3) || !strncasecmp(reg_symbol, "$t8", 3)) {
-		return REGISTER_$T8;
-	} else if(!strncasecmp(reg_symbol, "$25", 3) || !strncasecmp(reg_symbol, "$t9", 3)) {
-		return REGISTER_$T9;
-	} else if(!strncasecmp(reg_symbol, "$26", 3) || !strncasecmp(reg_symbol, "$k0", 3)) {
-		return REGISTER_$K0;
-	} else if(!strncasecmp(reg_symbol, "$27", 3) || !strncasecmp(reg_symbol, "$k1", 3)) {
-		return REGISTER_$K1;
-	} else if(!strncasecmp(reg_symbol, "$28", 3) || !strncasecmp(reg_symbol, "$gp", 3)) {
-		return REGISTER_$GP;
-	} else if(!strncasecmp(reg_symbol, "$29", 3) || !strncasecmp(reg_symbol, "$sp", 3)) {
-		return REGISTER_$SP;
-	} else if(!strncasecmp(reg_symbol, "$30", 3) || !strncasecmp(reg_symbol, "$fp", 3)) {
-		return REGISTER_$FP;
-	} else if(!strncasecmp(reg_symbol, "$31", 3) || !strncasecmp(reg_symbol, "$ra", 3)) {
-		return REGISTER_$RA;
+	/** The register name, without the register prefix. */
+	const char* name = reg_symbol + 1;
+	/** The length of the register name. */
+	size_t length = 0;
+	/** The only table entry that the name can match. */
+	const Register_Name* entry = NULL;
+	/** The decoded register. */
+	Register reg = REGISTER_NONE;
+
+	if(reg_symbol[0] != '$') {
+		goto UNRECOGNISED_REGISTER;
+	}
+
+	length = strnlen(name, REGISTER_MAX_NAME_LENGTH + 1);
+	if(length == 0 || length > REGISTER_MAX_NAME_LENGTH) {
+		goto UNRECOGNISED_REGISTER;
+	}
+
+	if(name[0] >= '0' && name[0] <= '9') {
+		reg = decode_register_number(name, length);
+		if(reg == REGISTER_NONE) {
+			goto UNRECOGNISED_REGISTER;
+		}
+
+		return reg;
+	}
+
+	// Every register ABI name is at least two characters long.
+	if(length < 2) {
+		goto UNRECOGNISED_REGISTER;
+	}
+
+	// The name's hash combines its length with its first two characters.
+	entry = &register_names[(register_hash_value(name[0]) +
+		(2 * register_hash_value(name[1])) + length) % REGISTER_HASH_TABLE_SIZE];
+	if(entry->length == length && !strncasecmp(name, entry->name, length)) {
+		return entry->reg;
 	}
 
+UNRECOGNISED_REGISTER:
+	// The error is reported by the caller, which knows where the name appears.
 	return REGISTER_NONE;
 }
 
@@ -97,71 +213,10 @@ Register parse_register_symbol(const char* reg_symbol)
  */
 uint8_t encode_operand_register(Register reg)
 {
-	if(reg == REGISTER_$ZERO) {
+	if(reg < REGISTER_$ZERO || reg > REGISTER_$RA) {
 		return 0;
-	} else if(reg == REGISTER_$AT) {
-		return 1;
-	} else if(reg == REGISTER_$V0) {
-		return 2;
-	} else if(reg == REGISTER_$V1) {
-		return 3;
-	} else if(reg == REGISTER_$A0) {
-		return 4;
-	} else if(reg == REGISTER_$A1) {
-		return 5;
-	} else if(reg == REGISTER_$A2) {
-		return 6;
-	} else if(reg == REGISTER_$A3) {
-		return 7;
-	} else if(reg == REGISTER_$T0) {
-		return 8;
-	} else if(reg == REGISTER_$T1) {
-		return 9;
-	} else if(reg == REGISTER_$T2) {
-		return 10;
-	} else if(reg == REGISTER_$T3) {
-		return 11;
-	} else if(reg == REGISTER_$T4) {
-		return 12;
-	} else if(reg == REGISTER_$T5) {
-		return 13;
-	} else if(reg == REGISTER_$T6) {
-		return 14;
-	} else if(reg == REGISTER_$T7) {
-		return 15;
-	} else if(reg == REGISTER_$S0) {
-		return 16;
-	} else if(reg == REGISTER_$S1) {
-		return 17;
-	} else if(reg == REGISTER_$S2) {
-		return 18;
-	} else if(reg == REGISTER_$S3) {
-		return 19;
-	} else if(reg == REGISTER_$S4) {
-		return 20;
-	} else if(reg == REGISTER_$S5) {
-		return 21;
-	} else if(reg == REGISTER_$S6) {
-		return 22;
-	} else if(reg == REGISTER_$S7) {
-		return 23;
-	} else if(reg == REGISTER_$T8) {
-		return 24;
-	} else if(reg == REGISTER_$T9) {
-		return 25;
-	} else if(reg == REGISTER_$K0) {
-		return 26;
-	} else if(reg == REGISTER_$K1) {
-		return 27;
-	} else if(reg == REGISTER_$GP) {
-		return 28;
-	} else if(reg == REGISTER_$SP) {
-		return 29;
-	} else if(reg == REGISTER_$FP) {
-		return 30;
-	} else if(reg == REGISTER_$RA) {
-		return 31;
 	}
 
-	return 0;
+	// The registers are enumerated in the order of their numbers.
+	return (uint8_t)(reg - REGISTER_$ZERO);
 }
@@ -28,7 +28,7 @@ Assembler_Status get_statement_size(Statement* statement,
 	}
 
 	if(statement->type == STATEMENT_TYPE_INSTRUCTION) {
-		*statement_size = 4;
+		*statement_size = get_instruction_description(statement->instruction.opcode)->size;
 
 		return ASSEMBLER_STATUS_SUCCESS;
 	}
@@ -70,25 +70,30 @@ Assembler_Status get_statement_size(Statement* statement,
 
 				return ASSEMBLER_STATUS_SUCCESS;
 			case DIRECTIVE_BYTE:
-				*statement_size = 1;
+				*statement_size = sizeof(uint8_t) * statement->directive.opseq.n_operands;
 
 				return ASSEMBLER_STATUS_SUCCESS;
-				return 1;
 			case DIRECTIVE_SHORT:
-				*statement_size = 2;
+				*statement_size = sizeof(uint16_t) * statement->directive.opseq.n_operands;
 
 				return ASSEMBLER_STATUS_SUCCESS;
 			case DIRECTIVE_LONG:
-				*statement_size = 4;
-
-				return ASSEMBLER_STATUS_SUCCESS;
 			case DIRECTIVE_WORD:
-				*statement_size = 4;
+				*statement_size = sizeof(uint32_t) * statement->directive.opseq.n_operands;
 
 				return ASSEMBLER_STATUS_SUCCESS;
 			case DIRECTIVE_FILL:
+				*statement_size = 0;
+				if(statement->directive.opseq.n_operands < 1) {
+					return ASSEMBLER_STATUS_SUCCESS;
+				}
+
 				count = statement->directive.opseq.operands[0].numeric_literal;
-				fill_size = statement->directive.opseq.operands[1].numeric_literal;
+				fill_size = 1;
+				if(statement->directive.opseq.n_operands > 1) {
+					fill_size = statement->directive.opseq.operands[1].numeric_literal;
+				}
+
 				if(fill_size > 8) {
 					// Fill size is capped at 8, as per GAS docs.
 					// https://ftp.gnu.org/old-gnu/Manuals/gas-2.9.1/html_chapter/as_7.html#SEC91
@@ -100,7 +105,10 @@ Assembler_Status get_statement_size(Statement* statement,
 				return ASSEMBLER_STATUS_SUCCESS;
 			case DIRECTIVE_SKIP:
 			case DIRECTIVE_SPACE:
-				*statement_size = statement->directive.opseq.operands[0].numeric_literal;
+				*statement_size = 0;
+				if(statement->directive.opseq.n_operands > 0) {
+					*statement_size = statement->directive.opseq.operands[0].numeric_literal;
+				}
 
 				return ASSEMBLER_STATUS_SUCCESS;
 			default:
@@ -0,0 +1,238 @@
+/**
+ * @file arena.c
+ * @author Anthony (ajxs [at] panoptic.online)
+ * @brief Functions for working with the arena allocator.
+ * Contains functions for allocating memory from an arena, and releasing it.
+ * @version 0.1
+ * @date 2019-03-09
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <as.h>
+#include <arena.h>
+#include <trace.h>
+
+/** The size of each arena block. */
+#define ARENA_BLOCK_SIZE 0x10000
+/**
+ * Allocations larger than this are given a block of their own, so that they do
+ * not waste the remainder of the current block.
+ */
+#define ARENA_LARGE_ALLOCATION_SIZE (ARENA_BLOCK_SIZE / 4)
+/** The alignment of every allocation. */
+#define ARENA_ALIGNMENT _Alignof(max_align_t)
+
+
+/**
+ * @brief Rounds a size up to the arena's alignment.
+ * @param size The size to round.
+ * @return The rounded size.
+ */
+static inline size_t arena_align(const size_t size)
+{
+	return (size + (ARENA_ALIGNMENT - 1)) & ~(ARENA_ALIGNMENT - 1);
+}
+
+
+/**
+ * @brief Adds a new block to an arena.
+ *
+ * Allocates a new block, and links it into the arena's block list.
+ * If @p current is true the block becomes the block that allocations are made
+ * from, otherwise it is linked behind it so that the current block's remaining
+ * space is still used.
+ * @param arena A pointer to the arena.
+ * @param size The usable size of the block.
+ * @param current Whether the block becomes the arena's current block.
+ * @return A pointer to the new block, or NULL if an error occurred.
+ */
+static Arena_Block* arena_add_block(Arena* arena,
+	const size_t size,
+	const bool current)
+{
+	/** The new block. */
+	Arena_Block* block = malloc(sizeof(Arena_Block) + size);
+	if(!block) {
+		fprintf(stderr, "Error: Error allocating arena block\n");
+
+		return NULL;
+	}
+
+	block->size = size;
+	block->used = 0;
+
+	if(current || !arena->blocks) {
+		block->next = arena->blocks;
+		arena->blocks = block;
+	} else {
+		block->next = arena->blocks->next;
+		arena->blocks->next = block;
+	}
+
+	arena->n_blocks++;
+	arena->n_bytes_reserved += size;
+
+	return block;
+}
+
+
+/**
+ * initialise_arena
+ */
+Assembler_Status initialise_arena(Arena* arena)
+{
+	arena->blocks = NULL;
+	arena->n_blocks = 0;
+	arena->n_allocations = 0;
+	arena->n_bytes_allocated = 0;
+	arena->n_bytes_reserved = 0;
+
+	if(!arena_add_block(arena, ARENA_BLOCK_SIZE, true)) {
+		// Error message printed in callee.
+		return ASSEMBLER_ERROR_BAD_ALLOC;
+	}
+
+	return ASSEMBLER_STATUS_SUCCESS;
+}
+
+
+/**
+ * arena_alloc
+ */
+void* arena_alloc(Arena* arena,
+	const size_t size)
+{
+	/** The size of the allocation, including alignment padding. */
+	const size_t aligned_size = arena_align(size);
+	/** The block the allocation is made from. */
+	Arena_Block* block = arena->blocks;
+	/** The allocated memory. */
+	void* allocation = NULL;
+
+	if(aligned_size > ARENA_LARGE_ALLOCATION_SIZE) {
+		block = arena_add_block(arena, aligned_size, false);
+	} else if(!block || (block->size - block->used) < aligned_size) {
+		block = arena_add_block(arena, ARENA_BLOCK_SIZE, true);
+	}
+
+	if(!block) {
+		// Error message printed in callee.
+		return NULL;
+	}
+
+	allocation = block->data + block->used;
+	block->used += aligned_size;
+
+	arena->n_allocations++;
+	arena->n_bytes_allocated += size;
+
+	return allocation;
+}
+
+
+/**
+ * arena_realloc
+ */
+void* arena_realloc(Arena* arena,
+	void* ptr,
+	const size_t size,
+	const size_t new_size)
+{
+	/** The arena's current block. */
+	Arena_Block* block = arena->blocks;
+	/** The resized allocation. */
+	void* allocation = NULL;
+
+	if(!ptr) {
+		return arena_alloc(arena, new_size);
+	}
+
+	if(new_size <= size) {
+		return ptr;
+	}
+
+	// If this was the most recent allocation from the current block, it can be
+	// extended in place.
+	if(block && ((uint8_t*)ptr + arena_align(size) == block->data + block->used)) {
+		/** The offset of the allocation into the block. */
+		const size_t offset = (size_t)((uint8_t*)ptr - block->data);
+
+		if(arena_align(new_size) <= block->size - offset) {
+			block->used = offset + arena_align(new_size);
+			arena->n_bytes_allocated += new_size - size;
+
+			return ptr;
+		}
+	}
+
+	allocation = arena_alloc(arena, new_size);
+	if(!allocation) {
+		return NULL;
+	}
+
+	memcpy(allocation, ptr, size);
+
+	return allocation;
+}
+
+
+/**
+ * arena_strndup
+ */
+char* arena_strndup(Arena* arena,
+	const char* string,
+	const size_t length)
+{
+	/** The length of the string to copy. */
+	const size_t copy_length = strnlen(string, length);
+	/** The copied string. */
+	char* copy = arena_alloc(arena, copy_length + 1);
+	if(!copy) {
+		return NULL;
+	}
+
+	memcpy(copy, string, copy_length);
+	copy[copy_length] = '\0';
+
+	return copy;
+}
+
+
+/**
+ * print_arena_statistics
+ */
+void print_arena_statistics(const Arena* arena)
+{
+	trace_printf("  Allocations: `%zu`\n", arena->n_allocations);
+	trace_printf("  Bytes allocated: `%zu`\n", arena->n_bytes_allocated);
+	trace_printf("  Blocks: `%zu`\n", arena->n_blocks);
+	trace_printf("  Bytes reserved: `%zu`\n", arena->n_bytes_reserved);
+}
+
+
+/**
+ * free_arena
+ */
+void free_arena(Arena* arena)
+{
+	/** The block following the one currently being freed. */
+	Arena_Block* next = NULL;
+
+	if(!arena) {
+		fprintf(stderr, "Error: Invalid arena provided to free function\n");
+
+		return;
+	}
+
+	while(arena->blocks) {
+		next = arena->blocks->next;
+		free(arena->blocks);
+		arena->blocks = next;
+	}
+
+	arena->n_blocks = 0;
+}
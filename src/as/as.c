@@ -11,19 +11,101 @@
 
 #include <ctype.h>
 #include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <pthread.h>
+#include <stdatomic.h>
 #include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#include <arena.h>
 #include <as.h>
 #include <directive.h>
 #include <input.h>
 #include <instruction.h>
 #include <section.h>
 #include <statement.h>
+#include <stats.h>
+#include <string_pool.h>
 #include <symtab.h>
+#include <trace.h>
+
+/**
+ * The maximum number of I/O vector entries passed to a single call to `writev`.
+ */
+#ifdef IOV_MAX
+#define OUTPUT_IOV_MAX IOV_MAX
+#else
+#define OUTPUT_IOV_MAX 1024
+#endif
+
+/**
+ * The minimum number of statements encoded by each job in the second pass.
+ * Programs too small to be split into chunks of at least this size are encoded
+ * serially.
+ */
+#define SECOND_PASS_MIN_CHUNK_STATEMENTS 256
+
+/**
+ * @brief The sections that statements can be encoded in.
+ * Used to index the sections tracked by the assembler passes.
+ */
+typedef enum {
+	PROGRAM_SECTION_TEXT,
+	PROGRAM_SECTION_DATA,
+	PROGRAM_SECTION_BSS,
+	PROGRAM_SECTION_COUNT
+} Program_Section;
+
+/**
+ * @brief The resolved location of a statement.
+ * Records the section, offset and size that the first pass calculated for a
+ * statement. These are stored in a side array in statement order, so that the
+ * second pass can encode any statement independently of the others.
+ */
+typedef struct {
+	Statement* statement;
+	uint32_t offset;
+	uint32_t size;
+	uint8_t section;
+} Statement_Location;
+
+/**
+ * @brief A chunk of statements encoded by a single job in the second pass.
+ * Each chunk encodes into windows onto the ranges of the program sections that
+ * its statements occupy, so that chunks can be encoded concurrently.
+ */
+typedef struct {
+	const char* input_filename;
+	Section** program_sections;
+	const Symbol_Table* symbol_table;
+	const Statement_Location* locations;
+	size_t n_locations;
+	Section windows[PROGRAM_SECTION_COUNT];
+	Assembler_Status status;
+	/** The CPU time used to encode the chunk, in seconds. */
+	double cpu_time;
+} Encoding_Chunk;
+
+/**
+ * @brief The queue of input files assembled by a pool of worker threads.
+ * Each worker takes the next unassembled file from the queue until every file
+ * has been assembled. The result of each file is stored in input order.
+ */
+typedef struct {
+	const char* const* input_filenames;
+	const char* const* output_filenames;
+	size_t n_files;
+	size_t n_jobs;
+	Assembly_Stats* stats;
+	atomic_size_t next_file;
+	Assembler_Status* results;
+} Assembly_Queue;
 
 /**
  * @brief Populates the relocation entry sections.
@@ -34,6 +116,7 @@
  * relevant relocation entry section.
  * For more information on relocation entries, refer to:
  * https://docs.oracle.com/cd/E23824_01/html/819-0690/chapter6-54839.html
+ * @param symtab A pointer to the symbol table.
  * @param sections A pointer to the section linked list.
  * @warning This function modifies the sections.
  */
@@ -46,91 +129,267 @@ static Assembler_Status populate_relocation_entries(Symbol_Table* symtab,
  *
  * This function runs the first assembly pass. This pass calculates the size of
  * each instruction, and populates the symbol table with all of the labels.
- * Creates a linked list of the sections.
+ * The section, offset and size of every statement are recorded in the
+ * statement location array.
  * @param sections A pointer to the section linked list.
  * @param symbol_table A pointer to the symbol table.
  * @param statements A pointer to the parsed statement linked list.
- * @warning This function modifies the symbol table.
+ * @param locations A pointer-to-pointer to the resulting statement locations.
+ * @param n_locations A pointer to the resulting number of statement locations.
+ * @warning This function modifies the symbol table. The statement location
+ * array must be freed by the caller.
  * @return A status entity indicating whether or not the pass was successful.
  */
 static Assembler_Status assemble_first_pass(Section* sections,
 	Symbol_Table* symbol_table,
-	Statement* statements);
+	Statement* statements,
+	Statement_Location** locations,
+	size_t* n_locations);
 
 /**
  * @brief Runs the second pass of the assembler.
  *
  * This function runs the second assembly pass. This pass generates the code for
  * each parsed instruction and populates the section data.
+ * Each statement is encoded at the location calculated by the first pass. If
+ * more than one job is requested, the statements are split into chunks which
+ * are encoded concurrently. The output is identical to encoding the statements
+ * serially.
+ * @param input_filename The name of the file being assembled, used to label
+ * the trace events of each job.
  * @param sections A pointer to the section linked list.
  * @param symbol_table A pointer to the symbol table.
- * @param statements A pointer to the parsed statement linked list.
+ * @param locations The statement locations calculated by the first pass.
+ * @param n_locations The number of statement locations.
+ * @param n_jobs The maximum number of jobs to encode the statements with.
+ * @param stats The statistics being recorded, or NULL if statistics are
+ * disabled. The CPU time of any jobs run on other threads is added to the
+ * second pass.
  * @warning This function modifies the sections.
  * @return A status entity indicating whether or not the pass was successful.
  */
-static Assembler_Status assemble_second_pass(Section* sections,
+static Assembler_Status assemble_second_pass(const char* input_filename,
+	Section* sections,
 	Symbol_Table* symbol_table,
-	Statement* statements);
+	const Statement_Location* locations,
+	const size_t n_locations,
+	const size_t n_jobs,
+	Assembly_Stats* stats);
+
+/**
+ * @brief Finds the sections that statements can be encoded in.
+ *
+ * @param sections A pointer to the section linked list.
+ * @param program_sections The resulting sections, indexed by `Program_Section`.
+ * @return A status entity indicating whether or not all of the sections were
+ * found.
+ */
+static Assembler_Status find_program_sections(const Section* sections,
+	Section** program_sections);
+
+/**
+ * @brief Encodes a single statement.
+ *
+ * Encodes a statement into its section at the location calculated by the first
+ * pass. The amount of data encoded must match the statement's calculated size.
+ * @param program_sections The sections that statements are encoded in, indexed
+ * by `Program_Section`.
+ * @param symbol_table A pointer to the symbol table.
+ * @param location The location of the statement to encode.
+ * @return A status entity indicating whether or not the statement was encoded.
+ */
+static Assembler_Status encode_statement(Section** program_sections,
+	const Symbol_Table* symbol_table,
+	const Statement_Location* location);
+
+/**
+ * @brief Encodes a chunk of statements.
+ *
+ * Thread entry point for encoding a chunk of statements in the second pass.
+ * The chunk's windows are created from the range of each section occupied by
+ * its statements. The result is stored in the chunk's status.
+ * @param chunk A pointer to the `Encoding_Chunk` to encode.
+ * @return NULL.
+ */
+static void* encode_chunk(void* chunk);
+
+/**
+ * @brief Encodes all of the program's statements.
+ *
+ * Splits the statement locations into chunks of equal length, and encodes each
+ * chunk on its own thread into windows onto the pre-sized section data. The
+ * first chunk is encoded by the calling thread. The relocation entries of each
+ * chunk are then merged into their sections in statement order.
+ * @param input_filename The name of the file being assembled, used to label
+ * the trace events of each job.
+ * @param program_sections The sections that statements are encoded in, indexed
+ * by `Program_Section`.
+ * @param symbol_table A pointer to the symbol table.
+ * @param locations The statement locations calculated by the first pass.
+ * @param n_locations The number of statement locations.
+ * @param n_chunks The number of chunks to split the statements into.
+ * @param stats The statistics being recorded, or NULL if statistics are
+ * disabled. The CPU time of the chunks encoded on other threads is added to
+ * the second pass.
+ * @return A status entity indicating whether or not the pass was successful.
+ */
+static Assembler_Status encode_statements(const char* input_filename,
+	Section** program_sections,
+	const Symbol_Table* symbol_table,
+	const Statement_Location* locations,
+	const size_t n_locations,
+	const size_t n_chunks,
+	Assembly_Stats* stats);
+
+/**
+ * @brief Writes the assembled ELF image to the output file.
+ *
+ * The ELF header, the data of every section and the section header table are
+ * gathered into a single I/O vector and written with `writev`, so the number
+ * of writes does not depend on the amount of encoded data. The file layout must
+ * already have been computed by `layout_sections`. Any gaps left by alignment
+ * are filled with zero bytes.
+ * @param output_filename The name of the output file.
+ * @param elf_header The ELF file header.
+ * @param sections A pointer to the section linked list.
+ * @param section_headers The encoded section header table. Contains one header
+ * for each section.
+ * @return A status entity indicating whether or not the write was successful.
+ */
+static Assembler_Status write_output_file(const char* output_filename,
+	const Elf32_Ehdr* elf_header,
+	const Section* sections,
+	const Elf32_Shdr* section_headers);
+
+/**
+ * @brief Records the statistics of the encoded sections.
+ *
+ * Records the number of relocation entries, and the number of bytes encoded in
+ * the program sections.
+ * @param stats The statistics being recorded.
+ * @param sections A pointer to the section linked list.
+ */
+static void record_section_stats(Assembly_Stats* stats,
+	const Section* sections);
+
+/**
+ * @brief Records the statistics of the arena.
+ *
+ * Records the number of allocations made from the arena, and the number of
+ * blocks and bytes that they occupy. This is recorded whether or not assembly
+ * succeeds, so that failed files report the arena usage up to the failure.
+ * @param stats The statistics being recorded.
+ * @param arena The arena used to assemble the file.
+ */
+static void record_arena_stats(Assembly_Stats* stats,
+	const Arena* arena);
+
+/**
+ * @brief Assembles files from the queue until it is empty.
+ *
+ * Thread entry point for the workers assembling multiple input files.
+ * @param queue A pointer to the `Assembly_Queue` to take files from.
+ * @return NULL.
+ */
+static void* assemble_queued_files(void* queue);
+
+/**
+ * find_program_sections
+ */
+static Assembler_Status find_program_sections(const Section* sections,
+	Section** program_sections)
+{
+	program_sections[PROGRAM_SECTION_TEXT] = find_section(sections, ".text");
+	if(!program_sections[PROGRAM_SECTION_TEXT]) {
+		fprintf(stderr, "Unable to locate .text section\n");
+		return ASSEMBLER_ERROR_MISSING_SECTION;
+	}
+
+	program_sections[PROGRAM_SECTION_DATA] = find_section(sections, ".data");
+	if(!program_sections[PROGRAM_SECTION_DATA]) {
+		fprintf(stderr, "Unable to locate .data section\n");
+		return ASSEMBLER_ERROR_MISSING_SECTION;
+	}
+
+	program_sections[PROGRAM_SECTION_BSS] = find_section(sections, ".bss");
+	if(!program_sections[PROGRAM_SECTION_BSS]) {
+		fprintf(stderr, "Unable to locate .bss section\n");
+		return ASSEMBLER_ERROR_MISSING_SECTION;
+	}
+
+	return ASSEMBLER_STATUS_SUCCESS;
+}
+
 
 /**
  * assemble_first_pass
  */
 static Assembler_Status assemble_first_pass(Section* sections,
 	Symbol_Table* symbol_table,
-	Statement* statements)
+	Statement* statements,
+	Statement_Location** locations,
+	size_t* n_locations)
 {
 	/** The status of internal assembler function calls. */
 	Assembler_Status status = ASSEMBLER_STATUS_SUCCESS;
-	/** The text section. */
-	Section* section_text = NULL;
-	/** The program data section. */
-	Section* section_data = NULL;
-	/** The program bss section. */
-	Section* section_bss = NULL;
-	/** Pointer to the current section being parsed. */
-	Section* curr_section = NULL;
+	/** The sections that statements are encoded in. */
+	Section* program_sections[PROGRAM_SECTION_COUNT];
+	/** The index of the current section being parsed. */
+	Program_Section curr_section = PROGRAM_SECTION_TEXT;
 	/** Pointer to the current statement being parsed. */
 	Statement* curr = NULL;
+	/** The location of the current statement. */
+	Statement_Location* location = NULL;
 	/** The encoded size of the statement. */
 	size_t statement_size = 0;
+	/** The total number of labels in the program. */
+	size_t n_labels = 0;
+	/** The total number of statements in the program. */
+	size_t n_statements = 0;
 
 
-#if DEBUG_ASSEMBLER == 1
-	printf("Debug Assembler: Begin first pass\n");
-#endif
-
-	section_text = find_section(sections, ".text");
-	if(!section_text) {
-		fprintf(stderr, "Unable to locate .text section\n");
+	TRACE(TRACE_CHANNEL_ASSEMBLER, "Debug Assembler: Begin first pass\n");
 
-		return ASSEMBLER_ERROR_MISSING_SECTION;
+	status = find_program_sections(sections, program_sections);
+	if(!get_status(status)) {
+		// Error message will have been printed by the callee.
+		return status;
 	}
 
-	section_data = find_section(sections, ".data");
-	if(!section_data) {
-		fprintf(stderr, "Unable to locate .data section\n");
-
-		return ASSEMBLER_ERROR_MISSING_SECTION;
+	// Every label defines a symbol. Reserve space for all of them up front so
+	// that the symbol table is not resized during the pass.
+	for(curr = statements; curr; curr = curr->next) {
+		n_labels += curr->n_labels;
+		n_statements++;
 	}
 
-	section_bss = find_section(sections, ".bss");
-	if(!section_bss) {
-		fprintf(stderr, "Unable to locate .bss section\n");
+	status = symtab_reserve(symbol_table, symbol_table->n_entries + n_labels);
+	if(!get_status(status)) {
+		// Error message will have been printed by the callee.
+		return status;
+	}
 
-		return ASSEMBLER_ERROR_MISSING_SECTION;
+	*locations = malloc(sizeof(Statement_Location) * (n_statements ? n_statements : 1));
+	if(!*locations) {
+		fprintf(stderr, "Error: Error allocating statement locations\n");
+		return ASSEMBLER_ERROR_BAD_ALLOC;
 	}
 
+	*n_locations = n_statements;
+
 	// Start in the .text section by default.
-	curr_section = section_text;
+	curr_section = PROGRAM_SECTION_TEXT;
 
+	location = *locations;
 	curr = statements;
 	while(curr) {
 		// All labels must be processed first.
 		// Since a label _can_ precede a section directive, but not the other way around.
 		if(curr->labels) {
 			for(size_t i = 0; i < curr->n_labels; i++) {
-				Symbol* added_sybmol = symtab_add_symbol(symbol_table, curr->labels[i], curr_section,
-					curr_section->program_counter);
+				Symbol* added_sybmol = symtab_add_symbol(symbol_table, curr->labels[i],
+					program_sections[curr_section],
+					program_sections[curr_section]->program_counter);
 				if(!added_sybmol) {
 					// Error should already have been set.
 					return ASSEMBLER_ERROR_SYMBOL_ENTITY_FAILURE;
@@ -144,228 +403,417 @@ static Assembler_Status assemble_first_pass(Section* sections,
 		// These have a size of zero, as returned from `get_statement_size`.
 		if(curr->type == STATEMENT_TYPE_DIRECTIVE) {
 			if(curr->directive.type == DIRECTIVE_BSS) {
-				curr_section = section_bss;
+				curr_section = PROGRAM_SECTION_BSS;
 			} else if(curr->directive.type == DIRECTIVE_DATA) {
-				curr_section = section_data;
+				curr_section = PROGRAM_SECTION_DATA;
 			} else if(curr->directive.type == DIRECTIVE_TEXT) {
-				curr_section = section_text;
+				curr_section = PROGRAM_SECTION_TEXT;
 			}
 		}
 
 		// Get the size of the statement.
-		get_statement_size(curr, &statement_size);
+		status = get_statement_size(curr, &statement_size);
 		if(!get_status(status)) {
 			// Error will already have been printed.
 			return ASSEMBLER_ERROR_STATEMENT_SIZE;
 		}
 
-#if DEBUG_ASSEMBLER == 1
-	printf("Debug Assembler: Calculated size `0x%lx` for statement.\n", statement_size);
-#endif
+		TRACE(TRACE_CHANNEL_ASSEMBLER,
+			"Debug Assembler: Calculated size `0x%lx` for statement.\n", statement_size);
+
+		// Sections are addressed with 32bit offsets in the output file.
+		if(program_sections[curr_section]->program_counter + statement_size > UINT32_MAX) {
+			fprintf(stderr, "Error: Section `%s` exceeds the maximum section size\n",
+				program_sections[curr_section]->name);
+			return ASSEMBLER_ERROR_STATEMENT_SIZE;
+		}
+
+		// Record where the statement will be encoded.
+		location->statement = curr;
+		location->section = curr_section;
+		location->offset = program_sections[curr_section]->program_counter;
+		location->size = statement_size;
+		location++;
 
 		// Increment the current section's program counter by the size of the
 		// statement that has been computed.
-		curr_section->program_counter += (size_t)statement_size;
+		program_sections[curr_section]->program_counter += statement_size;
 		curr = curr->next;
 	}
 
 
-#if DEBUG_SYMBOLS == 1
-	// Print the symbol table.
-	printf("Debug Assembler: Symbol Table:\n");
-	print_symbol_table(symbol_table);
-#endif
+	if(trace_is_enabled(TRACE_CHANNEL_SYMBOLS)) {
+		trace_printf("Debug Assembler: Symbol Table:\n");
+		print_symbol_table(symbol_table);
+	}
 
 	return ASSEMBLER_STATUS_SUCCESS;
 }
 
 
 /**
- * assemble_second_pass
+ * encode_statement
  */
-static Assembler_Status assemble_second_pass(Section* sections,
-	Symbol_Table* symbol_table,
-	Statement* statements)
+static Assembler_Status encode_statement(Section** program_sections,
+	const Symbol_Table* symbol_table,
+	const Statement_Location* location)
 {
-	/** The status of the encoding pass. */
+	/** The status of encoding the statement. */
 	Assembler_Status status = ASSEMBLER_STATUS_SUCCESS;
-	/** Pointer to the current section being encoded. */
-	Section* curr_section = NULL;
-	/** Pointer to the program text section. */
-	Section* section_text = NULL;
-	/** Pointer to the program data section. */
-	Section* section_data = NULL;
-	/** Pointer to the program bss section. */
-	Section* section_bss = NULL;
-	/** Pointer to the current statement being encoded. */
-	Statement* curr = NULL;
-	/** Pointer to the current encoding entity being encoded. */
-	Encoding_Entity* encoding = NULL;
-	/** Used for tracking the result of adding the entity to a section. */
-	Encoding_Entity* added_entity = NULL;
+	/** The statement to encode. */
+	const Statement* statement = location->statement;
+	/** The section that the statement is encoded in. */
+	Section* section = program_sections[location->section];
+	/** The size of the section's data prior to encoding the statement. */
+	const size_t initial_size = section->size;
+
+	// The section's program counter is kept at the offset of the end of its
+	// encoded data, so that it can be checked against the statement's location.
+	if(section->program_counter != location->offset) {
+		fprintf(stderr, "Error: Statement on line `%zu` encoded out of order\n",
+			statement->line_num);
+		return ASSEMBLER_ERROR_BAD_SECTION_DATA;
+	}
 
-	if(!sections) {
-		fprintf(stderr, "Invalid section data\n");
-		return ASSEMBLER_ERROR_BAD_FUNCTION_ARGS;
+	if(statement->type == STATEMENT_TYPE_DIRECTIVE) {
+		const char* directive_name = get_directive_string(&statement->directive);
+		if(!directive_name) {
+			fprintf(stderr, "Error: Unable to get directive type for `%i`\n",
+				statement->directive.type);
+			return CODEGEN_ERROR_BAD_OPCODE;
+		}
+
+		switch(statement->directive.type) {
+			case DIRECTIVE_ALIGN:
+			case DIRECTIVE_BSS:
+			case DIRECTIVE_DATA:
+			case DIRECTIVE_GLOBAL:
+			case DIRECTIVE_SIZE:
+			case DIRECTIVE_TEXT:
+				// These entities are not directly encoded.
+				// They represent instructions to the assembler which do not result
+				// in encoded binary entities. Section directives have already been
+				// resolved by the first pass.
+				break;
+			default:
+				status = encode_directive(section, symbol_table, &statement->directive,
+					location->offset);
+				if(!get_status(status)) {
+					if(status == CODEGEN_ERROR_OPERAND_COUNT_MISMATCH) {
+						fprintf(stderr, "Error: Operand count mismatch for `%s` directive\n",
+							directive_name);
+
+						return status;
+					} else if(status == CODEGEN_ERROR_BAD_OPERAND_TYPE) {
+						fprintf(stderr, "Error: Invalid operand type for `%s` directive\n",
+							directive_name);
+					}
+
+					// Error message should already be set in the encode function.
+					return ASSEMBLER_ERROR_CODEGEN_FAILURE;
+				}
+
+				TRACE(TRACE_CHANNEL_CODEGEN,
+					"Debug Codegen: Encoded directive `%s`\n", directive_name);
+		}
+	} else if(statement->type == STATEMENT_TYPE_INSTRUCTION) {
+		/** A string representing the opcode type being encoded. */
+		const char* opcode_name = get_opcode_string(statement->instruction.opcode);
+		if(!opcode_name) {
+			fprintf(stderr, "Error: Unable to get opcode name for `%i`\n",
+				statement->instruction.opcode);
+			return CODEGEN_ERROR_BAD_OPCODE;
+		}
+
+		status = encode_instruction(section, symbol_table, &statement->instruction,
+			location->offset);
+		if(!get_status(status)) {
+			if(status == CODEGEN_ERROR_OPERAND_COUNT_MISMATCH) {
+				fprintf(stderr, "Error: Operand count mismatch for instruction `%s`\n",
+					opcode_name);
+
+				return status;
+			}
+
+			// Error message should already be set in the encode function.
+			return ASSEMBLER_ERROR_CODEGEN_FAILURE;
+		}
+
+		if(trace_is_enabled(TRACE_CHANNEL_CODEGEN)) {
+			/** String representation of the encoded instruction. */
+			char* string_representation = get_encoding_as_string(section->data +
+				initial_size);
+			trace_printf("Debug Codegen: Encoded instruction `%s` at `0x%x` as `%s`\n",
+				opcode_name, location->offset, string_representation);
+
+			free(string_representation);
+		}
 	}
 
-	if(!symbol_table) {
-		fprintf(stderr, "Invalid symbol table data\n");
-		return ASSEMBLER_ERROR_BAD_FUNCTION_ARGS;
+	if(section->size - initial_size != location->size) {
+		fprintf(stderr, "Error: Encoded size of statement on line `%zu` differs from its calculated size\n",
+			statement->line_num);
+		return ASSEMBLER_ERROR_BAD_SECTION_DATA;
 	}
 
-	if(!statements) {
-		fprintf(stderr, "Invalid statement data\n");
-		return ASSEMBLER_ERROR_BAD_FUNCTION_ARGS;
+	section->program_counter += location->size;
+
+	return ASSEMBLER_STATUS_SUCCESS;
+}
+
+
+/**
+ * encode_chunk
+ */
+static void* encode_chunk(void* chunk)
+{
+	/** The chunk being encoded. */
+	Encoding_Chunk* encoding_chunk = chunk;
+	/** The chunk's windows onto each program section. */
+	Section* windows[PROGRAM_SECTION_COUNT];
+	/** The start of the range of each section occupied by the chunk. */
+	size_t range_start[PROGRAM_SECTION_COUNT];
+	/** The end of the range of each section occupied by the chunk. */
+	size_t range_end[PROGRAM_SECTION_COUNT];
+	/** Whether the chunk contains any statements in each section. */
+	bool in_section[PROGRAM_SECTION_COUNT] = { false };
+	/** The location of the current statement. */
+	const Statement_Location* location = NULL;
+	/** Times the chunk's trace event. */
+	Stats_Timer span_timer;
+	/** The thread's CPU time at the start of the chunk. */
+	const double cpu_time = stats_get_thread_cpu_time();
+
+	stats_begin_span(&span_timer);
+
+	// The statements in each section are contiguous, so the range of a section
+	// occupied by the chunk spans from its first to its last statement there.
+	for(size_t i = 0; i < encoding_chunk->n_locations; i++) {
+		location = &encoding_chunk->locations[i];
+		if(!in_section[location->section]) {
+			in_section[location->section] = true;
+			range_start[location->section] = location->offset;
+		}
+
+		range_end[location->section] = location->offset + location->size;
 	}
 
-	// Ensure all section program counters counters are reset.
-	// These will have been set by the first assembly pass.
-	curr_section = sections;
-	while(curr_section) {
-		curr_section->program_counter = 0;
-		curr_section = curr_section->next;
+	for(size_t s = 0; s < PROGRAM_SECTION_COUNT; s++) {
+		if(!in_section[s]) {
+			range_start[s] = 0;
+			range_end[s] = 0;
+		}
+
+		section_window(&encoding_chunk->windows[s], encoding_chunk->program_sections[s],
+			range_start[s], range_end[s] - range_start[s]);
+		windows[s] = &encoding_chunk->windows[s];
 	}
 
-	section_text = find_section(sections, ".text");
-	if(!section_text) {
-		fprintf(stderr, "Unable to locate .text section\n");
-		return ASSEMBLER_ERROR_MISSING_SECTION;
+	encoding_chunk->status = ASSEMBLER_STATUS_SUCCESS;
+
+	for(size_t i = 0; i < encoding_chunk->n_locations; i++) {
+		encoding_chunk->status = encode_statement(windows,
+			encoding_chunk->symbol_table, &encoding_chunk->locations[i]);
+		if(!get_status(encoding_chunk->status)) {
+			// Error message printed in callee.
+			break;
+		}
 	}
 
-	section_data = find_section(sections, ".data");
-	if(!section_data) {
-		fprintf(stderr, "Unable to locate .data section\n");
-		return ASSEMBLER_ERROR_MISSING_SECTION;
+	stats_end_span(&span_timer, "encode_chunk", "job",
+		encoding_chunk->input_filename);
+	trace_flush();
+
+	encoding_chunk->cpu_time = stats_get_thread_cpu_time() - cpu_time;
+
+	return NULL;
+}
+
+
+/**
+ * encode_statements
+ */
+static Assembler_Status encode_statements(const char* input_filename,
+	Section** program_sections,
+	const Symbol_Table* symbol_table,
+	const Statement_Location* locations,
+	const size_t n_locations,
+	const size_t n_chunks,
+	Assembly_Stats* stats)
+{
+	/** The status of the encoding process. */
+	Assembler_Status status = ASSEMBLER_STATUS_SUCCESS;
+	/** The chunks of statements encoded by each job. */
+	Encoding_Chunk* chunks = NULL;
+	/** The threads encoding each chunk. Chunk zero is encoded by this thread. */
+	pthread_t* threads = NULL;
+	/** Whether the thread for each chunk was started. */
+	bool* started = NULL;
+	/** The index of the first statement in the current chunk. */
+	size_t chunk_start = 0;
+
+	chunks = calloc(n_chunks, sizeof(Encoding_Chunk));
+	threads = calloc(n_chunks, sizeof(pthread_t));
+	started = calloc(n_chunks, sizeof(bool));
+	if(!chunks || !threads || !started) {
+		fprintf(stderr, "Error: Error allocating second pass jobs\n");
+		status = ASSEMBLER_ERROR_BAD_ALLOC;
+
+		goto FAIL_FREE_CHUNKS;
 	}
 
-	section_bss = find_section(sections, ".bss");
-	if(!section_bss) {
-		fprintf(stderr, "Unable to locate .bss section\n");
-		return ASSEMBLER_ERROR_MISSING_SECTION;
+	// Partition the statements into chunks of equal length.
+	for(size_t c = 0; c < n_chunks; c++) {
+		chunk_start = (c * n_locations) / n_chunks;
+
+		chunks[c].input_filename = input_filename;
+		chunks[c].program_sections = program_sections;
+		chunks[c].symbol_table = symbol_table;
+		chunks[c].locations = &locations[chunk_start];
+		chunks[c].n_locations = (((c + 1) * n_locations) / n_chunks) - chunk_start;
 	}
 
-	// Start in the .text section by default.
-	curr_section = section_text;
+	for(size_t c = 1; c < n_chunks; c++) {
+		started[c] = pthread_create(&threads[c], NULL, encode_chunk, &chunks[c]) == 0;
+	}
 
-	// Iterate over all statements.
-	curr = statements;
-	while(curr) {
-		if(curr->type == STATEMENT_TYPE_DIRECTIVE) {
-			const char* directive_name = get_directive_string(&curr->directive);
-			if(!directive_name) {
-				fprintf(stderr, "Error: Unable to get directive type for `%i`\n",
-					curr->directive.type);
-				return CODEGEN_ERROR_BAD_OPCODE;
-			}
+	encode_chunk(&chunks[0]);
 
-			switch(curr->directive.type) {
-				case DIRECTIVE_BSS:
-#if DEBUG_ASSEMBLER == 1
-	printf("Debug Assembler: Setting current section to `.bss`\n");
-#endif
-					curr_section = section_bss;
-					break;
-				case DIRECTIVE_DATA:
-#if DEBUG_ASSEMBLER == 1
-	printf("Debug Assembler: Setting current section to `.data`\n");
-#endif
-					curr_section = section_data;
-					break;
-				case DIRECTIVE_TEXT:
-#if DEBUG_ASSEMBLER == 1
-	printf("Debug Assembler: Setting current section to `.text`\n");
-#endif
-					curr_section = section_text;
-					break;
-				case DIRECTIVE_ALIGN:
-				case DIRECTIVE_SIZE:
-				case DIRECTIVE_GLOBAL:
-					// These entities are not directly encoded.
-					// They represent instructions to the assembler which do not result
-					// in encoded binary entities.
-					break;
-				default:
-					status = encode_directive(&encoding, symbol_table, &curr->directive,
-						curr_section->program_counter);
-					if(!get_status(status)) {
-						if(status == CODEGEN_ERROR_OPERAND_COUNT_MISMATCH) {
-							fprintf(stderr, "Error: Operand count mismatch for `%s` directive\n",
-								directive_name);
-
-							return status;
-						} else if(status == CODEGEN_ERROR_BAD_OPERAND_TYPE) {
-							fprintf(stderr, "Error: Invalid operand type for `%s` directive\n",
-								directive_name);
-						}
-
-						// Error message should already be set in the encode function.
-						return ASSEMBLER_ERROR_CODEGEN_FAILURE;
-					}
+	for(size_t c = 1; c < n_chunks; c++) {
+		if(started[c]) {
+			pthread_join(threads[c], NULL);
+			// The chunks encoded on this thread are timed with the second pass.
+			stats_add_cpu_time(stats, STATS_PHASE_SECOND_PASS, chunks[c].cpu_time);
+		} else {
+			// If a thread could not be started, its chunk is encoded here instead.
+			encode_chunk(&chunks[c]);
+		}
+	}
 
-#if DEBUG_CODEGEN == 1
-					printf("Debug Codegen: Encoded directive `%s`\n", directive_name);
-#endif
+	// Check the chunks in statement order, so that the reported error is the
+	// same as that reported by a serial pass.
+	for(size_t c = 0; c < n_chunks; c++) {
+		if(!get_status(chunks[c].status)) {
+			status = chunks[c].status;
 
-					curr_section->program_counter += encoding->size;
-					added_entity = section_add_encoding_entity(curr_section, encoding);
-					if(!added_entity) {
-						// Error message should already be set.
-						return ASSEMBLER_ERROR_SECTION_ENTITY_FAILURE;
-					}
-			}
-		} else if(curr->type == STATEMENT_TYPE_INSTRUCTION) {
-			/** A string representing the opcode type being encoded. */
-			const char* opcode_name = get_opcode_string(curr->instruction.opcode);
-			if(!opcode_name) {
-				fprintf(stderr, "Error: Unable to get opcode name for `%i`\n",
-					curr->instruction.opcode);
-				return CODEGEN_ERROR_BAD_OPCODE;
+			goto FAIL_FREE_WINDOWS;
+		}
+	}
+
+	// Merge the relocation entries of each chunk in statement order.
+	for(size_t s = 0; s < PROGRAM_SECTION_COUNT; s++) {
+		for(size_t c = 0; c < n_chunks; c++) {
+			for(size_t r = 0; r < chunks[c].windows[s].n_reloc_entries; r++) {
+				status = section_add_reloc_entry(program_sections[s],
+					chunks[c].windows[s].reloc_entries[r].symbol_name,
+					chunks[c].windows[s].reloc_entries[r].offset,
+					chunks[c].windows[s].reloc_entries[r].type);
+				if(!get_status(status)) {
+					// Error message printed in callee.
+					goto FAIL_FREE_WINDOWS;
+				}
 			}
+		}
 
-			status = encode_instruction(&encoding, symbol_table, &curr->instruction,
-				curr_section->program_counter);
-			if(!get_status(status)) {
-				if(status == CODEGEN_ERROR_OPERAND_COUNT_MISMATCH) {
-					fprintf(stderr, "Error: Operand count mismatch for instruction `%s`\n",
-						opcode_name);
+		// Every statement has been encoded at its calculated size, so the
+		// section's data now extends to the end of the first pass.
+		program_sections[s]->size = program_sections[s]->program_counter;
+	}
 
-					return status;
-				}
+FAIL_FREE_WINDOWS:
+	for(size_t c = 0; c < n_chunks; c++) {
+		for(size_t s = 0; s < PROGRAM_SECTION_COUNT; s++) {
+			free_section_window(&chunks[c].windows[s]);
+		}
+	}
 
-				// Error message should already be set in the encode function.
-				return ASSEMBLER_ERROR_CODEGEN_FAILURE;
-			}
+FAIL_FREE_CHUNKS:
+	free(started);
+	free(threads);
+	free(chunks);
 
-#if DEBUG_CODEGEN == 1
-			/** String representation of the encoded instruction. */
-			char* string_representation = get_encoding_as_string(encoding);
-			printf("Debug Codegen: Encoded instruction `%s` at `0x%zx` as `%s`\n",
-				opcode_name, curr_section->program_counter, string_representation);
+	return status;
+}
 
-			free(string_representation);
-#endif
 
-			curr_section->program_counter += encoding->size;
-			added_entity = section_add_encoding_entity(curr_section, encoding);
-			if(!added_entity) {
-				// Error message should already be set.
-				return ASSEMBLER_ERROR_SECTION_ENTITY_FAILURE;
-			}
+/**
+ * assemble_second_pass
+ */
+static Assembler_Status assemble_second_pass(const char* input_filename,
+	Section* sections,
+	Symbol_Table* symbol_table,
+	const Statement_Location* locations,
+	const size_t n_locations,
+	const size_t n_jobs,
+	Assembly_Stats* stats)
+{
+	/** The status of the encoding pass. */
+	Assembler_Status status = ASSEMBLER_STATUS_SUCCESS;
+	/** Pointer to the current section being reserved. */
+	Section* section = NULL;
+	/** The sections that statements are encoded in. */
+	Section* program_sections[PROGRAM_SECTION_COUNT];
+	/** The number of chunks to encode the statements in. */
+	size_t n_chunks = 1;
+
+	if(!sections) {
+		fprintf(stderr, "Invalid section data\n");
+		return ASSEMBLER_ERROR_BAD_FUNCTION_ARGS;
+	}
+
+	if(!symbol_table) {
+		fprintf(stderr, "Invalid symbol table data\n");
+		return ASSEMBLER_ERROR_BAD_FUNCTION_ARGS;
+	}
+
+	if(!locations) {
+		fprintf(stderr, "Invalid statement data\n");
+		return ASSEMBLER_ERROR_BAD_FUNCTION_ARGS;
+	}
+
+	// Reserve each section's data to the size calculated by the first pass, so
+	// that each statement can be encoded directly at its location.
+	section = sections;
+	while(section) {
+		status = section_reserve(section, section->program_counter);
+		if(!get_status(status)) {
+			// Error message printed in callee.
+			return status;
 		}
 
-		curr = curr->next;
+		section = section->next;
 	}
 
-#if DEBUG_ASSEMBLER == 1
-	printf("Debug Assembler: Populating relocation entries\n");
-#endif
+	status = find_program_sections(sections, program_sections);
+	if(!get_status(status)) {
+		// Error message printed in callee.
+		return status;
+	}
 
-	populate_relocation_entries(symbol_table, sections);
+	// Only split the statements into as many chunks as are worth encoding
+	// separately.
+	if(n_jobs > 1) {
+		n_chunks = n_locations / SECOND_PASS_MIN_CHUNK_STATEMENTS;
+		if(n_chunks > n_jobs) {
+			n_chunks = n_jobs;
+		}
 
-#if DEBUG_ASSEMBLER == 1
-	printf("Debug Assembler: Finished second pass\n");
-#endif
+		if(n_chunks < 1) {
+			n_chunks = 1;
+		}
+	}
+
+	TRACE(TRACE_CHANNEL_ASSEMBLER,
+		"Debug Assembler: Encoding statements in `%zu` jobs\n", n_chunks);
+
+	status = encode_statements(input_filename, program_sections, symbol_table,
+		locations, n_locations, n_chunks, stats);
+	if(!get_status(status)) {
+		// Error message printed in callee.
+		return status;
+	}
+
+	TRACE(TRACE_CHANNEL_ASSEMBLER, "Debug Assembler: Finished second pass\n");
 
 	return ASSEMBLER_STATUS_SUCCESS;
 }
@@ -376,16 +824,12 @@ static Assembler_Status assemble_second_pass(Section* sections,
  */
 Assembler_Status assemble(const char* input_filename,
 	const char* output_filename,
-	const bool verbose)
+	const size_t n_jobs,
+	Assembly_Stats* stats)
 {
-#if DEBUG_ASSEMBLER == 1
-	printf("Debug Assembler: Beginning main assembler process.\n");
-	printf("  Using input file `%s`.\n", input_filename);
-	printf("  Using output file `%s`.\n", output_filename);
-	if(verbose) {
-		printf("  Verbose output enabled.\n");
-	}
-#endif
+	TRACE(TRACE_CHANNEL_ASSEMBLER, "Debug Assembler: Beginning main assembler process.\n"
+		"  Using input file `%s`.\n"
+		"  Using output file `%s`.\n", input_filename, output_filename);
 
 	/**
 	 * @brief The main process result status.
@@ -397,64 +841,78 @@ Assembler_Status assemble(const char* input_filename,
 	FILE* input_file = NULL;
 	/** The ELF file header. */
 	Elf32_Ehdr* elf_header = NULL;
+	/** The ELF section header table. */
+	Elf32_Shdr* section_headers = NULL;
 	/** The binary section data. */
 	Section* sections = NULL;
 	/** The individual statements parsed from the source input file. */
 	Statement* program_statements = NULL;
+	/** The location of each statement, calculated by the first pass. */
+	Statement_Location* statement_locations = NULL;
+	/** The number of statement locations. */
+	size_t n_statement_locations = 0;
 	/** The executable symbol table. */
 	Symbol_Table symbol_table;
+	/** The string pool holding every symbol name in the program. */
+	String_Pool string_pool;
+	/**
+	 * The arena that owns the parsed statements. These are all released together
+	 * once assembly is complete.
+	 */
+	Arena arena;
+	/** The timer for the current phase. */
+	Stats_Timer phase_timer;
+
+
+	if(stats) {
+		stats->input_filename = input_filename;
+	}
+
+	process_status = initialise_string_pool(&string_pool);
+	if(!get_status(process_status)) {
+		// Return here, no cleanup necessary.
+		return process_status;
+	}
 
+	process_status = initialise_arena(&arena);
+	if(!get_status(process_status)) {
+		// Error message set in callee.
+		goto FAIL_FREE_STRING_POOL;
+	}
 
 	input_file = fopen(input_filename, "r");
 	if(!input_file) {
 		fprintf(stderr, "Error opening input file `%s`: `%i`.\n",
 			input_filename, errno);
+		process_status = ASSEMBLER_ERROR_FILE_FAILURE;
 
-		// Return here, no cleanup necessary.
-		return ASSEMBLER_ERROR_FILE_FAILURE;
+		goto FAIL_FREE_ARENA;
 	}
 
 	// Read in all the statements from the source file.
-	process_status = read_input(input_file, &program_statements);
+	process_status = read_input(input_file, &arena, &string_pool,
+		&program_statements, stats);
+
+	// The file is closed whether or not it was read successfully.
+	const int close_status = fclose(input_file);
 	if(!get_status(process_status)) {
-		goto FAIL_FREE_STATEMENTS;
+		goto FAIL_FREE_ARENA;
 	}
 
-	const int close_status = fclose(input_file);
 	if(close_status) {
 		fprintf(stderr, "Error closing file handler: `%u`.\n", errno);
 		process_status = ASSEMBLER_ERROR_FILE_FAILURE;
 
-		goto FAIL_FREE_STATEMENTS;
+		goto FAIL_FREE_ARENA;
 	}
 
-	// Initialise with room for the null symbol entry.
-	symbol_table.n_entries = 1;
-	symbol_table.symbols = malloc(sizeof(Symbol));
-	if(!symbol_table.symbols) {
-		fprintf(stderr, "Error allocating symbol table.\n");
-		process_status = ASSEMBLER_ERROR_BAD_ALLOC;
-
-		goto FAIL_FREE_STATEMENTS;
-	}
-
-	// Create the null symbol entry.
-	// This is required as per ELF specification.
-	symbol_table.symbols[0].section = NULL;
-	symbol_table.symbols[0].offset = 0;
-
-	// Create an empty name entry, so as to not disrupt other processes that
-	// require handling of this string.
-	symbol_table.symbols[0].name = malloc(1);
-	if(!symbol_table.symbols[0].name) {
-		fprintf(stderr, "Error: Error allocating null symbol entry\n");
-		process_status = ASSEMBLER_ERROR_BAD_ALLOC;
-
-		goto FAIL_FREE_SYMBOL_TABLE;
+	// Initialise the symbol table with the null symbol entry.
+	process_status = initialise_symbol_table(&symbol_table, &string_pool);
+	if(!get_status(process_status)) {
+		// Error message set in callee.
+		goto FAIL_FREE_ARENA;
 	}
 
-	symbol_table.symbols[0].name[0] = '\0';
-
 	// Initialise the section list.
 	process_status = initialise_sections(&sections);
 	if(!get_status(process_status)) {
@@ -462,41 +920,67 @@ Assembler_Status assemble(const char* input_filename,
 		goto FAIL_FREE_SYMBOL_TABLE;
 	}
 
-#if DEBUG_ASSEMBLER == 1
-	printf("Debug Assembler: Beginning macro expansion\n");
-#endif
+	TRACE(TRACE_CHANNEL_ASSEMBLER, "Debug Assembler: Beginning macro expansion\n");
 
 	// Loop through all statements, expanding all macros.
-	process_status = expand_macros(program_statements);
+	stats_begin_phase(stats, &phase_timer);
+	process_status = expand_macros(program_statements, &arena);
+	stats_end_phase(stats, STATS_PHASE_EXPAND_MACROS, &phase_timer);
 	if(!get_status(process_status)) {
 		// Error message set in callee.
 		goto FAIL_FREE_SYMBOL_TABLE;
 	}
 
 	// Begin the first assembler pass. Populating the symbol table.
+	stats_begin_phase(stats, &phase_timer);
 	process_status = assemble_first_pass(sections,
-		&symbol_table, program_statements);
+		&symbol_table, program_statements, &statement_locations,
+		&n_statement_locations);
+	stats_end_phase(stats, STATS_PHASE_FIRST_PASS, &phase_timer);
 	if(!get_status(process_status)) {
 		// Error message set in callee.
-		goto FAIL_FREE_SECTIONS;
+		goto FAIL_FREE_STATEMENT_LOCATIONS;
 	}
 
 	// Begin the second assembler pass, which handles code generation.
-	process_status = assemble_second_pass(sections,
-		&symbol_table, program_statements);
+	stats_begin_phase(stats, &phase_timer);
+	process_status = assemble_second_pass(input_filename, sections,
+		&symbol_table, statement_locations, n_statement_locations, n_jobs,
+		stats);
+	stats_end_phase(stats, STATS_PHASE_SECOND_PASS, &phase_timer);
+	if(!get_status(process_status)) {
+		// Error message set in callee.
+		goto FAIL_FREE_STATEMENT_LOCATIONS;
+	}
+
+	free(statement_locations);
+	statement_locations = NULL;
+
+	TRACE(TRACE_CHANNEL_ASSEMBLER, "Debug Assembler: Populating relocation entries\n");
+
+	stats_begin_phase(stats, &phase_timer);
+	process_status = populate_relocation_entries(&symbol_table, sections);
+	stats_end_phase(stats, STATS_PHASE_RELOCATIONS, &phase_timer);
 	if(!get_status(process_status)) {
 		// Error message set in callee.
 		goto FAIL_FREE_SECTIONS;
 	}
 
-#if DEBUG_OUTPUT == 1
-	printf("Debug Output: Initialising output file\n");
-#endif
+	if(stats) {
+		record_section_stats(stats, sections);
+		stats->n_statements = n_statement_locations;
+		// The null symbol entry is not counted.
+		stats->n_symbols = symbol_table.n_entries - 1;
+	}
+
+	TRACE(TRACE_CHANNEL_OUTPUT, "Debug Output: Initialising output file\n");
+
+	stats_begin_phase(stats, &phase_timer);
 
 	process_status = create_elf_header(&elf_header);
 	if(!get_status(process_status)) {
 		// Error message set in callee.
-		goto FAIL_FREE_SYMBOL_TABLE;
+		goto FAIL_FREE_SECTIONS;
 	}
 
 	// Find the index into the section header block of the section header
@@ -506,27 +990,22 @@ Assembler_Status assemble(const char* input_filename,
 		fprintf(stderr, "Error: Error finding `.shstrtab` index\n");
 		process_status = ASSEMBLER_ERROR_MISSING_SECTION;
 
-		goto FAIL_FREE_SYMBOL_TABLE;
+		goto FAIL_FREE_ELF_HEADER;
 	}
 
 	elf_header->e_shstrndx = section_shstrtab_index;
 
 
-#if DEBUG_OUTPUT == 1
-	printf("Debug Output: Populating `.shstrtab`\n");
-#endif
+	TRACE(TRACE_CHANNEL_OUTPUT, "Debug Output: Populating `.shstrtab`\n");
 
 	Section* shstrtab = find_section(sections, ".shstrtab");
 	if(!shstrtab) {
 		fprintf(stderr, "Error finding `.shstrtab` index.");
 		process_status = ASSEMBLER_ERROR_MISSING_SECTION;
 
-		goto FAIL_FREE_SYMBOL_TABLE;
+		goto FAIL_FREE_ELF_HEADER;
 	}
 
-	/** Used for tracking the result of adding the entity to a section. */
-	Encoding_Entity* added_entity = NULL;
-
 	Section* curr_section = sections;
 	while(curr_section) {
 		// Iterate through each section and add its name to the section header
@@ -538,222 +1017,439 @@ Assembler_Status assemble(const char* input_filename,
 		// The current section size is the offset of each section name into SHSTRTAB.
 		curr_section->name_strtab_offset = shstrtab->size;
 
-#if DEBUG_OUTPUT == 1
-		printf("Debug Output: Adding section name: `%s` to .shstrtab at offset `0x%lx`...\n",
+		TRACE(TRACE_CHANNEL_OUTPUT,
+			"Debug Output: Adding section name: `%s` to .shstrtab at offset `0x%lx`...\n",
 			curr_section->name, curr_section->name_strtab_offset);
-#endif
 
-		size_t section_name_len = strlen(curr_section->name) + 1;
+		// Write each section name, including its NUL terminator, into the
+		// section header string table's data.
+		process_status = section_write(shstrtab, curr_section->name,
+			strlen(curr_section->name) + 1);
+		if(!get_status(process_status)) {
+			// Error message set in callee.
+			goto FAIL_FREE_ELF_HEADER;
+		}
+
+		curr_section = curr_section->next;
+	}
+
 
-		// Create an encoding entity for each section name.
-		// This raw data will be added to the section header string table binary
-		// data and encoded into the final encoded file.
-		Encoding_Entity* string_entity = malloc(sizeof(Encoding_Entity));
-		if(!string_entity) {
-			fprintf(stderr, "Error allocating section name entity.");
-			process_status = ASSEMBLER_ERROR_BAD_ALLOC;
+	stats_end_phase(stats, STATS_PHASE_OUTPUT, &phase_timer);
 
-			goto FAIL_FREE_SYMBOL_TABLE;
-		}
+	TRACE(TRACE_CHANNEL_OUTPUT, "Debug Output: Populating .symtab...\n");
 
-		string_entity->n_reloc_entries = 0;
-		string_entity->reloc_entries = NULL;
+	stats_begin_phase(stats, &phase_timer);
+	process_status = populate_symtab(sections, &symbol_table);
+	stats_end_phase(stats, STATS_PHASE_SYMTAB, &phase_timer);
+	if(!get_status(process_status)) {
+		// Error message set in callee.
+		goto FAIL_FREE_ELF_HEADER;
+	}
 
-		string_entity->size = section_name_len;
-		string_entity->data = malloc(section_name_len);
-		if(!string_entity->data) {
-			fprintf(stderr, "Error allocating section name entity data.");
-			process_status = ASSEMBLER_ERROR_BAD_ALLOC;
+	stats_begin_phase(stats, &phase_timer);
 
-			goto FAIL_FREE_SYMBOL_TABLE;
-		}
+	// Compute the file layout up front. The section data starts directly after
+	// the ELF header, and the section headers are placed after all of the binary
+	// section data.
+	const size_t section_data_end = layout_sections(sections, elf_header->e_ehsize);
 
-		string_entity->data = memcpy(string_entity->data, curr_section->name,
-			section_name_len);
-		string_entity->data[section_name_len-1] = '\0';
+	// Set the section header offset in the ELF file header.
+	elf_header->e_shoff = align_file_offset(section_data_end, sizeof(Elf32_Word));
+
+	section_headers = malloc(sizeof(Elf32_Shdr) * elf_header->e_shnum);
+	if(!section_headers) {
+		fprintf(stderr, "Error allocating ELF section header table\n");
+		process_status = ASSEMBLER_ERROR_BAD_ALLOC;
 
-		string_entity->next = NULL;
+		goto FAIL_FREE_ELF_HEADER;
+	}
 
-		// Add the encoded string to the `shstrtab` section.
-		added_entity = section_add_encoding_entity(shstrtab, string_entity);
-		if(!added_entity) {
-			fprintf(stderr, "Error adding entity to section header string table.");
-			process_status = ASSEMBLER_ERROR_SECTION_ENTITY_FAILURE;
+	/** The index of the current section's header. */
+	size_t section_header_index = 0;
 
-			goto FAIL_FREE_SYMBOL_TABLE;
+	curr_section = sections;
+	while(curr_section) {
+		// Encode each section header in the ELF format.
+		process_status = encode_section_header(curr_section,
+			&section_headers[section_header_index]);
+		if(!get_status(process_status)) {
+			goto FAIL_FREE_SECTION_HEADERS;
 		}
 
+		section_header_index++;
 		curr_section = curr_section->next;
 	}
 
+	TRACE(TRACE_CHANNEL_OUTPUT,
+		"Debug Output: Writing output file `%s`...\n", output_filename);
 
-#if DEBUG_OUTPUT == 1
-	printf("Debug Output: Populating .symtab...\n");
-#endif
+	process_status = write_output_file(output_filename, elf_header,
+		sections, section_headers);
+	if(!get_status(process_status)) {
+		// Error message set in callee.
+		goto FAIL_FREE_SECTION_HEADERS;
+	}
 
-	populate_symtab(sections, &symbol_table);
+	stats_end_phase(stats, STATS_PHASE_OUTPUT, &phase_timer);
 
-	/** The total size of all section data. */
-	size_t total_section_data_size = 0;
+	TRACE(TRACE_CHANNEL_ASSEMBLER, "Debug Assembler: Cleaning up main program.\n");
 
-	curr_section = sections;
-	while(curr_section) {
-		// Calculate the total section data size.
-		// The section headers will be placed after all of the binary section data in
-		// the file, so we need to compute the total binary data size to predict the
-		// offset of the section headers in the file.
-		total_section_data_size += curr_section->size;
-		curr_section = curr_section->next;
+	free(section_headers);
+	free(elf_header);
+
+	TRACE(TRACE_CHANNEL_ASSEMBLER, "Debug Assembler: Freeing Symbol Table...\n");
+
+	free_symbol_table(&symbol_table);
+
+	TRACE(TRACE_CHANNEL_ASSEMBLER, "Debug Assembler: Freeing sections...\n");
+
+	free_section(sections);
+
+	if(trace_is_enabled(TRACE_CHANNEL_ASSEMBLER)) {
+		trace_printf("Debug Assembler: Freeing arena...\n");
+		print_arena_statistics(&arena);
 	}
 
-	// Set the section header offset in the ELF file header.
-	elf_header->e_shoff = elf_header->e_ehsize + total_section_data_size;
+	if(stats) {
+		record_arena_stats(stats, &arena);
+	}
 
-#if DEBUG_OUTPUT == 1
-		printf("Debug Output: Opening output file `%s`...\n", output_filename);
-#endif
+	free_arena(&arena);
 
-	// Open the output file.
-	FILE* out_file = fopen(output_filename, "w");
-	if(!out_file) {
-		fprintf(stderr, "Error opening output file: `%u`\n", errno);
-		process_status = ASSEMBLER_ERROR_FILE_FAILURE;
+	TRACE(TRACE_CHANNEL_ASSEMBLER, "Debug Assembler: Freeing string pool...\n");
 
-		goto FAIL_FREE_SECTIONS;
+	free_string_pool(&string_pool);
 
+	TRACE(TRACE_CHANNEL_ASSEMBLER, "Debug Assembler: Finished.\n");
+
+	return ASSEMBLER_STATUS_SUCCESS;
+
+FAIL_FREE_SECTION_HEADERS:
+	free(section_headers);
+FAIL_FREE_ELF_HEADER:
+	free(elf_header);
+FAIL_FREE_STATEMENT_LOCATIONS:
+	free(statement_locations);
+FAIL_FREE_SECTIONS:
+	free_section(sections);
+FAIL_FREE_SYMBOL_TABLE:
+	free_symbol_table(&symbol_table);
+FAIL_FREE_ARENA:
+	if(stats) {
+		record_arena_stats(stats, &arena);
 	}
 
-	// Write the ELF file header.
-	size_t entity_write_count = fwrite(elf_header, sizeof(Elf32_Ehdr), 1, out_file);
-	if(entity_write_count != 1) {
-		if(ferror(out_file)) {
-			fprintf(stderr, "Error writing ELF header: `%u`.\n", errno);
-		} else {
-			fprintf(stderr, "Error writing ELF header.\n");
+	free_arena(&arena);
+FAIL_FREE_STRING_POOL:
+	free_string_pool(&string_pool);
+
+	return process_status;
+}
+
+
+/**
+ * record_section_stats
+ */
+static void record_section_stats(Assembly_Stats* stats,
+	const Section* sections)
+{
+	/** The current section being counted. */
+	const Section* section = sections;
+
+	stats->n_relocations = 0;
+	stats->n_encoded_bytes = 0;
+
+	while(section) {
+		stats->n_relocations += section->n_reloc_entries;
+
+		if(strcmp(section->name, ".text") == 0 ||
+			strcmp(section->name, ".data") == 0 ||
+			strcmp(section->name, ".bss") == 0) {
+			stats->n_encoded_bytes += section->size;
 		}
 
-		process_status = ASSEMBLER_ERROR_FILE_FAILURE;
+		section = section->next;
+	}
+}
+
+
+/**
+ * record_arena_stats
+ */
+static void record_arena_stats(Assembly_Stats* stats,
+	const Arena* arena)
+{
+	stats->n_arena_allocations = arena->n_allocations;
+	stats->n_arena_blocks = arena->n_blocks;
+	stats->n_arena_bytes = arena->n_bytes_allocated;
+}
+
 
-		goto FAIL_CLOSE_OUTPUT_FILE;
+/**
+ * assemble_queued_files
+ */
+static void* assemble_queued_files(void* queue)
+{
+	/** The queue being assembled. */
+	Assembly_Queue* assembly_queue = queue;
+	/** The index of the file being assembled. */
+	size_t file_index = 0;
+	/** Times the trace event of each file. */
+	Stats_Timer span_timer;
+
+	while((file_index = atomic_fetch_add(&assembly_queue->next_file, 1)) <
+		assembly_queue->n_files) {
+		stats_begin_span(&span_timer);
+		assembly_queue->results[file_index] = assemble(
+			assembly_queue->input_filenames[file_index],
+			assembly_queue->output_filenames[file_index],
+			assembly_queue->n_jobs,
+			assembly_queue->stats ? &assembly_queue->stats[file_index] : NULL);
+		stats_end_span(&span_timer, "assemble", "file",
+			assembly_queue->input_filenames[file_index]);
+
+		trace_flush();
 	}
 
-	// Write the binary section data to the file.
-	curr_section = sections;
-	while(curr_section) {
-		// Update the section information to store the current file location as the
-		// offset of this section's binary data in the file.
-		curr_section->file_offset = ftell(out_file);
+	return NULL;
+}
 
-#if DEBUG_OUTPUT == 1
-		printf("Debug Output: Writing section: `%s` with size: `0x%lx` at `0x%lx`...\n",
-			curr_section->name, curr_section->size, curr_section->file_offset);
-#endif
 
-		Encoding_Entity* curr_entity = curr_section->encoding_entities;
-		while(curr_entity) {
-			// Write each encoding entity contained in each section.
-			entity_write_count = fwrite(curr_entity->data, curr_entity->size, 1, out_file);
-			if(entity_write_count != 1) {
-				if(ferror(out_file)) {
-					fprintf(stderr, "Error writing section data: `%u`.\n", errno);
-				} else {
-					fprintf(stderr, "Error writing section data.\n");
-				}
+/**
+ * assemble_files
+ */
+Assembler_Status assemble_files(const char* const* input_filenames,
+	const char* const* output_filenames,
+	const size_t n_files,
+	const size_t n_jobs,
+	Assembly_Stats* stats)
+{
+	/** The status of the assembly process. */
+	Assembler_Status status = ASSEMBLER_STATUS_SUCCESS;
+	/** The queue of files shared by the workers. */
+	Assembly_Queue queue;
+	/** The number of worker threads, including the calling thread. */
+	size_t n_workers = n_jobs;
+	/** The worker threads. Worker zero is the calling thread. */
+	pthread_t* workers = NULL;
+	/** Whether each worker thread was started. */
+	bool* started = NULL;
+
+	if(n_workers > n_files) {
+		n_workers = n_files;
+	}
 
-				process_status = ASSEMBLER_ERROR_FILE_FAILURE;
+	if(n_workers < 1) {
+		n_workers = 1;
+	}
 
-				goto FAIL_CLOSE_OUTPUT_FILE;
-			}
+	queue.input_filenames = input_filenames;
+	queue.output_filenames = output_filenames;
+	queue.n_files = n_files;
+	queue.stats = stats;
+	// Any jobs not needed to assemble files concurrently are shared between
+	// the files to encode their statements.
+	queue.n_jobs = n_jobs / n_workers;
+	if(queue.n_jobs < 1) {
+		queue.n_jobs = 1;
+	}
 
-			curr_entity = curr_entity->next;
-		}
+	atomic_init(&queue.next_file, 0);
 
-		curr_section = curr_section->next;
+	queue.results = calloc(n_files ? n_files : 1, sizeof(Assembler_Status));
+	workers = calloc(n_workers, sizeof(pthread_t));
+	started = calloc(n_workers, sizeof(bool));
+	if(!queue.results || !workers || !started) {
+		fprintf(stderr, "Error: Error allocating assembler jobs\n");
+		status = ASSEMBLER_ERROR_BAD_ALLOC;
+
+		goto FAIL_FREE_WORKERS;
 	}
 
-	curr_section = sections;
-	while(curr_section) {
-#if DEBUG_OUTPUT == 1
-		printf("Debug Output: Writing section header `%s` with offset `0x%lx` at `0x%lx`...\n",
-			curr_section->name, curr_section->file_offset, ftell(out_file));
-#endif
+	// Any worker that cannot be started leaves its share of the files in the
+	// queue, where they are taken by the remaining workers.
+	for(size_t w = 1; w < n_workers; w++) {
+		started[w] = pthread_create(&workers[w], NULL, assemble_queued_files,
+			&queue) == 0;
+	}
 
-		/** The header for the current section. */
-		Elf32_Shdr* section_header = NULL;
+	assemble_queued_files(&queue);
 
-		// Encode the section header in the ELF format.
-		process_status = encode_section_header(curr_section, &section_header);
-		if(!get_status(process_status)) {
-			goto FAIL_CLOSE_OUTPUT_FILE;
+	for(size_t w = 1; w < n_workers; w++) {
+		if(started[w]) {
+			pthread_join(workers[w], NULL);
 		}
+	}
 
-		// Write each ELF header to the output file.
-		entity_write_count = fwrite(section_header, sizeof(Elf32_Shdr), 1, out_file);
-		if(entity_write_count != 1) {
-			if(ferror(out_file)) {
-				fprintf(stderr, "Error writing section header data: `%u`.\n", errno);
-			} else {
-				fprintf(stderr, "Error writing section header data.\n");
+	// Report the failures in input order, returning the first.
+	for(size_t i = 0; i < n_files; i++) {
+		if(!get_status(queue.results[i])) {
+			fprintf(stderr, "Error: Failed to assemble `%s`\n", input_filenames[i]);
+			if(get_status(status)) {
+				status = queue.results[i];
 			}
+		}
+	}
 
-			process_status = ASSEMBLER_ERROR_FILE_FAILURE;
+FAIL_FREE_WORKERS:
+	free(started);
+	free(workers);
+	free(queue.results);
 
-			goto FAIL_CLOSE_OUTPUT_FILE;
+	return status;
+}
+
+
+/**
+ * write_output_file
+ */
+static Assembler_Status write_output_file(const char* output_filename,
+	const Elf32_Ehdr* elf_header,
+	const Section* sections,
+	const Elf32_Shdr* section_headers)
+{
+	/** The status of writing the output file. */
+	Assembler_Status status = ASSEMBLER_STATUS_SUCCESS;
+	/**
+	 * The I/O vector describing the whole file. This has an entry for the ELF
+	 * header, each section's data, and the section header table.
+	 */
+	struct iovec* file_vector = NULL;
+	/** The number of entries in the I/O vector. */
+	size_t n_file_vector = 0;
+	/** The index of the first I/O vector entry that is yet to be written. */
+	size_t curr_file_vector = 0;
+	/** The number of bytes written by each call to `writev`. */
+	ssize_t bytes_written = 0;
+	/** The output file descriptor. */
+	int out_file = -1;
+	/** Pointer to the current section being written. */
+	const Section* curr_section = NULL;
+	/** The offset into the file of the end of the I/O vector. */
+	size_t file_offset = 0;
+	/**
+	 * The largest alignment of any section. Bounds the padding needed between
+	 * any two regions of the file.
+	 */
+	size_t max_alignment = sizeof(Elf32_Word);
+	/** Zero bytes used to pad the gaps between regions of the file. */
+	uint8_t* padding = NULL;
 
+	curr_section = sections;
+	while(curr_section) {
+		if(curr_section->alignment > max_alignment) {
+			max_alignment = curr_section->alignment;
 		}
 
-		free(section_header);
+		curr_section = curr_section->next;
+	}
+
+	padding = calloc(1, max_alignment);
+	if(!padding) {
+		fprintf(stderr, "Error allocating output file padding\n");
+
+		return ASSEMBLER_ERROR_BAD_ALLOC;
+	}
+
+	// Each section may be preceded by padding, as may the section header table.
+	file_vector = malloc(sizeof(struct iovec) * ((elf_header->e_shnum * 2) + 3));
+	if(!file_vector) {
+		fprintf(stderr, "Error allocating output file vector\n");
+		status = ASSEMBLER_ERROR_BAD_ALLOC;
+
+		goto FAIL_FREE_PADDING;
+	}
+
+	file_vector[n_file_vector].iov_base = (void*)elf_header;
+	file_vector[n_file_vector].iov_len = sizeof(Elf32_Ehdr);
+	file_offset += sizeof(Elf32_Ehdr);
+	n_file_vector++;
+
+	curr_section = sections;
+	while(curr_section) {
+		// Sections without data occupy no space in the file.
+		if(section_has_file_data(curr_section) && curr_section->size > 0) {
+			if(curr_section->file_offset > file_offset) {
+				file_vector[n_file_vector].iov_base = padding;
+				file_vector[n_file_vector].iov_len = curr_section->file_offset - file_offset;
+				n_file_vector++;
+			}
+
+			file_vector[n_file_vector].iov_base = curr_section->data;
+			file_vector[n_file_vector].iov_len = curr_section->size;
+			file_offset = curr_section->file_offset + curr_section->size;
+			n_file_vector++;
+		}
 
 		curr_section = curr_section->next;
 	}
 
-#if DEBUG_ASSEMBLER == 1
-	printf("Debug Assembler: Cleaning up main program.\n");
-#endif
+	if(elf_header->e_shoff > file_offset) {
+		file_vector[n_file_vector].iov_base = padding;
+		file_vector[n_file_vector].iov_len = elf_header->e_shoff - file_offset;
+		n_file_vector++;
+	}
 
-#if DEBUG_ASSEMBLER == 1
-	printf("Debug Assembler: Freeing statements...\n");
-#endif
+	file_vector[n_file_vector].iov_base = (void*)section_headers;
+	file_vector[n_file_vector].iov_len = sizeof(Elf32_Shdr) * elf_header->e_shnum;
+	n_file_vector++;
 
-	free_statement(program_statements);
+	out_file = open(output_filename, O_WRONLY | O_CREAT | O_TRUNC, 0666);
+	if(out_file == -1) {
+		fprintf(stderr, "Error opening output file: `%u`\n", errno);
+		status = ASSEMBLER_ERROR_FILE_FAILURE;
 
-	free(elf_header);
+		goto FAIL_FREE_FILE_VECTOR;
+	}
 
-#if DEBUG_ASSEMBLER == 1
-	printf("Debug Assembler: Closing output file...\n");
-#endif
+	while(curr_file_vector < n_file_vector) {
+		// `writev` accepts a limited number of entries, and may write fewer
+		// bytes than requested. Continue from wherever the last call stopped.
+		bytes_written = writev(out_file, file_vector + curr_file_vector,
+			(n_file_vector - curr_file_vector) > OUTPUT_IOV_MAX ?
+				OUTPUT_IOV_MAX : (int)(n_file_vector - curr_file_vector));
+		if(bytes_written == -1) {
+			if(errno == EINTR) {
+				continue;
+			}
 
-	fclose(out_file);
+			fprintf(stderr, "Error writing output file: `%u`.\n", errno);
+			status = ASSEMBLER_ERROR_FILE_FAILURE;
 
-#if DEBUG_ASSEMBLER == 1
-	printf("Debug Assembler: Freeing Symbol Table...\n");
-#endif
+			goto FAIL_CLOSE_OUTPUT_FILE;
+		}
 
-	free_symbol_table(&symbol_table);
+		while(curr_file_vector < n_file_vector &&
+			(size_t)bytes_written >= file_vector[curr_file_vector].iov_len) {
+			bytes_written -= file_vector[curr_file_vector].iov_len;
+			curr_file_vector++;
+		}
 
-#if DEBUG_ASSEMBLER == 1
-	printf("Debug Assembler: Freeing sections...\n");
-#endif
+		if(curr_file_vector < n_file_vector) {
+			file_vector[curr_file_vector].iov_base =
+				(uint8_t*)file_vector[curr_file_vector].iov_base + bytes_written;
+			file_vector[curr_file_vector].iov_len -= bytes_written;
+		}
+	}
 
-	free_section(sections);
+	if(close(out_file) == -1) {
+		fprintf(stderr, "Error closing output file: `%u`.\n", errno);
+		status = ASSEMBLER_ERROR_FILE_FAILURE;
+	}
 
-#if DEBUG_ASSEMBLER == 1
-	printf("Debug Assembler: Finished.\n");
-#endif
+	free(file_vector);
+	free(padding);
 
-	return ASSEMBLER_STATUS_SUCCESS;
+	return status;
 
 FAIL_CLOSE_OUTPUT_FILE:
-	free(elf_header);
-	fclose(out_file);
-FAIL_FREE_SECTIONS:
-	free_section(sections);
-FAIL_FREE_SYMBOL_TABLE:
-	free_symbol_table(&symbol_table);
-FAIL_FREE_STATEMENTS:
-	free_statement(program_statements);
+	close(out_file);
+FAIL_FREE_FILE_VECTOR:
+	free(file_vector);
+FAIL_FREE_PADDING:
+	free(padding);
 
-	return process_status;
+	return status;
 }
 
 
@@ -763,93 +1459,64 @@ FAIL_FREE_STATEMENTS:
 static Assembler_Status populate_relocation_entries(Symbol_Table* symtab,
 	Section* sections)
 {
-	/** Used for tracking the result of adding the entity to a section. */
-	Encoding_Entity* added_entity = NULL;
+	/** The status of writing each relocation entry. */
+	Assembler_Status status = ASSEMBLER_STATUS_SUCCESS;
 	/** Pointer to the current section being parsed. */
 	Section *curr_section = sections;
 
 	while(curr_section) {
-		Encoding_Entity* curr_entity = curr_section->encoding_entities;
-		while(curr_entity) {
-			if(curr_entity->n_reloc_entries > 0) {
-				// If the current entity has relocation entries.
-				// First we find the relocation section relevant to the section
-				// that contains this entity.
-				// Search for the section by concatenating `.rel` with the section name.
-				size_t curr_section_name_len = strlen(curr_section->name);
-				char* curr_section_rel_name = malloc(5 + curr_section_name_len);
-				if(!curr_section_rel_name) {
-					fprintf(stderr, "Unable to allocate space for reloc section name.\n");
-					return ASSEMBLER_ERROR_BAD_ALLOC;
-				}
-
-				strncpy(curr_section_rel_name, ".rel", 4);
-				strncpy(curr_section_rel_name + 4, curr_section->name, curr_section_name_len);
-				curr_section_rel_name[curr_section_name_len + 4] = '\0';
-
-				/** The section to add the reloc entry to. */
-				Section* curr_section_rel = find_section(sections, curr_section_rel_name);
-				if(!curr_section_rel) {
-					fprintf(stderr, "Unable to find relocatable entry section: `%s`.\n",
-						curr_section_rel_name);
-					return ASSEMBLER_ERROR_MISSING_SECTION;
-				}
-
-				// Free the created string we used for searching.
-				free(curr_section_rel_name);
-
-				for(size_t r=0; r<curr_entity->n_reloc_entries; r++) {
-					// Create the ELF relocatione entry to encode in the file.
-					Elf32_Rel* rel = malloc(sizeof(Elf32_Rel));
-					if(!rel) {
-						fprintf(stderr, "Unable to allocate space for reloc entry.\n");
-						return ASSEMBLER_ERROR_BAD_ALLOC;
-					}
-
-					/** The index of the relevant symbol into the symbol table. */
-					ssize_t symbol_index = symtab_find_symbol_index(symtab,
-						curr_entity->reloc_entries[r].symbol_name);
-					if(symbol_index == -1) {
-						// cleanup.
-						free(rel);
-
-						fprintf(stderr, "Unable to find symbol index for: `%s`.\n",
-							curr_entity->reloc_entries[r].symbol_name);
-						return ASSEMBLER_ERROR_MISSING_SYMBOL;
-					}
-
-					// The `info` field is encoded as the symbol index shifted right 8
-					// bits, OR'd with the symbol `type`.
-					rel->r_info = (symbol_index << 8) | curr_entity->reloc_entries[r].type;
-					rel->r_offset = curr_entity->reloc_entries[r].offset;
+		if(curr_section->n_reloc_entries > 0) {
+			// If the current section has relocation entries.
+			// First we find the relocation section relevant to this section.
+			// Search for the section by concatenating `.rel` with the section name.
+			size_t curr_section_name_len = strlen(curr_section->name);
+			char* curr_section_rel_name = malloc(5 + curr_section_name_len);
+			if(!curr_section_rel_name) {
+				fprintf(stderr, "Unable to allocate space for reloc section name.\n");
+				return ASSEMBLER_ERROR_BAD_ALLOC;
+			}
 
-					/** The encoding entity that encodes the relocation entry. */
-					Encoding_Entity* reloc_entity = malloc(sizeof(Encoding_Entity));
-					if(!reloc_entity) {
-						// cleanup.
-						free(rel);
+			strncpy(curr_section_rel_name, ".rel", 4);
+			strncpy(curr_section_rel_name + 4, curr_section->name, curr_section_name_len);
+			curr_section_rel_name[curr_section_name_len + 4] = '\0';
 
-						fprintf(stderr, "Unable to allocate space for reloc entry encoding entity.\n");
-						return ASSEMBLER_ERROR_BAD_ALLOC;
-					}
+			/** The section to add the reloc entry to. */
+			Section* curr_section_rel = find_section(sections, curr_section_rel_name);
+			if(!curr_section_rel) {
+				fprintf(stderr, "Unable to find relocatable entry section: `%s`.\n",
+					curr_section_rel_name);
+				return ASSEMBLER_ERROR_MISSING_SECTION;
+			}
 
-					reloc_entity->n_reloc_entries = 0;
-					reloc_entity->reloc_entries = NULL;
+			// Free the created string we used for searching.
+			free(curr_section_rel_name);
+
+			for(size_t r=0; r<curr_section->n_reloc_entries; r++) {
+				// Create the ELF relocatione entry to encode in the file.
+				Elf32_Rel rel;
+
+				/** The index of the relevant symbol into the symbol table. */
+				ssize_t symbol_index = symtab_find_symbol_index(symtab,
+					curr_section->reloc_entries[r].symbol_name);
+				if(symbol_index == -1) {
+					fprintf(stderr, "Unable to find symbol index for: `%s`.\n",
+						string_pool_get(symtab->string_pool,
+							curr_section->reloc_entries[r].symbol_name));
+					return ASSEMBLER_ERROR_MISSING_SYMBOL;
+				}
 
-					reloc_entity->size = sizeof(Elf32_Rel);
-					reloc_entity->data = (uint8_t*)rel;
-					reloc_entity->next = NULL;
+				// The `info` field is encoded as the symbol index shifted right 8
+				// bits, OR'd with the symbol `type`.
+				rel.r_info = (symbol_index << 8) | curr_section->reloc_entries[r].type;
+				rel.r_offset = curr_section->reloc_entries[r].offset;
 
-					// Add the relocatable entry to the relevant section.
-					added_entity = section_add_encoding_entity(curr_section_rel, reloc_entity);
-					if(!added_entity) {
-						// Error message should already have been set.
-						return ASSEMBLER_ERROR_SECTION_ENTITY_FAILURE;
-					}
+				// Add the relocatable entry to the relevant section.
+				status = section_write(curr_section_rel, &rel, sizeof(Elf32_Rel));
+				if(!get_status(status)) {
+					// Error message printed in callee.
+					return status;
 				}
 			}
-
-			curr_entity = curr_entity->next;
 		}
 
 		curr_section = curr_section->next;
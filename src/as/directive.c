@@ -14,21 +14,6 @@
 #include <statement.h>
 
 
-/**
- * free_directive
- */
-void free_directive(Directive* directive)
-{
-	if(!directive) {
-		fprintf(stderr, "Invalid directive provided to free function.\n");
-
-		return;
-	}
-
-	free_operand_sequence(&directive->opseq);
-}
-
-
 /**
  * get_directive_string
  */
@@ -0,0 +1,119 @@
+/**
+ * @file arena.h
+ * @author Anthony (ajxs [at] panoptic.online)
+ * @brief Arena allocator header.
+ * Contains the arena allocator definitions and functions. The arena owns every
+ * object whose lifetime is that of a single assembly, such as statements,
+ * operands and encoding entities, so that they can all be released at once.
+ * @version 0.1
+ * @date 2019-03-09
+ */
+
+#ifndef ARENA_H
+#define ARENA_H 1
+
+#include <stddef.h>
+#include <stdint.h>
+
+
+/**
+ * @brief Arena block type.
+ * A single contiguous block of memory that allocations are made from. Blocks
+ * are never moved or resized, so allocations remain valid until the arena is
+ * freed.
+ */
+typedef struct arena_block {
+	struct arena_block* next;
+	size_t size;
+	size_t used;
+	_Alignas(max_align_t) uint8_t data[];
+} Arena_Block;
+
+/**
+ * @brief Arena type.
+ * A bump allocator. Allocations are made from the first block in the list until
+ * it is exhausted, at which point a new block is added to the front of the list.
+ * Counters of the allocations made are kept, so that the arena's usage can be
+ * compared with individually allocating each object.
+ */
+typedef struct {
+	Arena_Block* blocks;
+	size_t n_blocks;
+	size_t n_allocations;
+	size_t n_bytes_allocated;
+	size_t n_bytes_reserved;
+} Arena;
+
+#include <as.h>
+
+
+/**
+ * @brief Initialises an arena.
+ *
+ * Initialises an arena, allocating its first block.
+ * @param arena A pointer to the arena to initialise.
+ * @return A status entity indicating whether or not initialisation was
+ * successful.
+ * @warning The arena must be freed with `free_arena`.
+ */
+Assembler_Status initialise_arena(Arena* arena);
+
+/**
+ * @brief Allocates memory from an arena.
+ *
+ * Allocates memory from an arena. The memory is suitably aligned for any type,
+ * and is not initialised.
+ * @param arena A pointer to the arena to allocate from.
+ * @param size The number of bytes to allocate.
+ * @return A pointer to the allocated memory, or NULL if an error occurred.
+ */
+void* arena_alloc(Arena* arena,
+	const size_t size);
+
+/**
+ * @brief Resizes memory allocated from an arena.
+ *
+ * Resizes an allocation made from an arena. If the allocation is the most
+ * recent one made from the arena it is resized in place where possible,
+ * otherwise a new allocation is made and the contents are copied to it.
+ * @param arena A pointer to the arena the memory was allocated from.
+ * @param ptr A pointer to the allocation to resize. If this is NULL a new
+ * allocation is made.
+ * @param size The current size of the allocation.
+ * @param new_size The requested size of the allocation.
+ * @return A pointer to the resized allocation, or NULL if an error occurred.
+ */
+void* arena_realloc(Arena* arena,
+	void* ptr,
+	const size_t size,
+	const size_t new_size);
+
+/**
+ * @brief Copies a string into an arena.
+ *
+ * Copies at most @p length characters of a string into an arena, adding a NUL
+ * terminator.
+ * @param arena A pointer to the arena to allocate from.
+ * @param string The string to copy.
+ * @param length The maximum number of characters to copy.
+ * @return A pointer to the copied string, or NULL if an error occurred.
+ */
+char* arena_strndup(Arena* arena,
+	const char* string,
+	const size_t length);
+
+/**
+ * @brief Prints an arena's allocation counters to the trace output.
+ * @param arena A pointer to the arena to print.
+ */
+void print_arena_statistics(const Arena* arena);
+
+/**
+ * @brief Frees an arena.
+ *
+ * Frees an arena, releasing every allocation made from it.
+ * @param arena A pointer to the arena to free.
+ */
+void free_arena(Arena* arena);
+
+#endif
@@ -45,41 +45,59 @@ typedef enum e_assembler_status {
 } Assembler_Status;
 
 
+#include <arena.h>
 #include <elf.h>
-#include <encoding_entity.h>
 #include <statement.h>
 #include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <section.h>
+#include <stats.h>
 #include <symtab.h>
 
 
-// These control whether or not debug information specific to certain processes
-// is printed to STDOUT.
-#define DEBUG_ASSEMBLER 1
-#define DEBUG_CODEGEN 1
-#define DEBUG_INPUT 1
-#define DEBUG_MACRO 1
-#define DEBUG_OUTPUT 1
-#define DEBUG_PARSED_STATEMENTS 1
-#define DEBUG_PREPROCESSOR 0
-#define DEBUG_SYMBOLS 1
-
-
 /**
  * @brief The main assembler entry point.
  *
  * This function begins the assembly process for an input source file.
  * All processing and assembly is initiated here.
+ * This function keeps no shared state, so separate files can be assembled
+ * concurrently.
  * @param input_filename The file path for the input source file.
  * @param output_filename The file path for the output source file.
+ * @param n_jobs The maximum number of jobs used to encode the program.
+ * @param stats The statistics recorded for the file. If this is NULL, no
+ * statistics are recorded.
  * @return A status code indicating the success status of the operation
 */
 Assembler_Status assemble(const char* input_filename,
 	const char* output_filename,
-	const bool verbose);
+	const size_t n_jobs,
+	Assembly_Stats* stats);
+
+/**
+ * @brief Assembles multiple input files concurrently.
+ *
+ * This function assembles each input file into its corresponding output file.
+ * The files are assembled concurrently by a pool of up to @p n_jobs threads.
+ * Any jobs remaining once there is a thread for each file are used to encode
+ * the statements of each file.
+ * @param input_filenames The file paths of the input source files.
+ * @param output_filenames The file paths of the output files. Contains one
+ * path for each input file.
+ * @param n_files The number of input files.
+ * @param n_jobs The maximum number of jobs used to assemble the files.
+ * @param stats The statistics recorded for each file. Contains one entry for
+ * each input file. If this is NULL, no statistics are recorded.
+ * @return A status code indicating the success status of the operation. If any
+ * file fails to assemble, this is the status of the first failed file.
+ */
+Assembler_Status assemble_files(const char* const* input_filenames,
+	const char* const* output_filenames,
+	const size_t n_files,
+	const size_t n_jobs,
+	Assembly_Stats* stats);
 
 /**
  * @brief Creates the ELF file header.
@@ -97,19 +115,18 @@ Assembler_Status create_elf_header(Elf32_Ehdr** elf_header);
  * This function encodes an ELF section header from an application
  * section entity.
  * @param section A pointer to the application section entity.
- * @param section_header A pointer-to-pointer to the section header to be
- * created.
+ * @param section_header A pointer to the section header to be encoded.
  * @return The status of process.
  */
 Assembler_Status encode_section_header(const Section* section,
-	Elf32_Shdr** section_header);
+	Elf32_Shdr* section_header);
 
 /**
  * @brief Encodes a Directive entity.
  *
- * Encodes an Directive entity, creating an `Encoding_Entity` instance representing
- * the generated machine code entities to be written into the executable.
- * @param encoded_directive A pointer-to-pointer to the resulting encoded deirective.
+ * Encodes an Directive entity, writing the generated data to the end of the
+ * section's data.
+ * @param section The section that the directive is encoded in.
  * @param symtab The symbol table. This is scanned to find any symbols referenced
  * in instruction operands.
  * @param instruction The parsed instruction entity to encode.
@@ -118,7 +135,7 @@ Assembler_Status encode_section_header(const Section* section,
  * current program section.
  * @return The status of the operation.
  */
-Assembler_Status encode_directive(Encoding_Entity** encoded_directive,
+Assembler_Status encode_directive(Section* section,
 	const Symbol_Table* symtab,
 	const Directive* directive,
 	const size_t program_counter);
@@ -126,9 +143,10 @@ Assembler_Status encode_directive(Encoding_Entity** encoded_directive,
 /**
  * @brief Encodes an Instruction entity.
  *
- * Encodes an instruction entity, creating an `Encoding_Entity` instance representing
- * the generated machine code entities to be written into the executable.
- * @param encoded_directive A pointer-to-pointer to the resulting encoded deirective.
+ * Encodes an instruction entity, writing the generated machine code to the end
+ * of the section's data. Any relocation entries required are added to the
+ * section.
+ * @param section The section that the instruction is encoded in.
  * @param symtab The symbol table. This is scanned to find any symbols referenced
  * in instruction operands.
  * @param instruction The parsed instruction entity to encode.
@@ -137,7 +155,7 @@ Assembler_Status encode_directive(Encoding_Entity** encoded_directive,
  * current program section.
  * @return The status of the operation.
  */
-Assembler_Status encode_instruction(Encoding_Entity** encoded_instruction,
+Assembler_Status encode_instruction(Section* section,
 	const Symbol_Table* symbol_table,
 	const Instruction* instruction,
 	const size_t program_counter);
@@ -151,20 +169,23 @@ Assembler_Status encode_instruction(Encoding_Entity** encoded_instruction,
  * potentially appending further statements to it. This is accomplished by adding
  * a new link to the `statements` linked list.
  * @param statements The linked list of parsed statements.
+ * @param arena The arena that any added statements are allocated from.
  * @returns The result of the operation.
  * @warning @p statements is modified by this function.
  */
-Assembler_Status expand_macros(Statement* statements);
+Assembler_Status expand_macros(Statement* statements,
+	Arena* arena);
 
 /**
  * @brief Gets a string representation of an encoded instruction.
  * 
  * This function creates a string representation of an encoded instruction. Used for
  * debugging purposes.
- * @param encoded_instruction The instruction to get the representation of.
+ * @param encoded_instruction The encoded instruction data to get the
+ * representation of.
  * @returns A string literal containing the representation.
  */
-char* get_encoding_as_string(const Encoding_Entity* encoded_instruction);
+char* get_encoding_as_string(const uint8_t* encoded_instruction);
 
 /**
  * @brief tests a result status for success.
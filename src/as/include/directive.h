@@ -44,14 +44,6 @@ typedef struct {
 	Operand_Sequence opseq;
 } Directive;
 
-/**
- * @brief Frees a directive.
- *
- * Frees a directive and the operands that it contains.
- * @param directive The directive to free.
- */
-void free_directive(Directive* directive);
-
 /**
  * @brief Gets the string representation of a directive type.
  *
@@ -70,11 +62,13 @@ const char* get_directive_string(const Directive* directive);
 Directive_Type parse_directive_symbol(const char* directive_symbol);
 
 /**
- * @brief Prints a directive.
+ * @brief Prints a directive to the trace output.
  *
  * This function prints information about a directive entity.
  * @param dir The directive to print.
+ * @param string_pool The string pool containing any symbol names.
  */
-void print_directive(const Directive* directive);
+void print_directive(const Directive* directive,
+	const String_Pool* string_pool);
 
 #endif
@@ -12,28 +12,26 @@
 
 
 /**
- * @brief Preprocesses a line of input source.
+ * @brief Lexes and parses an entire input buffer.
  *
- * Preprocesses a line of input source, normalising it to ease parsing of the text.
- * All leading whitespace is removed, all mid-line whitespace is collapsed to a
- * single space character.
- * @param line_buffer The line to process.
- * @return The processed line.
- * @warning The returned line is allocated in this function, and must be freed
- * by the caller.
+ * This is the entry point to lexing and parsing a complete source buffer in a
+ * single pass. The buffer is scanned in place, without being copied. Line numbers
+ * are tracked by the scanner, and recorded in each parsed statement.
+ * @param buffer The buffer containing the source to lex/parse. The two bytes
+ * following the end of the source must be present and set to NUL.
+ * @param buffer_size The size of the source in the buffer, excluding the two
+ * trailing NUL bytes.
+ * @param arena The arena that parsed statements are allocated from.
+ * @param string_pool The string pool that symbol names are interned in.
+ * @param statements The list that parsed statements are appended to.
+ * @return A status entity indicating whether or not parsing was successful.
+ * @warning The contents of @p buffer are modified while it is being scanned.
  */
-Assembler_Status preprocess_line(const char* line_buffer,
-	char** output);
-
-/**
- * @brief Entry point to parsing an input line.
- *
- * This is the entry point to lexing and parsing an individual line of input. This
- * function invokes the code created from Flex/Bison.
- * @param str The string to lex/parse
- * @return A linked list of parsed statements.
- */
-Statement* scan_string(const char* str);
+Assembler_Status scan_buffer(char* buffer,
+	const size_t buffer_size,
+	Arena* arena,
+	String_Pool* string_pool,
+	Statement_List* statements);
 
 /**
  * @brief Reads the source file input.
@@ -41,12 +39,23 @@ Statement* scan_string(const char* str);
  * This function reads the assembly source file, lexes and parses each individual
  * statement. After all of the individual statements in the file have been parsed
  * these are passed to the two stage assembler.
+ * The entire input is scanned as a single buffer. Regular files are mapped into
+ * memory and scanned in place, input that cannot be mapped, such as pipes, is
+ * read into memory first.
  * The file handle is closed in the main function.
  * @param input_file The file pointer for the input source file.
+ * @param arena The arena that parsed statements are allocated from.
+ * @param string_pool The string pool that symbol names are interned in.
  * @param program_statements A pointer-to-pointer to the statement list.
+ * @param stats The statistics recorded for the file. The reading and parsing
+ * of the input are timed separately. If this is NULL, no statistics are
+ * recorded.
  * @return A status entity indicating whether or not the pass was successful.
  */
 Assembler_Status read_input(FILE* input_file,
-	Statement** program_statements);
+	Arena* arena,
+	String_Pool* string_pool,
+	Statement** program_statements,
+	Assembly_Stats* stats);
 
 #endif
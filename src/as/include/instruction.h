@@ -27,20 +27,14 @@ typedef struct {
 
 
 /**
- * @brief Frees an instruction.
- *
- * Frees an instruction and the operands that it contains.
- * @param instruction The instruction to free.
- */
-void free_instruction(Instruction* instruction);
-
-/**
- * @brief Prints an instruction.
+ * @brief Prints an instruction to the trace output.
  *
  * This function prints information about an instruction entity.
  * @param instruction The instruction to print.
+ * @param string_pool The string pool containing any symbol names.
  */
-void print_instruction(const Instruction* instruction);
+void print_instruction(const Instruction* instruction,
+	const String_Pool* string_pool);
 
 /**
  * @brief Gets a representation of the provided opcode in string form.
@@ -13,6 +13,7 @@
 #include <arch.h>
 #include <stdbool.h>
 #include <stddef.h>
+#include <string_pool.h>
 
 
 /**
@@ -53,7 +54,7 @@ typedef struct {
 	uint16_t offset;
 	union {
 		char* string_literal;
-		char* symbol;
+		String_Id symbol;
 		uint32_t numeric_literal;
 		Register reg;
 	};
@@ -82,36 +83,23 @@ bool check_operand_count(const size_t expected_operand_length,
 	const Operand_Sequence* opseq);
 
 /**
- * @brief Frees an operand pointer.
- *
- * Frees an operand pointer. Checks if the operand type is dynamically allocated,
- * freeing it if necessary.
- * @param op A pointer to the operand to free.
- */
-void free_operand(Operand* op);
-
-/**
- * @brief Frees an operand sequence.
- *
- * Frees a sequence of operands,
- * @param opseq A pointer to the operand sequence to free.
- */
-void free_operand_sequence(Operand_Sequence* opseq);
-
-/**
- * @brief Prints an instruction operand.
+ * @brief Prints an instruction operand to the trace output.
  *
  * This function prints information about an instruction operand.
  * @param op The operand to print information about.
+ * @param string_pool The string pool containing any symbol names.
  */
-void print_operand(const Operand* op);
+void print_operand(const Operand* op,
+	const String_Pool* string_pool);
 
 /**
- * @brief Prints an operand sequence.
+ * @brief Prints an operand sequence to the trace output.
  *
  * This function prints an operand sequence entity, printing each operand.
  * @param opseq The operand sequence to print.
+ * @param string_pool The string pool containing any symbol names.
  */
-void print_operand_sequence(const Operand_Sequence* opseq);
+void print_operand_sequence(const Operand_Sequence* opseq,
+	const String_Pool* string_pool);
 
 #endif
@@ -10,16 +10,40 @@
 #ifndef PARSING_H
 #define PARSING_H 1
 
+#include <stddef.h>
 #include <stdint.h>
+#include <arena.h>
 #include <as.h>
 #include <directive.h>
 #include <instruction.h>
 #include <operand.h>
 #include <statement.h>
+#include <string_pool.h>
+
+
+// The type of a reentrant flex scanner instance. This matches the definition
+// generated by flex, so that the parser can be declared without the lexer.
+#ifndef YY_TYPEDEF_YY_SCANNER_T
+#define YY_TYPEDEF_YY_SCANNER_T
+typedef void* yyscan_t;
+#endif
+
+
+/**
+ * @brief The state of a single scan of an input file.
+ * This is attached to the scanner as its extra data, so that each scan is
+ * independent and files can be scanned concurrently.
+ */
+typedef struct {
+	Arena* arena;
+	String_Pool* string_pool;
+	size_t n_errors;
+} Lexer_State;
 
 
 union YYSTYPE {
 	char* text;
+	String_Id id;
 	uint32_t imm;
 	Register reg;
 	Operand_Mask mask;
@@ -36,20 +60,33 @@ union YYSTYPE {
  * @brief Parses the string representation of a register.
  *
  * This function parses the string representation of a register operand.
+ * The string must consist of the register prefix followed exactly by either a
+ * register number from `0` to `31`, or a register ABI name, ignoring case.
  * @param register_symbol The register string to parse.
- * @return The matching register.
+ * @return The matching register, or `REGISTER_NONE` if the string does not
+ * name a register.
  */
 Register parse_register_symbol(const char* register_symbol);
 
 /**
  * @brief Parses a string containing an opcode.
  *
- * This function parses a string to find what opcode it corresponds to. In the
- * event that no recognised opcode can be found an `UNKNOWN_OPCODE` result is
+ * This function parses a string to find what opcode it corresponds to. The
+ * string must exactly match an opcode mnemonic, ignoring case. In the event
+ * that no recognised opcode can be found an `UNKNOWN_OPCODE` result is
  * returned.
  * @param opcode_symbol The C-string containing the opcode value.
  * @return The parsed opcode value.
  */
 Opcode parse_opcode_symbol(const char* opcode_symbol);
 
+/**
+ * @brief Gets the state attached to a scanner.
+ *
+ * This function is generated by flex.
+ * @param scanner The scanner to get the state of.
+ * @return The scanner's state.
+ */
+Lexer_State* yyget_extra(yyscan_t scanner);
+
 #endif
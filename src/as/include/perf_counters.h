@@ -0,0 +1,101 @@
+/**
+ * @file perf_counters.h
+ * @author Anthony (ajxs [at] panoptic.online)
+ * @brief Hardware performance counter header.
+ * Contains the definitions and functions for counting hardware events, such as
+ * cycles, instructions, cache misses and branch misses, over a span of work.
+ * Counters are read with `perf_event_open`, and are simply not counted where
+ * the kernel or the hardware does not allow it.
+ * @version 0.1
+ * @date 2019-03-09
+ */
+
+#ifndef PERF_COUNTERS_H
+#define PERF_COUNTERS_H 1
+
+#include <stdbool.h>
+#include <stdint.h>
+
+
+/**
+ * @brief Performance counter type.
+ * Each hardware event that is counted.
+ */
+typedef enum {
+	PERF_COUNTER_CYCLES,
+	PERF_COUNTER_INSTRUCTIONS,
+	PERF_COUNTER_CACHE_REFERENCES,
+	PERF_COUNTER_CACHE_MISSES,
+	PERF_COUNTER_BRANCHES,
+	PERF_COUNTER_BRANCH_MISSES,
+	PERF_COUNTER_COUNT
+} Perf_Counter;
+
+/**
+ * @brief Performance counter group type.
+ * The open counters of a single span of work. A counter which could not be
+ * opened has a file descriptor of -1.
+ */
+typedef struct {
+	int fds[PERF_COUNTER_COUNT];
+} Perf_Counter_Group;
+
+/**
+ * @brief Performance counts type.
+ * The events counted over one or more spans. Only the counters whose bit is
+ * set in `counted` were counted.
+ */
+typedef struct {
+	uint64_t counts[PERF_COUNTER_COUNT];
+	uint32_t counted;
+} Perf_Counts;
+
+#include <as.h>
+
+
+/**
+ * Whether performance counters are counted. This is only modified before
+ * assembly begins.
+ */
+extern bool perf_counters_enabled;
+
+
+/**
+ * @brief Enables the performance counters.
+ *
+ * Tests which counters the kernel allows to be opened, and enables those that
+ * can be. A warning is printed for any counters that are unavailable.
+ * @return A status entity indicating whether any counters were enabled.
+ */
+Assembler_Status perf_counters_enable(void);
+
+/**
+ * @brief Begins counting.
+ *
+ * Opens and starts each enabled counter for the calling thread, and any threads
+ * it creates. Nothing is counted unless the counters are enabled.
+ * @param group The counter group to open.
+ */
+void perf_counters_begin(Perf_Counter_Group* group);
+
+/**
+ * @brief Ends counting.
+ *
+ * Adds the events counted since the group was opened to the totals, then
+ * closes the group. Counts are scaled to account for the time each counter was
+ * multiplexed with other events. Any threads created since the group was opened
+ * must have exited for their events to be counted.
+ * @param group The counter group opened at the beginning of the span.
+ * @param counts The totals to add the counted events to.
+ */
+void perf_counters_end(Perf_Counter_Group* group,
+	Perf_Counts* counts);
+
+/**
+ * @brief Gets the name of a performance counter.
+ * @param counter The counter.
+ * @return The counter's name.
+ */
+const char* perf_counter_name(const Perf_Counter counter);
+
+#endif
@@ -0,0 +1,68 @@
+/**
+ * @file scan.h
+ * @author Anthony (ajxs [at] panoptic.online)
+ * @brief Character scanning header.
+ * Contains functions for quickly scanning source text for characters that are
+ * significant to the lexer, so that runs of blanks and comments can be skipped
+ * many characters at a time.
+ * @version 0.1
+ * @date 2019-03-09
+ */
+
+#ifndef SCAN_H
+#define SCAN_H 1
+
+
+/**
+ * @brief Skips over blank characters.
+ *
+ * Finds the first character in a buffer which is not a space or tab character.
+ * Where supported, this is vectorised and processes 16 or 32 bytes at a time.
+ * The implementation is selected at load time according to the features of
+ * the host CPU.
+ * @param start A pointer to the start of the buffer to scan.
+ * @param end A pointer to the end of the buffer to scan.
+ * @return A pointer to the first non-blank character, or @p end if there is none.
+ */
+const char* scan_skip_blank(const char* start,
+	const char* end);
+
+/**
+ * @brief Finds the next newline character.
+ *
+ * Finds the end of the line containing the start of a buffer, such as the end
+ * of a comment. Where supported, this is vectorised and processes 16 or 32
+ * bytes at a time. The implementation is selected at load time according to
+ * the features of the host CPU.
+ * @param start A pointer to the start of the buffer to scan.
+ * @param end A pointer to the end of the buffer to scan.
+ * @return A pointer to the first newline character, or @p end if there is none.
+ */
+const char* scan_find_newline(const char* start,
+	const char* end);
+
+/**
+ * @brief Skips over blank characters one byte at a time.
+ *
+ * The scalar implementation of `scan_skip_blank`. Used as the fallback where
+ * vector instructions are not available, and as a reference implementation.
+ * @param start A pointer to the start of the buffer to scan.
+ * @param end A pointer to the end of the buffer to scan.
+ * @return A pointer to the first non-blank character, or @p end if there is none.
+ */
+const char* scan_skip_blank_scalar(const char* start,
+	const char* end);
+
+/**
+ * @brief Finds the next newline character one byte at a time.
+ *
+ * The scalar implementation of `scan_find_newline`. Used as the fallback where
+ * vector instructions are not available, and as a reference implementation.
+ * @param start A pointer to the start of the buffer to scan.
+ * @param end A pointer to the end of the buffer to scan.
+ * @return A pointer to the first newline character, or @p end if there is none.
+ */
+const char* scan_find_newline_scalar(const char* start,
+	const char* end);
+
+#endif
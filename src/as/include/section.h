@@ -11,14 +11,34 @@
 #define SECTION_H 1
 
 #include <as.h>
-#include <encoding_entity.h>
+#include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
 #include <stdio.h>
+#include <string_pool.h>
 
 
+/**
+ * @brief Relocation entry type.
+ * Records a reference to a symbol from a location in a section, which must be
+ * resolved when the program is linked.
+ */
+typedef struct {
+	String_Id symbol_name;
+	size_t offset;
+	uint32_t type;
+} Reloc_Entry;
+
 /**
  * @brief Section type.
  * Represents a file section.
+ * The encoded section data is stored in a single contiguous buffer, which is
+ * grown as data is written to it. Any relocation entries generated for the
+ * section's data are stored alongside it.
+ * The section's place in the output file is assigned by `layout_sections`,
+ * and is aligned to the section's alignment.
+ * A section with a parent is a window onto a fixed range of its parent's data,
+ * created by `section_window`.
  */
 typedef struct _section {
 	const char* name;
@@ -27,10 +47,17 @@ typedef struct _section {
 	size_t program_counter;
 	uint32_t type;
 	uint32_t flags;
+	size_t alignment;
+	size_t entry_size;
 	size_t size;
+	size_t capacity;
+	uint8_t* data;
+	size_t n_reloc_entries;
+	size_t reloc_entries_capacity;
+	Reloc_Entry* reloc_entries;
 	size_t info;
 	size_t link;
-	Encoding_Entity* encoding_entities;
+	const struct _section* parent;
 	struct _section* next;
 } Section;
 
@@ -38,7 +65,8 @@ typedef struct _section {
 /**
  * @brief Creates a section.
  *
- * Creates a section program entity.
+ * Creates a section program entity. The section's alignment and entry size are
+ * set according to its type.
  * @param name The name for the newly created section.
  * @param type The type of the newly created section.
  * @param flags The flags for the newly created section.
@@ -84,27 +112,130 @@ ssize_t find_section_index(const Section* section_list,
 	const char* name);
 
 /**
- * @brief Adds an encoded entity to a section.
+ * @brief Reserves space for a section's data.
+ *
+ * Ensures that a section's data buffer can hold at least @p capacity bytes
+ * without being resized.
+ * @param section A pointer to the section.
+ * @param capacity The number of bytes to reserve.
+ * @return A status entity indicating whether or not the space was able to be
+ * reserved.
+ */
+Assembler_Status section_reserve(Section* section,
+	const size_t capacity);
+
+/**
+ * @brief Appends space to a section's data.
+ *
+ * Extends a section's data by @p size bytes, growing its buffer if necessary,
+ * and returns a pointer to the new space so that it can be encoded in place.
+ * @param section A pointer to the section.
+ * @param size The number of bytes to append.
+ * @return A pointer to the appended space, or NULL if an error occurred. This
+ * is valid until the section's data is next extended.
+ */
+uint8_t* section_append(Section* section,
+	const size_t size);
+
+/**
+ * @brief Writes data to a section.
+ *
+ * Copies data to the end of a section's data.
+ * @param section A pointer to the section.
+ * @param data The data to write.
+ * @param size The size of the data.
+ * @return A status entity indicating whether or not the data was able to be
+ * written.
+ */
+Assembler_Status section_write(Section* section,
+	const void* data,
+	const size_t size);
+
+/**
+ * @brief Adds a relocation entry to a section.
+ *
+ * Records a relocation entry for a location in a section's data.
+ * @param section A pointer to the section.
+ * @param symbol_name The name of the referenced symbol.
+ * @param offset The offset of the relocated data into the section.
+ * @param type The type of the relocation.
+ * @return A status entity indicating whether or not the relocation entry was
+ * able to be added.
+ */
+Assembler_Status section_add_reloc_entry(Section* section,
+	const String_Id symbol_name,
+	const size_t offset,
+	const uint32_t type);
+
+/**
+ * @brief Creates a window onto a range of a section's data.
+ *
+ * Initialises a section entity that encodes data directly into a range of
+ * another section's data, which must already have been reserved. Windows onto
+ * disjoint ranges can be written to concurrently. The window can not be grown
+ * past the end of its range. Relocation entries added to the window are stored
+ * in the window itself.
+ * @param window A pointer to the window to initialise.
+ * @param section A pointer to the section whose data is written to.
+ * @param offset The offset of the start of the range into the section's data.
+ * @param size The size of the range.
+ * @warning The window's relocation entries must be freed with
+ * `free_section_window`.
+ */
+void section_window(Section* window,
+	Section* section,
+	const size_t offset,
+	const size_t size);
+
+/**
+ * @brief Frees a section window.
+ *
+ * Frees the relocation entries of a window created by `section_window`. The
+ * parent section's data is not affected.
+ * @param window A pointer to the window to free.
+ */
+void free_section_window(Section* window);
+
+/**
+ * @brief Aligns a file offset.
+ *
+ * Rounds a file offset up to the next multiple of an alignment.
+ * @param offset The offset to align.
+ * @param alignment The alignment, which must be zero or a power of two. An
+ * alignment of zero or one leaves the offset unchanged.
+ * @return The aligned offset.
+ */
+size_t align_file_offset(const size_t offset,
+	const size_t alignment);
+
+/**
+ * @brief Lays out the sections in the output file.
  *
- * Adds an encoded instruction or directive entity to a program section.
- * The entity will be added to the end of the end of the encoded entities linked
- * list.
- * @param section A pointer to the program section to add the encoded
- * entity to.
- * @param entity The encoded entity to add to the section.
- * @return Returns the added encoding entity or NULL in the case of error.
+ * Assigns each section its offset in the output file. Sections are placed in
+ * list order starting at @p start, with each offset aligned to the section's
+ * alignment. Sections of type `SHT_NOBITS`, and the null section, occupy no
+ * space in the file. The resulting offsets describe disjoint regions of the
+ * file, so the sections' data can be written in any order.
+ * @param sections A pointer to the program section linked list.
+ * @param start The file offset at which the section data begins.
+ * @return The file offset immediately following the last section's data.
+ */
+size_t layout_sections(Section* sections,
+	const size_t start);
+
+/**
+ * @brief Gets whether a section's data occupies space in the output file.
+ * @param section A pointer to the section.
+ * @return Whether the section's data is written to the output file.
  */
-Encoding_Entity* section_add_encoding_entity(Section* section,
-	const Encoding_Entity* entity);
+bool section_has_file_data(const Section* section);
 
 /**
  * @brief Frees a program section.
  *
- * Frees a program section and its contained encoded entities.  This will
- * free all of the encoded entities contained therein.
+ * Frees a program section, its data and relocation entries, and all of the
+ * sections that follow it in the section list.
  * @param section A pointer to the section to be freed.
- * @warning This function will recursively free all encoded instruction and directive
- * entities contained in the section.
  */
 void free_section(Section* section);
 
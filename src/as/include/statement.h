@@ -16,6 +16,7 @@
 #include <operand.h>
 #include <stdbool.h>
 #include <stddef.h>
+#include <string_pool.h>
 
 /**
  * @brief The type of a particular statement.
@@ -29,10 +30,12 @@ typedef enum {
 /**
  * @brief Statement type.
  * Includes the labels that are attached to a particular statement.
+ * Statements, and the labels and operands they contain, are allocated from the
+ * arena of the assembly that they belong to.
  */
 typedef struct statement {
 	size_t n_labels;
-	char** labels;
+	String_Id* labels;
 	Statement_Type type;
 	union {
 		Instruction instruction;
@@ -42,6 +45,17 @@ typedef struct statement {
 	struct statement* next;
 } Statement;
 
+/**
+ * @brief A list of statements.
+ * Tracks the final statement in the list, so that statements can be appended
+ * in constant time.
+ */
+typedef struct {
+	Statement* head;
+	Statement* tail;
+	size_t n_statements;
+} Statement_List;
+
 
 /**
  * @brief Gets the size of a statement entity.
@@ -55,16 +69,23 @@ Assembler_Status get_statement_size(Statement* statement,
 	size_t* statement_size);
 
 /**
- * @brief Frees a statement entity.
+ * @brief Appends a statement to a statement list.
  *
- * This function frees a statement entity, it will also free all statement
- * entities linked to this statement in its list recursively.
- * @param statement The statement entity to free.
- * @warning This function frees all statements in the statement linked list
- * recursively.
+ * Appends a statement to the end of a statement list in constant time.
+ * @param list The list to append the statement to.
+ * @param statement The statement to append.
  */
-void free_statement(Statement* statement);
+void append_statement(Statement_List* list,
+	Statement* statement);
 
-void print_statement(const Statement* statement);
+/**
+ * @brief Prints a statement to the trace output.
+ *
+ * This function prints information about a statement entity.
+ * @param statement The statement to print.
+ * @param string_pool The string pool containing any symbol names.
+ */
+void print_statement(const Statement* statement,
+	const String_Pool* string_pool);
 
 #endif
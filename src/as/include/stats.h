@@ -0,0 +1,232 @@
+/**
+ * @file stats.h
+ * @author Anthony (ajxs [at] panoptic.online)
+ * @brief Assembly statistics header.
+ * Contains the definitions and functions for recording the time and resources
+ * used by each phase of the assembler, and the counts of the entities that it
+ * processes. The phases can also be recorded as trace events, which are
+ * written to a file in the Chrome trace event format, and the hardware events
+ * of each phase can be counted with the performance counters.
+ * @version 0.1
+ * @date 2019-03-09
+ */
+
+#ifndef STATS_H
+#define STATS_H 1
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <time.h>
+#include <perf_counters.h>
+
+
+/**
+ * @brief Assembler phase type.
+ * Each phase of the assembly of a single file.
+ */
+typedef enum {
+	STATS_PHASE_READ,
+	STATS_PHASE_PARSE,
+	STATS_PHASE_EXPAND_MACROS,
+	STATS_PHASE_FIRST_PASS,
+	STATS_PHASE_SECOND_PASS,
+	STATS_PHASE_RELOCATIONS,
+	STATS_PHASE_SYMTAB,
+	STATS_PHASE_OUTPUT,
+	STATS_PHASE_COUNT
+} Stats_Phase;
+
+/**
+ * @brief Statistics report format type.
+ */
+typedef enum {
+	STATS_FORMAT_TEXT,
+	STATS_FORMAT_JSON
+} Stats_Format;
+
+/**
+ * @brief Phase timer type.
+ * Records the clocks at the start of a phase, and holds the performance
+ * counters opened for it.
+ */
+typedef struct {
+	struct timespec wall_time;
+	struct timespec cpu_time;
+	Perf_Counter_Group perf_counters;
+} Stats_Timer;
+
+/**
+ * @brief Phase statistics type.
+ * The time and resources used by a single phase. Times are in seconds. The
+ * CPU time is that of the thread assembling the file, and of any jobs it runs
+ * on other threads, so it excludes any other files being assembled
+ * concurrently. The peak RSS is the process' high-water mark at the
+ * end of the phase, in kilobytes. Hardware events are only counted if the
+ * performance counters are enabled.
+ */
+typedef struct {
+	double wall_time;
+	double cpu_time;
+	size_t peak_rss;
+	Perf_Counts perf_counts;
+} Phase_Stats;
+
+/**
+ * @brief Assembly statistics type.
+ * The statistics recorded for the assembly of a single file.
+ */
+typedef struct {
+	const char* input_filename;
+	Phase_Stats phases[STATS_PHASE_COUNT];
+	size_t n_lines;
+	size_t n_statements;
+	size_t n_symbols;
+	size_t n_relocations;
+	size_t n_encoded_bytes;
+	size_t n_arena_allocations;
+	size_t n_arena_blocks;
+	size_t n_arena_bytes;
+} Assembly_Stats;
+
+#include <as.h>
+
+
+/**
+ * Whether trace events are being recorded. This is only modified before and
+ * after assembly.
+ */
+extern bool trace_events_enabled;
+
+
+/**
+ * @brief Parses the name of a statistics report format.
+ *
+ * @param format_name The name of the format, either `text` or `json`.
+ * @param format A pointer to the resulting format.
+ * @return A status entity indicating whether the name was valid.
+ */
+Assembler_Status parse_stats_format(const char* format_name,
+	Stats_Format* format);
+
+/**
+ * @brief Begins timing a phase.
+ *
+ * Starts the performance counters for the phase if they are enabled.
+ * @param stats The statistics being recorded. If this is NULL, statistics are
+ * disabled and nothing is recorded.
+ * @param timer The timer to start.
+ */
+void stats_begin_phase(const Assembly_Stats* stats,
+	Stats_Timer* timer);
+
+/**
+ * @brief Ends timing a phase.
+ *
+ * Adds the time elapsed since the timer was started, and any hardware events
+ * counted, to the phase's totals, so that a phase can be timed in several
+ * parts.
+ * @param stats The statistics being recorded. If this is NULL, statistics are
+ * disabled and nothing is recorded.
+ * @param phase The phase being timed.
+ * @param timer The timer started at the beginning of the phase. Its
+ * performance counters are closed.
+ */
+void stats_end_phase(Assembly_Stats* stats,
+	const Stats_Phase phase,
+	Stats_Timer* timer);
+
+/**
+ * @brief Adds CPU time used on another thread to a phase.
+ *
+ * The CPU time of a phase is measured on the thread that times it, so the time
+ * used by any jobs that the phase runs on other threads is added separately.
+ * @param stats The statistics being recorded. If this is NULL, statistics are
+ * disabled and nothing is recorded.
+ * @param phase The phase that the time was used in.
+ * @param cpu_time The CPU time used, in seconds.
+ */
+void stats_add_cpu_time(Assembly_Stats* stats,
+	const Stats_Phase phase,
+	const double cpu_time);
+
+/**
+ * @brief Gets the CPU time used by the calling thread.
+ *
+ * @return The CPU time used by the calling thread, in seconds.
+ */
+double stats_get_thread_cpu_time(void);
+
+/**
+ * @brief Begins timing a span.
+ *
+ * Begins timing a span of work outside of the assembler phases, such as an
+ * entire file or a single job. Nothing is recorded unless trace events are
+ * enabled.
+ * @param timer The timer to start.
+ */
+void stats_begin_span(Stats_Timer* timer);
+
+/**
+ * @brief Ends timing a span.
+ *
+ * Records a trace event for the span on the calling thread. Nothing is
+ * recorded unless trace events are enabled.
+ * @param timer The timer started at the beginning of the span.
+ * @param name The name of the span.
+ * @param category The category of the span.
+ * @param input_filename The input file that the span belongs to.
+ */
+void stats_end_span(const Stats_Timer* timer,
+	const char* name,
+	const char* category,
+	const char* input_filename);
+
+/**
+ * @brief Opens the trace event file.
+ *
+ * Opens the file that trace events are written to, and enables the recording
+ * of trace events. Each assembler phase, and each span, is recorded until the
+ * file is closed.
+ * @param filename The name of the trace event file.
+ * @return A status entity indicating whether the file was opened.
+ */
+Assembler_Status open_trace_event_file(const char* filename);
+
+/**
+ * @brief Closes the trace event file.
+ *
+ * Writes every recorded trace event to the trace event file in the Chrome
+ * trace event format, then closes it.
+ * @return A status entity indicating whether the events were written.
+ * @warning No assembly may be in progress when this is called.
+ */
+Assembler_Status close_trace_event_file(void);
+
+/**
+ * @brief Counts the lines in an input buffer.
+ *
+ * @param stats The statistics being recorded. If this is NULL, statistics are
+ * disabled and nothing is recorded.
+ * @param buffer The input buffer.
+ * @param buffer_size The size of the input buffer.
+ */
+void stats_count_lines(Assembly_Stats* stats,
+	const char* buffer,
+	const size_t buffer_size);
+
+/**
+ * @brief Prints a statistics report.
+ *
+ * Prints the statistics recorded for each assembled file to STDOUT, either as
+ * human readable text or as a single JSON object. If the performance counters
+ * are enabled, the instructions per cycle and miss rates of each phase are
+ * included.
+ * @param stats The statistics recorded for each file.
+ * @param n_files The number of files.
+ * @param format The format of the report.
+ */
+void print_assembly_stats(const Assembly_Stats* stats,
+	const size_t n_files,
+	const Stats_Format format);
+
+#endif
@@ -0,0 +1,99 @@
+/**
+ * @file string_pool.h
+ * @author Anthony (ajxs [at] panoptic.online)
+ * @brief String pool header.
+ * Contains the string pool definitions and functions. The string pool stores a
+ * single copy of every symbol name in the program.
+ * @version 0.1
+ * @date 2019-03-09
+ */
+
+#ifndef STRING_POOL_H
+#define STRING_POOL_H 1
+
+#include <stddef.h>
+#include <stdint.h>
+
+
+/**
+ * @brief String identifier type.
+ * Identifies a string interned in a string pool. This is the offset of the
+ * string's first character in the pool's data. Since each distinct string is
+ * only stored once, two strings in the same pool are equal only if their
+ * identifiers are equal.
+ * The identifier zero always refers to the empty string.
+ */
+typedef uint32_t String_Id;
+
+#include <as.h>
+
+/**
+ * @brief String pool type.
+ * Stores interned strings contiguously, each followed by a NUL terminator.
+ * Strings are indexed by an open-addressing hash table, which is used to find
+ * whether a string has already been interned. Each slot in the index holds the
+ * identifier of an interned string, with zero marking an empty slot. The empty
+ * string is never stored in the index.
+ */
+typedef struct {
+	char* data;
+	size_t size;
+	size_t capacity;
+	size_t n_strings;
+	size_t index_capacity;
+	String_Id* index;
+	uint32_t* index_hashes;
+} String_Pool;
+
+
+/**
+ * @brief Initialises a string pool.
+ *
+ * Initialises an empty string pool, containing only the empty string.
+ * @param string_pool A pointer to the string pool to initialise.
+ * @return A status entity indicating whether or not initialisation was
+ * successful.
+ * @warning The string pool must be freed with `free_string_pool`.
+ */
+Assembler_Status initialise_string_pool(String_Pool* string_pool);
+
+/**
+ * @brief Interns a string.
+ *
+ * Adds a string to a string pool, unless an identical string has already been
+ * added, and returns its identifier.
+ * @param string_pool A pointer to the string pool.
+ * @param string The string to intern. This does not need to be NUL terminated.
+ * @param length The length of the string.
+ * @param id A pointer to the resulting string identifier.
+ * @return A status entity indicating whether or not the string was able to be
+ * interned.
+ * @warning Pointers previously returned from `string_pool_get` are invalidated
+ * if the pool's data needs to be resized.
+ */
+Assembler_Status string_pool_intern(String_Pool* string_pool,
+	const char* string,
+	const size_t length,
+	String_Id* id);
+
+/**
+ * @brief Gets an interned string.
+ *
+ * Gets the NUL terminated string referred to by an identifier.
+ * @param string_pool A pointer to the string pool.
+ * @param id The identifier of the string.
+ * @return A pointer to the interned string. This is valid until the next string
+ * is interned.
+ */
+const char* string_pool_get(const String_Pool* string_pool,
+	const String_Id id);
+
+/**
+ * @brief Frees a string pool.
+ *
+ * Frees a string pool, and all of the strings contained therein.
+ * @param string_pool A pointer to the string pool to free.
+ */
+void free_string_pool(String_Pool* string_pool);
+
+#endif
@@ -10,13 +10,17 @@
 #ifndef SYMTAB_H
 #define SYMTAB_H 1
 
+#include <as.h>
 #include <section.h>
+#include <stdint.h>
+#include <string_pool.h>
 
 /**
  * @brief Symbol type.
  */
 typedef struct {
-	char* name;
+	String_Id name;
+	uint32_t name_hash;
 	const Section* section;
 	size_t offset;
 } Symbol;
@@ -25,15 +29,58 @@ typedef struct {
 /**
  * @brief Symbol table type.
  * Contains all of the individual symbols in a program.
+ * Symbols are stored in the order in which they were added, in an array which
+ * grows geometrically. Pointers to symbols remain valid until the array next
+ * grows, so callers that hold onto them should reserve space in advance using
+ * `symtab_reserve`. They are indexed by
+ * an open-addressing hash table of the same symbols, which is used to find
+ * symbols by name. Each slot in the index holds the position of a symbol in the
+ * symbol array plus one, with zero marking an empty slot.
+ * Symbol names are interned in the string pool, so names are compared by their
+ * identifiers alone.
  */
 typedef struct {
+	const String_Pool* string_pool;
 	size_t n_entries;
+	size_t capacity;
 	Symbol* symbols;
+	size_t index_capacity;
+	size_t* index;
 } Symbol_Table;
 
 
 /**
- * @brief Prints a symbol table.
+ * @brief Initialises a symbol table.
+ *
+ * Initialises an empty symbol table, containing only the null symbol entry
+ * required by the ELF specification.
+ * @param symtab A pointer to the symbol table to initialise.
+ * @param string_pool The string pool that symbol names are interned in.
+ * @return A status entity indicating whether or not initialisation was
+ * successful.
+ * @warning The symbol table must be freed with `free_symbol_table`.
+ */
+Assembler_Status initialise_symbol_table(Symbol_Table* symtab,
+	const String_Pool* string_pool);
+
+/**
+ * @brief Reserves space in a symbol table.
+ *
+ * Ensures that a symbol table can hold at least the specified number of
+ * symbols without needing to be resized.
+ * @param symtab A pointer to the symbol table.
+ * @param n_entries The total number of symbols to reserve space for, including
+ * those already in the table.
+ * @return A status entity indicating whether or not the space was able to be
+ * reserved.
+ * @warning Pointers to symbols in the table are invalidated if the symbol array
+ * needs to be resized.
+ */
+Assembler_Status symtab_reserve(Symbol_Table* symtab,
+	const size_t n_entries);
+
+/**
+ * @brief Prints a symbol table to the trace output.
  *
  * This function prints all of the entries inside a symbol table.
  * @param symbol_table The symbol table to print.
@@ -45,15 +92,15 @@ void print_symbol_table(const Symbol_Table* symbol_table);
  *
  * Adds a symbol to the symbol table.
  * @param symtab A pointer to symbol table to add the symbol to.
- * @param name The name for the new symbol. This is the name by which it will be
- * referenced.
+ * @param name The interned name for the new symbol. This is the name by which
+ * it will be referenced.
  * @param section A pointer to the section that contains this symbol.
  * @param offset The offset of the symbol being added in the section.
- * @warning @p symtab is modified in this function. The symbol entry array
- * is resized to accomodate the new symbol.
+ * @warning @p symtab is modified in this function. If the symbol entry array
+ * is full, its capacity is doubled to accomodate the new symbol.
  */
 Symbol* symtab_add_symbol(Symbol_Table* symtab,
-	char* name,
+	const String_Id name,
 	const Section* section,
 	const size_t offset);
 
@@ -62,24 +109,24 @@ Symbol* symtab_add_symbol(Symbol_Table* symtab,
  *
  * Finds a symbol contained in the symbol table.
  * @param symtab A pointer to symbol table to find the symbol in.
- * @param name The name of the symbol to search for.
+ * @param name The interned name of the symbol to search for.
  * @return A pointer to the first symbol matching the supplied name,
  * or `NULL` if none exists.
  */
 Symbol* symtab_find_symbol(const Symbol_Table* symtab,
-	const char* name);
+	const String_Id name);
 
 /**
- * @brief Finds a symbol in the symbol-table.
+ * @brief Finds the index of a symbol in the symbol-table.
  *
- * Finds a symbol contained in the symbol table.
+ * Finds the index of a symbol contained in the symbol table.
  * @param symtab A pointer to symbol table to find the symbol in.
- * @param name The name of the symbol to search for.
- * @return A pointer to the first symbol matching the supplied name,
- * or `NULL` if none exists.
+ * @param name The interned name of the symbol to search for.
+ * @return The index of the first symbol matching the supplied name,
+ * or -1 if none exists.
  */
 ssize_t symtab_find_symbol_index(const Symbol_Table* symtab,
-	const char* name);
+	const String_Id name);
 
 
 /**
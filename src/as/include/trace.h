@@ -0,0 +1,104 @@
+/**
+ * @file trace.h
+ * @author Anthony (ajxs [at] panoptic.online)
+ * @brief Trace output header.
+ * Contains the definitions and functions for printing trace output. Tracing is
+ * split into channels which are enabled at runtime. When a channel is disabled
+ * its trace points cost a single branch, and no output is formatted.
+ * @version 0.1
+ * @date 2019-03-09
+ */
+
+#ifndef TRACE_H
+#define TRACE_H 1
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <as.h>
+
+
+/**
+ * @brief Trace channel type.
+ * Each channel traces a separate part of the assembler process.
+ */
+typedef enum {
+	TRACE_CHANNEL_ASSEMBLER,
+	TRACE_CHANNEL_CODEGEN,
+	TRACE_CHANNEL_INPUT,
+	TRACE_CHANNEL_LEXER,
+	TRACE_CHANNEL_MACRO,
+	TRACE_CHANNEL_OUTPUT,
+	TRACE_CHANNEL_STATEMENTS,
+	TRACE_CHANNEL_SYMBOLS,
+	TRACE_CHANNEL_COUNT
+} Trace_Channel;
+
+/**
+ * The set of enabled trace channels. Each channel is enabled by setting the bit
+ * at its index. This is only modified before assembly begins.
+ */
+extern uint32_t trace_enabled_channels;
+
+/**
+ * @brief Tests whether a trace channel is enabled.
+ *
+ * Tracing is expected to be disabled, so that the branch testing each trace
+ * point is predicted to be not taken.
+ * @param channel The channel to test.
+ * @return Whether the channel is enabled.
+ */
+static inline bool trace_is_enabled(const Trace_Channel channel)
+{
+	return __builtin_expect((trace_enabled_channels >> channel) & 1, 0);
+}
+
+/**
+ * @brief Prints a trace message to a channel.
+ * The message's arguments are only evaluated if the channel is enabled.
+ */
+#define TRACE(channel, ...)                    \
+	do {                                         \
+		if(trace_is_enabled(channel)) {            \
+			trace_printf(__VA_ARGS__);               \
+		}                                          \
+	} while(0)
+
+/**
+ * @brief Enables a list of trace channels.
+ *
+ * Enables each channel in a comma separated list of channel names. The name
+ * `all` enables every channel.
+ * @param channel_list The list of channel names to enable.
+ * @return A status entity indicating whether every channel name was valid. If
+ * not, no channels are enabled.
+ */
+Assembler_Status trace_enable_channels(const char* channel_list);
+
+/**
+ * @brief Enables a single trace channel.
+ * @param channel The channel to enable.
+ */
+void trace_enable_channel(const Trace_Channel channel);
+
+/**
+ * @brief Prints formatted trace output.
+ *
+ * Formats a message into the calling thread's trace buffer. The buffer is
+ * written to STDERR when full, or when it is flushed. Each message is written
+ * whole, so the output of separate threads is not interleaved mid-message.
+ * This should only be called once the relevant channel has been checked, such
+ * as through the `TRACE` macro.
+ * @param format The printf format string.
+ */
+void trace_printf(const char* format,
+	...) __attribute__((format(printf, 1, 2)));
+
+/**
+ * @brief Flushes the calling thread's trace buffer.
+ *
+ * Writes any buffered trace output from the calling thread to STDERR. This
+ * must be called before a thread which has printed trace output exits.
+ */
+void trace_flush(void);
+
+#endif
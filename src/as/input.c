@@ -10,99 +10,256 @@
 
 #include <string.h>
 #include <stdlib.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 #include <as.h>
 #include <input.h>
 #include <statement.h>
+#include <stats.h>
+#include <trace.h>
 
 
 /**
- * read_input
+ * @brief Maps the input file into memory.
+ *
+ * Maps the entirety of a regular input file into memory so that it can be
+ * scanned in place. The mapping is followed by at least two NUL bytes, as
+ * required by the scanner. This is accomplished by reserving an anonymous,
+ * zero-filled region large enough for the file and its terminators, then
+ * mapping the file over the start of it.
+ * The mapping is private, so modifications made by the scanner are never written
+ * back to the file.
+ * @param input_file The input file to map.
+ * @param buffer A pointer-to-pointer to the mapped buffer.
+ * @param buffer_size A pointer to the size of the mapped file.
+ * @param mapping_size A pointer to the total size of the mapping, used to unmap it.
+ * @return Whether the file was able to be mapped. Files which are not regular
+ * files, such as pipes, cannot be mapped.
  */
-Assembler_Status read_input(FILE* input_file,
-	Statement** program_statements)
+static bool map_input_file(FILE* input_file,
+	char** buffer,
+	size_t* buffer_size,
+	size_t* mapping_size);
+
+/**
+ * @brief Reads the source input into a buffer.
+ *
+ * Reads the entirety of the source input into a single heap allocated buffer.
+ * This is used for input that cannot be mapped into memory, such as pipes.
+ * The buffer is followed by two NUL bytes, as required by the scanner.
+ * @param input_file The file pointer for the input source file.
+ * @param buffer A pointer-to-pointer to the resulting buffer.
+ * @param buffer_size A pointer to the size of the input read into the buffer.
+ * @return A status entity indicating whether or not the read was successful.
+ * @warning The buffer is allocated in this function, and must be freed by the
+ * caller.
+ */
+static Assembler_Status read_input_stream(FILE* input_file,
+	char** buffer,
+	size_t* buffer_size);
+
+
+/**
+ * map_input_file
+ */
+static bool map_input_file(FILE* input_file,
+	char** buffer,
+	size_t* buffer_size,
+	size_t* mapping_size)
 {
-	/** The buffer holding the raw, unprocessed input line. */
-	char* line_buffer = NULL;
-	/** The length of the input line buffer, used by 'getline'. */
-	size_t line_buffer_length = 0;
-	/** The number of chars read from the input file. */
-	ssize_t chars_read = 0;
-	/** The number of the line being processed. */
-	size_t line_num = 1;
-	/** Buffer holding the preprocessed lines. */
-	char* line = NULL;
-	/** The program status. */
-	Assembler_Status status = ASSEMBLER_STATUS_SUCCESS;
+	/** The file descriptor of the input file. */
+	const int input_fd = fileno(input_file);
+	/** The input file's status information. */
+	struct stat input_stat;
+	/** The system page size. */
+	long page_size = 0;
+	/** The anonymous region reserved for the mapping. */
+	void* reservation = NULL;
+	/** The mapped file contents. */
+	void* mapped_file = NULL;
 
-	// Read all the lines in the file.
-	while((chars_read = getline(&line_buffer, &line_buffer_length, input_file)) != -1) {
-#if DEBUG_INPUT == 1
-	printf("Input line #%zu: `%s`", line_num, line_buffer);
-#endif
+	if(input_fd == -1) {
+		return false;
+	}
 
-		// Preprocess the line. Normalises the line to conform to a standard format.
-		status = preprocess_line(line_buffer, &line);
-		if(!get_status(status)) {
-			// Free the line buffer.
-			// The processed line buffer will have been freed by the callee.
-			free(line_buffer);
+	if(fstat(input_fd, &input_stat) == -1) {
+		return false;
+	}
 
-			return ASSEMBLER_ERROR_PREPROCESSING_FAILURE;
-		}
+	// Only regular files with content can be mapped.
+	if(!S_ISREG(input_stat.st_mode) || input_stat.st_size == 0) {
+		return false;
+	}
 
-		// If the resulting line has no length, do not parse any further.
-		if(strlen(line) == 0) {
-			free(line);
+	page_size = sysconf(_SC_PAGESIZE);
+	if(page_size <= 0) {
+		return false;
+	}
 
-			continue;
-		}
+	*buffer_size = (size_t)input_stat.st_size;
+	// Reserve space for the two trailing NUL bytes, rounded to the page size.
+	*mapping_size = ((*buffer_size + 2 + page_size - 1) / page_size) * page_size;
 
-		// This is where each line from the source file is lexed and parsed.
-		// This returns a linked-list entity, since architecture-depending, a single
-		// line may contain multiple `statement`s.
-		Statement* parsed_statements = scan_string(line);
+	reservation = mmap(NULL, *mapping_size, PROT_READ | PROT_WRITE,
+		MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if(reservation == MAP_FAILED) {
+		return false;
+	}
 
-		// Iterate through each processed statement and set its line number.
-		Statement* curr = parsed_statements;
-		curr->line_num = line_num;
-		while(curr->next) {
-			curr = curr->next;
-			curr->line_num = line_num;
-		}
+	// Any remainder of the final page of the file is zero-filled by the kernel.
+	// If the file ends on a page boundary the reserved anonymous page that
+	// follows it provides the terminators.
+	mapped_file = mmap(reservation, *buffer_size, PROT_READ | PROT_WRITE,
+		MAP_PRIVATE | MAP_FIXED, input_fd, 0);
+	if(mapped_file == MAP_FAILED) {
+		munmap(reservation, *mapping_size);
+
+		return false;
+	}
+
+	// The file is scanned strictly from start to end.
+	madvise(mapped_file, *buffer_size, MADV_SEQUENTIAL);
+
+	*buffer = mapped_file;
+
+	return true;
+}
+
+
+/**
+ * read_input_stream
+ */
+static Assembler_Status read_input_stream(FILE* input_file,
+	char** buffer,
+	size_t* buffer_size)
+{
+	/** The size of the initial allocation, doubled each time it is filled. */
+	const size_t initial_capacity = 0x10000;
+	/** The allocated capacity of the buffer, excluding the trailing NUL bytes. */
+	size_t capacity = initial_capacity;
+	/** The number of bytes read by each call to `fread`. */
+	size_t bytes_read = 0;
+	/** Used to track the result of resizing the buffer. */
+	char* resized_buffer = NULL;
+
+	*buffer_size = 0;
+	*buffer = malloc(capacity + 2);
+	if(!*buffer) {
+		fprintf(stderr, "Error: Error allocating input buffer\n");
 
-		if(!*program_statements) {
-			// Add to start of linked list.
-			*program_statements = parsed_statements;
-		} else {
-			// Add to tail of linked list.
-			curr = *program_statements;
-			while(curr->next) {
-				curr = curr->next;
+		return ASSEMBLER_ERROR_BAD_ALLOC;
+	}
+
+	while((bytes_read = fread(*buffer + *buffer_size, 1,
+		capacity - *buffer_size, input_file)) > 0) {
+		*buffer_size += bytes_read;
+
+		if(*buffer_size == capacity) {
+			capacity *= 2;
+			resized_buffer = realloc(*buffer, capacity + 2);
+			if(!resized_buffer) {
+				fprintf(stderr, "Error: Error resizing input buffer\n");
+				free(*buffer);
+
+				return ASSEMBLER_ERROR_BAD_ALLOC;
 			}
 
-			curr->next = parsed_statements;
+			*buffer = resized_buffer;
+		}
+	}
+
+	if(ferror(input_file)) {
+		fprintf(stderr, "Error: Error reading input file\n");
+		free(*buffer);
+
+		return ASSEMBLER_ERROR_FILE_FAILURE;
+	}
+
+	(*buffer)[*buffer_size] = '\0';
+	(*buffer)[*buffer_size + 1] = '\0';
+
+	return ASSEMBLER_STATUS_SUCCESS;
+}
+
+
+/**
+ * read_input
+ */
+Assembler_Status read_input(FILE* input_file,
+	Arena* arena,
+	String_Pool* string_pool,
+	Statement** program_statements,
+	Assembly_Stats* stats)
+{
+	/** The buffer holding the mapped input file. */
+	char* input_buffer = NULL;
+	/** The size of the mapped input file. */
+	size_t input_buffer_size = 0;
+	/** The total size of the input file mapping. */
+	size_t mapping_size = 0;
+	/** Whether the input file was mapped into memory. */
+	bool is_mapped = false;
+	/** The list of statements parsed from the input. */
+	Statement_List statement_list = { NULL, NULL, 0 };
+	/** The program status. */
+	Assembler_Status status = ASSEMBLER_STATUS_SUCCESS;
+	/** The timer for the current phase. */
+	Stats_Timer phase_timer;
+
+	stats_begin_phase(stats, &phase_timer);
+
+	is_mapped = map_input_file(input_file, &input_buffer, &input_buffer_size,
+		&mapping_size);
+	if(is_mapped) {
+		TRACE(TRACE_CHANNEL_INPUT,
+			"Debug Input: Mapped `%zu` bytes of input\n", input_buffer_size);
+	} else {
+		// Input that cannot be mapped is read into a single buffer, which is then
+		// scanned in the same way.
+		status = read_input_stream(input_file, &input_buffer, &input_buffer_size);
+		if(!get_status(status)) {
+			// Error message will have been printed by the callee.
+			return status;
 		}
 
-		// Free the preprocessed line.
-		free(line);
-		line = NULL;
+		TRACE(TRACE_CHANNEL_INPUT,
+			"Debug Input: Read `%zu` bytes of input\n", input_buffer_size);
+	}
+
+	stats_end_phase(stats, STATS_PHASE_READ, &phase_timer);
+	stats_count_lines(stats, input_buffer, input_buffer_size);
+
+	// The entire file is lexed and parsed directly from the buffer.
+	stats_begin_phase(stats, &phase_timer);
+	status = scan_buffer(input_buffer, input_buffer_size, arena,
+		string_pool, &statement_list);
+	stats_end_phase(stats, STATS_PHASE_PARSE, &phase_timer);
 
-		line_num++;
+	if(is_mapped) {
+		munmap(input_buffer, mapping_size);
+	} else {
+		free(input_buffer);
 	}
 
-#if DEBUG_PARSED_STATEMENTS == 1
-	// Iterate over all parsed statements, printing each one.
-	Statement* curr = *program_statements;
+	// Any statements parsed before an error are returned to the caller. These
+	// are owned by the arena.
+	*program_statements = statement_list.head;
 
-	while(curr) {
-		print_statement(curr);
-		curr = curr->next;
+	if(!get_status(status)) {
+		// Error message will have been printed by the callee.
+		return status;
 	}
-#endif
 
-	// Prevent memory leak. Refer to:
-	// https://stackoverflow.com/questions/55731141/memory-leak-when-reading-file-line-by-line-using-getline
-	free(line_buffer);
+	if(trace_is_enabled(TRACE_CHANNEL_STATEMENTS)) {
+		// Iterate over all parsed statements, printing each one.
+		Statement* curr = *program_statements;
+
+		while(curr) {
+			print_statement(curr, string_pool);
+			curr = curr->next;
+		}
+	}
 
 	return ASSEMBLER_STATUS_SUCCESS;
 }
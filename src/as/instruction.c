@@ -12,32 +12,19 @@
 #include <as.h>
 #include <instruction.h>
 #include <statement.h>
-
-
-/**
- * free_instruction
- */
-void free_instruction(Instruction* instruction)
-{
-	if(!instruction) {
-		fprintf(stderr, "Invalid instruction provided to free function.\n");
-
-		return;
-	}
-
-	free_operand_sequence(&instruction->opseq);
-}
+#include <trace.h>
 
 
 /**
  * print_instruction
  */
-void print_instruction(const Instruction* instruction)
+void print_instruction(const Instruction* instruction,
+	const String_Pool* string_pool)
 {
 	const char* opcode_name = get_opcode_string(instruction->opcode);
-	printf("  Instruction: Opcode: `%s`\n", opcode_name);
+	trace_printf("  Instruction: Opcode: `%s`\n", opcode_name);
 
 	if(instruction->opseq.n_operands > 0) {
-		print_operand_sequence(&instruction->opseq);
+		print_operand_sequence(&instruction->opseq, string_pool);
 	}
 }
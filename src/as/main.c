@@ -10,12 +10,17 @@
 
 #define _GNU_SOURCE
 
+#include <errno.h>
 #include <stddef.h>
 #include <stdbool.h>
+#include <stdio.h>
 #include <stdlib.h>
 #include <getopt.h>
 #include <string.h>
 #include <as.h>
+#include <perf_counters.h>
+#include <stats.h>
+#include <trace.h>
 
 
 /**
@@ -40,17 +45,42 @@ static void print_help(void);
  */
 static void handle_opts_error(const char* error);
 
+/**
+ * @brief Creates the name of the output file for an input file.
+ * Creates the path of the file in the output directory with the same name as
+ * the input file, with its extension replaced by `.elf`.
+ * @param output_dir The directory to write the output file to.
+ * @param input_filename The name of the input file.
+ * @return The output filename, or NULL if it could not be allocated.
+ * @warning The returned string must be freed by the caller.
+ */
+static char* create_output_filename(const char* output_dir,
+	const char* input_filename);
+
 
 /**
  * print_help
  */
 static void print_help(void) {
-	printf("Usage 'ajxs-{ARCH}-elf-as' input_file\n");
+	printf("Usage 'ajxs-{ARCH}-elf-as' input_file...\n");
 	printf("[-?|--help]\n");
-	printf("-o|--output\n");
+	printf("[-o|--output FILE]...\n");
+	printf("[-d|--output-dir DIR]\n");
 	printf("[-v|--verbose]\n");
-	printf("output: The output filename. Defaults to `out.elf`\n");
-	printf("verbose: Enables verbose program output.\n");
+	printf("[-t|--trace CHANNEL,...]\n");
+	printf("[-j|--jobs N]\n");
+	printf("[--stats[=text|json]]\n");
+	printf("[--perf-counters]\n");
+	printf("[--trace-file FILE]\n");
+	printf("output: The output filename. Given once for each input file, in the same order. Defaults to `out.elf` for a single input file.\n");
+	printf("output-dir: The directory to write each output file to, named after its input file.\n");
+	printf("verbose: Enables verbose program output. Equivalent to `--trace=assembler`.\n");
+	printf("trace: Enables trace output to STDERR for each listed channel, or `all`.\n");
+	printf("  Channels: assembler, codegen, input, lexer, macro, output, statements, symbols.\n");
+	printf("jobs: The maximum number of threads used to assemble the files. Defaults to 1.\n");
+	printf("stats: Prints the time and resources used by each assembler phase to STDOUT. Defaults to `text`.\n");
+	printf("perf-counters: Adds the instructions per cycle, cache miss rate and branch miss rate of each phase to the statistics. Implies `--stats`.\n");
+	printf("trace-file: Writes a trace event of each assembler phase, input file and job to FILE, in the Chrome trace event format.\n");
 }
 
 
@@ -64,29 +94,95 @@ static void handle_opts_error(const char* error) {
 }
 
 
+/**
+ * create_output_filename
+ */
+static char* create_output_filename(const char* output_dir,
+	const char* input_filename)
+{
+	/** The output file extension. */
+	const char* extension = ".elf";
+	/** The name of the input file, without its directory. */
+	const char* name = strrchr(input_filename, '/');
+	/** The length of the input file's name, without its extension. */
+	size_t name_len = 0;
+	/** The created output filename. */
+	char* output_filename = NULL;
+	/** The length of the created output filename. */
+	size_t output_filename_len = 0;
+
+	name = name ? name + 1 : input_filename;
+	name_len = strlen(name);
+
+	// Hidden files are named entirely by their extension, which is kept.
+	const char* name_extension = strrchr(name, '.');
+	if(name_extension && name_extension != name) {
+		name_len = name_extension - name;
+	}
+
+	output_filename_len = strlen(output_dir) + 1 + name_len + strlen(extension);
+	output_filename = malloc(output_filename_len + 1);
+	if(!output_filename) {
+		return NULL;
+	}
+
+	snprintf(output_filename, output_filename_len + 1, "%s/%.*s%s", output_dir,
+		(int)name_len, name, extension);
+
+	return output_filename;
+}
+
+
 /**
  * main
  */
 int main(int argc,
 	char **argv)
 {
-	/** The input filename. */
-	const char* input_filename = NULL;
+	/** The input filenames. */
+	const char* const* input_filenames = NULL;
+	/** The number of input files. */
+	size_t n_input_files = 0;
 	/** The default output filename. */
 	const char* default_output_filename = "./out.elf";
 
 	/**
-	 * @brief The output filename.
-	 * The output filename defaults to `out.elf` if not specified. This variable
-	 * is set with the -o/--output command line argument.
+	 * @brief The output filenames.
+	 * These are set with the -o/--output command line argument, once for each
+	 * input file. If only a single input file is given, the output filename
+	 * defaults to `out.elf` if not specified.
 	 */
-	const char* output_filename = default_output_filename;
-	/** Whether or not verbose mode is enabled. */
-	bool verbose = false;
+	const char** output_filenames = NULL;
+	/** The number of output filenames specified. */
+	size_t n_output_filenames = 0;
+	/** The directory to write the output files to. */
+	const char* output_dir = NULL;
+	/** The output filenames created in the output directory. */
+	char** created_output_filenames = NULL;
+	/** Whether or not statistics are recorded. */
+	bool record_stats = false;
+	/** Whether or not the performance counters are counted. */
+	bool count_perf_counters = false;
+	/** The format of the statistics report. */
+	Stats_Format stats_format = STATS_FORMAT_TEXT;
+	/** The statistics recorded for each input file. */
+	Assembly_Stats* stats = NULL;
+	/** The file to write trace events to. */
+	const char* trace_event_filename = NULL;
+	/** The maximum number of jobs used to encode the program. */
+	size_t n_jobs = 1;
+	/** The end of the parsed job count argument. */
+	char* jobs_end = NULL;
 	/** getopts configuration. */
 	static struct option long_options[] = {
 		{"help", no_argument, NULL, '?'},
+		{"jobs", required_argument, NULL, 'j'},
 		{"output", required_argument, NULL, 'o'},
+		{"output-dir", required_argument, NULL, 'd'},
+		{"perf-counters", no_argument, NULL, 'P'},
+		{"stats", optional_argument, NULL, 's'},
+		{"trace", required_argument, NULL, 't'},
+		{"trace-file", required_argument, NULL, 'T'},
 		{"verbose", no_argument, NULL, 'v'},
 		{0, 0, 0, 0}
 	};
@@ -95,39 +191,163 @@ int main(int argc,
 	/** The option index being checked. */
 	int option_index = 0;
 
-	while((c = getopt_long(argc, argv, "?o:v", long_options, &option_index)) != -1) {
+	// Every argument could be an output filename, so this is the most that can
+	// be specified.
+	output_filenames = calloc(argc, sizeof(const char*));
+	if(!output_filenames) {
+		fprintf(stderr, "Error: Error allocating output filenames\n");
+		exit(EXIT_FAILURE);
+	}
+
+	while((c = getopt_long(argc, argv, "?d:j:o:t:v", long_options, &option_index)) != -1) {
 		switch(c) {
 			case 'h':
 				print_help();
 				exit(EXIT_SUCCESS);
+			case 'd':
+				if(!optarg || strlen(optarg) == 0) {
+					handle_opts_error("Invalid output directory.");
+				}
+
+				output_dir = optarg;
+				break;
+			case 'j':
+				if(!optarg || strlen(optarg) == 0) {
+					handle_opts_error("Invalid job count.");
+				}
+
+				errno = 0;
+				n_jobs = strtoul(optarg, &jobs_end, 10);
+				if(errno || *jobs_end != '\0' || n_jobs == 0) {
+					handle_opts_error("Invalid job count.");
+				}
+
+				break;
 			case 'o':
 				if(!optarg || strlen(optarg) == 0) {
 					handle_opts_error("Invalid output filename.");
 				}
 
-				output_filename = optarg;
+				output_filenames[n_output_filenames++] = optarg;
+				break;
+			case 'P':
+				count_perf_counters = true;
+				record_stats = true;
+				break;
+			case 's':
+				if(!get_status(parse_stats_format(optarg, &stats_format))) {
+					handle_opts_error("Invalid statistics format.");
+				}
+
+				record_stats = true;
+				break;
+			case 't':
+				if(!optarg || !get_status(trace_enable_channels(optarg))) {
+					handle_opts_error("Invalid trace channels.");
+				}
+
+				break;
+			case 'T':
+				if(!optarg || strlen(optarg) == 0) {
+					handle_opts_error("Invalid trace event filename.");
+				}
+
+				trace_event_filename = optarg;
 				break;
 			case 'v':
-				verbose = true;
+				trace_enable_channel(TRACE_CHANNEL_ASSEMBLER);
 				break;
 			default:
 				handle_opts_error("Unrecognised option.");
 		}
 	}
 
-	if(optind < argc) {
-		// Store first non-option ARGV element as the input filename.
-		// Currently only one input file is supported.
-		input_filename = argv[optind];
+	// All non-option ARGV elements are input filenames.
+	input_filenames = (const char* const*)&argv[optind];
+	n_input_files = argc - optind;
+
+	if(n_input_files == 0) {
+		handle_opts_error("No input filename specified.");
 	}
 
+	for(size_t i = 0; i < n_input_files; i++) {
+		if(strlen(input_filenames[i]) == 0) {
+			handle_opts_error("Invalid input filename.");
+		}
+	}
 
-	if(!input_filename || strlen(input_filename) == 0) {
-		handle_opts_error("No input filename specified.");
+	if(output_dir) {
+		if(n_output_filenames > 0) {
+			handle_opts_error("Output filenames cannot be combined with an output directory.");
+		}
+
+		created_output_filenames = calloc(n_input_files, sizeof(char*));
+		if(!created_output_filenames) {
+			fprintf(stderr, "Error: Error allocating output filenames\n");
+			exit(EXIT_FAILURE);
+		}
+
+		for(size_t i = 0; i < n_input_files; i++) {
+			created_output_filenames[i] = create_output_filename(output_dir,
+				input_filenames[i]);
+			if(!created_output_filenames[i]) {
+				fprintf(stderr, "Error: Error allocating output filenames\n");
+				exit(EXIT_FAILURE);
+			}
+
+			output_filenames[i] = created_output_filenames[i];
+		}
+	} else if(n_output_filenames == 0 && n_input_files == 1) {
+		output_filenames[0] = default_output_filename;
+	} else if(n_output_filenames != n_input_files) {
+		handle_opts_error("An output filename must be specified for each input file.");
+	}
+
+	// If the performance counters are unavailable, the statistics are still
+	// recorded without them.
+	if(count_perf_counters) {
+		perf_counters_enable();
+	}
+
+	if(trace_event_filename &&
+		!get_status(open_trace_event_file(trace_event_filename))) {
+		// Error message printed in callee.
+		exit(EXIT_FAILURE);
+	}
+
+	// Trace events are recorded at the same phase boundaries as statistics.
+	if(record_stats || trace_event_filename) {
+		stats = calloc(n_input_files, sizeof(Assembly_Stats));
+		if(!stats) {
+			fprintf(stderr, "Error: Error allocating statistics\n");
+			exit(EXIT_FAILURE);
+		}
 	}
 
 	// Begin the main assembler process.
-	Assembler_Status assembler_result = assemble(input_filename, output_filename, verbose);
+	Assembler_Status assembler_result = assemble_files(input_filenames,
+		output_filenames, n_input_files, n_jobs, stats);
+
+	if(trace_event_filename && !get_status(close_trace_event_file())) {
+		// Error message printed in callee.
+		assembler_result = ASSEMBLER_ERROR_FILE_FAILURE;
+	}
+
+	if(record_stats) {
+		print_assembly_stats(stats, n_input_files, stats_format);
+	}
+
+	free(stats);
+
+	if(created_output_filenames) {
+		for(size_t i = 0; i < n_input_files; i++) {
+			free(created_output_filenames[i]);
+		}
+	}
+
+	free(created_output_filenames);
+	free(output_filenames);
+
 	if(!get_status(assembler_result)) {
 		exit(EXIT_FAILURE);
 	}
@@ -4,28 +4,42 @@
 #include <stdint.h>
 #include <stddef.h>
 #include <string.h>
+#include "arena.h"
 #include "as.h"
 #include "directive.h"
 #include "instruction.h"
 #include "parsing.h"
 #include "statement.h"
 
+%}
 
-extern int yylex(void);
-void yyerror(Statement** statements, const char* str);
+%code requires {
+#include "parsing.h"
+}
 
-%}
+%code {
+extern int yylex(YYSTYPE* yylval,
+	YYLTYPE* yylloc,
+	yyscan_t scanner);
+void yyerror(YYLTYPE* location,
+	yyscan_t scanner,
+	Arena* arena,
+	String_Pool* string_pool,
+	Statement_List* statements,
+	const char* str);
+}
 
 
+%define api.pure full
 %define api.value.type {union YYSTYPE}
+%locations
 
-%token <text> LABEL
+%token <id> LABEL
 %token <directive> DIRECTIVE
-%token <text> SYMBOL
+%token <id> SYMBOL
 %token <reg> REGISTER
 %token <text> STRING_LITERAL
 %token <imm> NUMERIC_LITERAL
-%token COMMENT
 %token STATEMENT_DELIMITER
 %token ARGUMENT_DELIMITER
 %token <mask> MASK
@@ -36,98 +50,93 @@ void yyerror(Statement** statements, const char* str);
 %nterm <statement> statement
 %nterm <opseq> operand_seq
 
-%parse-param {Statement **statements}
-
-// https://www.gnu.org/software/bison/manual/html_node/Printer-Decl.html#Printer-Decl
-
-%destructor {
-	free($$);
-} LABEL
-
-%destructor {
-	free($$);
-} SYMBOL
-
-%destructor {
-	free($$);
-} STRING_LITERAL
+// The parser and scanner are reentrant, so that separate files can be parsed
+// concurrently. All of their state is passed through these parameters.
+%lex-param {yyscan_t scanner}
+%parse-param {yyscan_t scanner} {Arena *arena} {String_Pool *string_pool} {Statement_List *statements}
 
-%destructor {
-	free_operand(&$$);
-} operand
-
-%destructor {
-	free_operand_sequence(&$$);
-} operand_seq
-
-%destructor {
-	free_instruction(&$$);
-} instruction
-
-%destructor {
-	free_directive(&$$);
-} directive
-
-%destructor {
-	free_statement($$);
-} statement
+// Every value allocated by the parser is owned by the arena, so no destructors
+// are needed to clean up values discarded during error recovery.
 
 %%
 
 input:
 	%empty
+	| input STATEMENT_DELIMITER
 	| input statement {
-		if(!*statements) {
-			*statements = $2;
-		} else {
-			Statement* curr = *statements;
-
-			while(curr->next) {
-				curr = curr->next;
-			}
-
-			curr->next = $2;
-		}
+		append_statement(statements, $2);
+	}
+	| input error STATEMENT_DELIMITER {
+		// Discard the erroneous statement and resume parsing at the next one.
+		yyerrok;
 	}
 	;
 
 
 statement:
-	statement STATEMENT_DELIMITER
-	| LABEL statement {
+	LABEL statement {
 		// Add label to existing array.
+		$2->labels = arena_realloc(arena, $2->labels,
+			sizeof(String_Id) * $2->n_labels, sizeof(String_Id) * ($2->n_labels + 1));
+		if(!$2->labels) {
+			yyerror(&@$, scanner, arena, string_pool, statements, "Error allocating statement labels");
+			YYABORT;
+		}
+
 		$2->n_labels++;
-		$2->labels = realloc($2->labels, sizeof(char*) * $2->n_labels);
-		$2->labels[$2->n_labels-1] = $<text>1;
+		$2->labels[$2->n_labels-1] = $<id>1;
 
 		$$ = $2;
 	}
 	| LABEL {
-		Statement* statement = malloc(sizeof(Statement));
+		Statement* statement = arena_alloc(arena, sizeof(Statement));
+		if(!statement) {
+			yyerror(&@$, scanner, arena, string_pool, statements, "Error allocating statement");
+			YYABORT;
+		}
+
 		statement->type = STATEMENT_TYPE_EMPTY;
 		statement->n_labels = 1;
-		statement->labels = malloc(sizeof(char*));
-		statement->labels[0] = $<text>1;
+		statement->labels = arena_alloc(arena, sizeof(String_Id));
+		if(!statement->labels) {
+			yyerror(&@$, scanner, arena, string_pool, statements, "Error allocating statement labels");
+			YYABORT;
+		}
+
+		statement->labels[0] = $<id>1;
+		statement->line_num = @1.first_line;
 		statement->next = NULL;
 
 		$$ = statement;
 	}
 	| instruction {
-		Statement* statement = malloc(sizeof(Statement));
+		Statement* statement = arena_alloc(arena, sizeof(Statement));
+		if(!statement) {
+			yyerror(&@$, scanner, arena, string_pool, statements, "Error allocating statement");
+			YYABORT;
+		}
+
 		statement->type = STATEMENT_TYPE_INSTRUCTION;
 		statement->instruction = $<instruction>1;
 		statement->n_labels = 0;
 		statement->labels = NULL;
+		statement->line_num = @1.first_line;
 		statement->next = NULL;
 
 		$$ = statement;
 	}
 	| directive {
-		Statement* statement = malloc(sizeof(Statement));
+		Statement* statement = arena_alloc(arena, sizeof(Statement));
+		if(!statement) {
+			yyerror(&@$, scanner, arena, string_pool, statements, "Error allocating statement");
+			YYABORT;
+		}
+
 		statement->type = STATEMENT_TYPE_DIRECTIVE;
 		statement->directive = $1;
 		statement->n_labels = 0;
 		statement->labels = NULL;
+		statement->line_num = @1.first_line;
 		statement->next = NULL;
 
 		$$ = statement;
@@ -137,24 +146,16 @@ statement:
 instruction:
 	SYMBOL {
 		Instruction instruction;
-		instruction.opcode = parse_opcode_symbol($1);
+		instruction.opcode = parse_opcode_symbol(string_pool_get(string_pool, $1));
 		instruction.opseq.n_operands = 0;
 		$$ = instruction;
-
-		// Free the allocated text here.
-		// This was duplicated in the lexer.
-		free($1);
 	}
 	| SYMBOL operand_seq {
 		Instruction instruction;
-		instruction.opcode = parse_opcode_symbol($1);
+		instruction.opcode = parse_opcode_symbol(string_pool_get(string_pool, $1));
 		instruction.opseq = $2;
 
 		$$ = instruction;
-
-		// Free the allocated text here.
-		// This was duplicated in the lexer.
-		free($1);
 	}
 	;
 
@@ -180,23 +181,30 @@ operand_seq:
 	operand {
 		Operand_Sequence opseq;
 		opseq.n_operands = 1;
-		opseq.operands = malloc(opseq.n_operands * sizeof(Operand));
+		opseq.operands = arena_alloc(arena, sizeof(Operand));
+		if(!opseq.operands) {
+			yyerror(&@$, scanner, arena, string_pool, statements, "Error allocating operands");
+			YYABORT;
+		}
+
 		opseq.operands[0] = $1;
 
 		$$ = opseq;
 	}
-	| operand ARGUMENT_DELIMITER operand_seq {
-		// Shift the operand onto start of the existing array.
-		$3.n_operands++;
-		$3.operands = realloc($3.operands, 
-			sizeof(Operand) * $3.n_operands);
-
-		memmove(&$3.operands[1], &$3.operands[0],
-			sizeof(Operand) * ($3.n_operands - 1));
+	| operand_seq ARGUMENT_DELIMITER operand {
+		// Append the operand to the existing array. This is usually the most recent
+		// allocation from the arena, in which case it is extended in place.
+		$1.operands = arena_realloc(arena, $1.operands,
+			sizeof(Operand) * $1.n_operands, sizeof(Operand) * ($1.n_operands + 1));
+		if(!$1.operands) {
+			yyerror(&@$, scanner, arena, string_pool, statements, "Error allocating operands");
+			YYABORT;
+		}
 
-		$3.operands[0] = $1;
+		$1.operands[$1.n_operands] = $3;
+		$1.n_operands++;
 
-		$$ = $3;
+		$$ = $1;
 	}
 	;
 
@@ -215,7 +223,7 @@ operand:
 		operand.type = OPERAND_TYPE_REGISTER;
 		operand.flags = DEFAULT_OPERAND_FLAGS;
 		operand.offset = 0;
-		operand.reg = $<reg>1;
+		operand.reg = $<reg>2;
 		$$ = operand;
 	}
 	| NUMERIC_LITERAL '(' REGISTER ')' { 
@@ -244,7 +252,7 @@ operand:
 		Operand operand;
 		operand.type = OPERAND_TYPE_SYMBOL;
 		operand.flags = DEFAULT_OPERAND_FLAGS;
-		operand.symbol = $<text>1;
+		operand.symbol = $<id>1;
 		$$ = operand;
 	}
 	| MASK '(' SYMBOL ')' {
@@ -252,7 +260,7 @@ operand:
 		operand.type = OPERAND_TYPE_SYMBOL;
 		operand.flags = DEFAULT_OPERAND_FLAGS;
 		operand.flags.mask = $<mask>1;
-		operand.symbol = $<text>3;
+		operand.symbol = $<id>3;
 		$$ = operand;
 	}
 	;
@@ -260,7 +268,17 @@ operand:
 
 %%
 
-void yyerror(Statement** statements, const char* str) {
+void yyerror(YYLTYPE* location,
+	yyscan_t scanner,
+	Arena* arena,
+	String_Pool* string_pool,
+	Statement_List* statements,
+	const char* str) {
+	(void)arena;
+	(void)string_pool;
 	(void)statements;
-	fprintf(stderr, "Parser Error: %s\n", str);
+	// Errors are counted in the scanner state, since the error count kept by a
+	// pure parser is not visible outside of `yyparse`.
+	yyget_extra(scanner)->n_errors++;
+	fprintf(stderr, "Parser Error: Line %i: %s\n", location->first_line, str);
 }
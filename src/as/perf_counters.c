@@ -0,0 +1,204 @@
+/**
+ * @file perf_counters.c
+ * @author Anthony (ajxs [at] panoptic.online)
+ * @brief Functions for counting hardware events.
+ * Contains functions for opening, reading and closing the hardware performance
+ * counters with `perf_event_open`.
+ * @version 0.1
+ * @date 2019-03-09
+ */
+
+#include <errno.h>
+#include <linux/perf_event.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <as.h>
+#include <perf_counters.h>
+
+/**
+ * @brief Performance counter read type.
+ * The layout of a counter read with `PERF_FORMAT_TOTAL_TIME_ENABLED` and
+ * `PERF_FORMAT_TOTAL_TIME_RUNNING`.
+ */
+typedef struct {
+	uint64_t value;
+	uint64_t time_enabled;
+	uint64_t time_running;
+} Perf_Counter_Value;
+
+/** The name of each counter, as printed in the report. */
+static const char* const perf_counter_names[PERF_COUNTER_COUNT] = {
+	[PERF_COUNTER_CYCLES] = "cycles",
+	[PERF_COUNTER_INSTRUCTIONS] = "instructions",
+	[PERF_COUNTER_CACHE_REFERENCES] = "cache_references",
+	[PERF_COUNTER_CACHE_MISSES] = "cache_misses",
+	[PERF_COUNTER_BRANCHES] = "branches",
+	[PERF_COUNTER_BRANCH_MISSES] = "branch_misses"
+};
+
+/** The hardware event counted by each counter. */
+static const uint64_t perf_counter_events[PERF_COUNTER_COUNT] = {
+	[PERF_COUNTER_CYCLES] = PERF_COUNT_HW_CPU_CYCLES,
+	[PERF_COUNTER_INSTRUCTIONS] = PERF_COUNT_HW_INSTRUCTIONS,
+	[PERF_COUNTER_CACHE_REFERENCES] = PERF_COUNT_HW_CACHE_REFERENCES,
+	[PERF_COUNTER_CACHE_MISSES] = PERF_COUNT_HW_CACHE_MISSES,
+	[PERF_COUNTER_BRANCHES] = PERF_COUNT_HW_BRANCH_INSTRUCTIONS,
+	[PERF_COUNTER_BRANCH_MISSES] = PERF_COUNT_HW_BRANCH_MISSES
+};
+
+bool perf_counters_enabled = false;
+
+/**
+ * The counters which the kernel allowed to be opened. Each counter is
+ * available if the bit at its index is set.
+ */
+static uint32_t perf_counters_available = 0;
+
+
+/**
+ * @brief Opens a single counter for the calling thread.
+ * @param counter The counter to open.
+ * @return The counter's file descriptor, or -1 if it could not be opened.
+ */
+static int open_perf_counter(const Perf_Counter counter);
+
+
+/**
+ * open_perf_counter
+ */
+static int open_perf_counter(const Perf_Counter counter)
+{
+	/** The attributes of the counter. */
+	struct perf_event_attr attr;
+
+	memset(&attr, 0, sizeof(struct perf_event_attr));
+	attr.size = sizeof(struct perf_event_attr);
+	attr.type = PERF_TYPE_HARDWARE;
+	attr.config = perf_counter_events[counter];
+	attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED |
+		PERF_FORMAT_TOTAL_TIME_RUNNING;
+	// Count threads created during the span, such as second pass jobs.
+	attr.inherit = 1;
+	// Only user space is counted, which is allowed at the default paranoia.
+	attr.exclude_kernel = 1;
+	attr.exclude_hv = 1;
+
+	return syscall(SYS_perf_event_open, &attr, 0, -1, -1, PERF_FLAG_FD_CLOEXEC);
+}
+
+
+/**
+ * perf_counters_enable
+ */
+Assembler_Status perf_counters_enable(void)
+{
+	/** The counter being tested. */
+	int fd = -1;
+	/** The error of the first counter that could not be opened. */
+	int open_error = 0;
+
+	perf_counters_available = 0;
+	for(size_t i = 0; i < PERF_COUNTER_COUNT; i++) {
+		fd = open_perf_counter(i);
+		if(fd == -1) {
+			if(!open_error) {
+				open_error = errno;
+			}
+
+			continue;
+		}
+
+		perf_counters_available |= 1u << i;
+		close(fd);
+	}
+
+	if(!perf_counters_available) {
+		fprintf(stderr, "Warning: Performance counters are unavailable: %s\n",
+			strerror(open_error));
+		if(open_error == EACCES || open_error == EPERM) {
+			fprintf(stderr, "  Check `/proc/sys/kernel/perf_event_paranoid`.\n");
+		}
+
+		return ASSEMBLER_STATUS_BAD_INPUT;
+	}
+
+	for(size_t i = 0; i < PERF_COUNTER_COUNT; i++) {
+		if(!(perf_counters_available & (1u << i))) {
+			fprintf(stderr, "Warning: Performance counter `%s` is unavailable\n",
+				perf_counter_names[i]);
+		}
+	}
+
+	perf_counters_enabled = true;
+
+	return ASSEMBLER_STATUS_SUCCESS;
+}
+
+
+/**
+ * perf_counters_begin
+ */
+void perf_counters_begin(Perf_Counter_Group* group)
+{
+	if(!perf_counters_enabled) {
+		return;
+	}
+
+	for(size_t i = 0; i < PERF_COUNTER_COUNT; i++) {
+		group->fds[i] = -1;
+		if(perf_counters_available & (1u << i)) {
+			group->fds[i] = open_perf_counter(i);
+		}
+	}
+}
+
+
+/**
+ * perf_counters_end
+ */
+void perf_counters_end(Perf_Counter_Group* group,
+	Perf_Counts* counts)
+{
+	/** The value read from the current counter. */
+	Perf_Counter_Value value;
+
+	if(!perf_counters_enabled) {
+		return;
+	}
+
+	for(size_t i = 0; i < PERF_COUNTER_COUNT; i++) {
+		if(group->fds[i] == -1) {
+			continue;
+		}
+
+		if(read(group->fds[i], &value, sizeof(Perf_Counter_Value)) ==
+			sizeof(Perf_Counter_Value) && value.time_running > 0) {
+			// If the counter was multiplexed, estimate its count over the whole
+			// time it was enabled.
+			if(value.time_running < value.time_enabled) {
+				value.value = (uint64_t)((double)value.value *
+					value.time_enabled / value.time_running);
+			}
+
+			counts->counts[i] += value.value;
+			counts->counted |= 1u << i;
+		}
+
+		close(group->fds[i]);
+		group->fds[i] = -1;
+	}
+}
+
+
+/**
+ * perf_counter_name
+ */
+const char* perf_counter_name(const Perf_Counter counter)
+{
+	return perf_counter_names[counter];
+}
@@ -0,0 +1,256 @@
+/**
+ * @file scan.c
+ * @author Anthony (ajxs [at] panoptic.online)
+ * @brief Functions for scanning source text.
+ * Contains functions for quickly scanning source text for characters that are
+ * significant to the lexer.
+ * On x86 targets SSE2 and AVX2 implementations are provided. The implementation
+ * used is selected once, when the program is loaded, using GNU indirect
+ * functions. Other targets use the scalar implementation.
+ * @version 0.1
+ * @date 2019-03-09
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <scan.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define SCAN_VECTORISED 1
+#else
+#define SCAN_VECTORISED 0
+#endif
+
+
+/**
+ * @brief Tests whether a character is blank.
+ * @param c The character to test.
+ * @return Whether the character is a space or tab.
+ */
+static inline bool scan_is_blank(const char c)
+{
+	return (c == ' ') || (c == '\t');
+}
+
+
+/**
+ * scan_skip_blank_scalar
+ */
+const char* scan_skip_blank_scalar(const char* start,
+	const char* end)
+{
+	while(start < end && scan_is_blank(*start)) {
+		start++;
+	}
+
+	return start;
+}
+
+
+/**
+ * scan_find_newline_scalar
+ */
+const char* scan_find_newline_scalar(const char* start,
+	const char* end)
+{
+	while(start < end && *start != '\n') {
+		start++;
+	}
+
+	return start;
+}
+
+
+#if SCAN_VECTORISED == 1
+
+/**
+ * @brief Skips over blank characters 16 bytes at a time using SSE2.
+ */
+__attribute__((target("sse2")))
+static const char* scan_skip_blank_sse2(const char* start,
+	const char* end)
+{
+	const __m128i space = _mm_set1_epi8(' ');
+	const __m128i tab = _mm_set1_epi8('\t');
+
+	while(end - start >= 16) {
+		/** The chunk of input being tested. */
+		const __m128i chunk = _mm_loadu_si128((const __m128i*)start);
+		/** Each matching byte in the chunk is set to 0xFF. */
+		const __m128i blank = _mm_or_si128(_mm_cmpeq_epi8(chunk, space),
+			_mm_cmpeq_epi8(chunk, tab));
+		/** A bitmask with a bit set for each non-blank byte. */
+		const uint32_t mask = ~(uint32_t)_mm_movemask_epi8(blank) & 0xFFFF;
+
+		if(mask) {
+			return start + __builtin_ctz(mask);
+		}
+
+		start += 16;
+	}
+
+	return scan_skip_blank_scalar(start, end);
+}
+
+
+/**
+ * @brief Finds the next newline character 16 bytes at a time using SSE2.
+ */
+__attribute__((target("sse2")))
+static const char* scan_find_newline_sse2(const char* start,
+	const char* end)
+{
+	const __m128i newline = _mm_set1_epi8('\n');
+
+	while(end - start >= 16) {
+		/** The chunk of input being tested. */
+		const __m128i chunk = _mm_loadu_si128((const __m128i*)start);
+		/** A bitmask with a bit set for each newline byte. */
+		const uint32_t mask = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(chunk,
+			newline));
+
+		if(mask) {
+			return start + __builtin_ctz(mask);
+		}
+
+		start += 16;
+	}
+
+	return scan_find_newline_scalar(start, end);
+}
+
+
+/**
+ * @brief Skips over blank characters 32 bytes at a time using AVX2.
+ */
+__attribute__((target("avx2")))
+static const char* scan_skip_blank_avx2(const char* start,
+	const char* end)
+{
+	const __m256i space = _mm256_set1_epi8(' ');
+	const __m256i tab = _mm256_set1_epi8('\t');
+
+	while(end - start >= 32) {
+		/** The chunk of input being tested. */
+		const __m256i chunk = _mm256_loadu_si256((const __m256i*)start);
+		/** Each matching byte in the chunk is set to 0xFF. */
+		const __m256i blank = _mm256_or_si256(_mm256_cmpeq_epi8(chunk, space),
+			_mm256_cmpeq_epi8(chunk, tab));
+		/** A bitmask with a bit set for each non-blank byte. */
+		const uint32_t mask = ~(uint32_t)_mm256_movemask_epi8(blank);
+
+		if(mask) {
+			return start + __builtin_ctz(mask);
+		}
+
+		start += 32;
+	}
+
+	return scan_skip_blank_sse2(start, end);
+}
+
+
+/**
+ * @brief Finds the next newline character 32 bytes at a time using AVX2.
+ */
+__attribute__((target("avx2")))
+static const char* scan_find_newline_avx2(const char* start,
+	const char* end)
+{
+	const __m256i newline = _mm256_set1_epi8('\n');
+
+	while(end - start >= 32) {
+		/** The chunk of input being tested. */
+		const __m256i chunk = _mm256_loadu_si256((const __m256i*)start);
+		/** A bitmask with a bit set for each newline byte. */
+		const uint32_t mask = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk,
+			newline));
+
+		if(mask) {
+			return start + __builtin_ctz(mask);
+		}
+
+		start += 32;
+	}
+
+	return scan_find_newline_sse2(start, end);
+}
+
+
+/**
+ * @brief Selects the implementation of `scan_skip_blank`.
+ *
+ * Resolver for the `scan_skip_blank` indirect function. This is run once by the
+ * dynamic loader.
+ */
+static const char* (*resolve_scan_skip_blank(void))(const char*, const char*)
+{
+	__builtin_cpu_init();
+
+	if(__builtin_cpu_supports("avx2")) {
+		return scan_skip_blank_avx2;
+	} else if(__builtin_cpu_supports("sse2")) {
+		return scan_skip_blank_sse2;
+	}
+
+	return scan_skip_blank_scalar;
+}
+
+
+/**
+ * @brief Selects the implementation of `scan_find_newline`.
+ *
+ * Resolver for the `scan_find_newline` indirect function. This is run once by
+ * the dynamic loader.
+ */
+static const char* (*resolve_scan_find_newline(void))(const char*, const char*)
+{
+	__builtin_cpu_init();
+
+	if(__builtin_cpu_supports("avx2")) {
+		return scan_find_newline_avx2;
+	} else if(__builtin_cpu_supports("sse2")) {
+		return scan_find_newline_sse2;
+	}
+
+	return scan_find_newline_scalar;
+}
+
+
+/**
+ * scan_skip_blank
+ */
+const char* scan_skip_blank(const char* start,
+	const char* end) __attribute__((ifunc("resolve_scan_skip_blank")));
+
+
+/**
+ * scan_find_newline
+ */
+const char* scan_find_newline(const char* start,
+	const char* end) __attribute__((ifunc("resolve_scan_find_newline")));
+
+#else
+
+/**
+ * scan_skip_blank
+ */
+const char* scan_skip_blank(const char* start,
+	const char* end)
+{
+	return scan_skip_blank_scalar(start, end);
+}
+
+
+/**
+ * scan_find_newline
+ */
+const char* scan_find_newline(const char* start,
+	const char* end)
+{
+	return scan_find_newline_scalar(start, end);
+}
+
+#endif
@@ -13,8 +13,13 @@
 #include <stdlib.h>
 #include <string.h>
 #include <as.h>
-#include <encoding_entity.h>
 #include <section.h>
+#include <trace.h>
+
+/** The initial size of a section's data buffer. */
+#define SECTION_INITIAL_CAPACITY 0x1000
+/** The initial number of relocation entries a section can hold. */
+#define SECTION_INITIAL_RELOC_ENTRIES_CAPACITY 16
 
 
 /**
@@ -37,13 +42,42 @@ Assembler_Status create_section(Section** section,
 	(*section)->program_counter = 0;
 	(*section)->file_offset = 0;
 	(*section)->size = 0;
+	(*section)->capacity = 0;
+	(*section)->data = NULL;
+	(*section)->n_reloc_entries = 0;
+	(*section)->reloc_entries_capacity = 0;
+	(*section)->reloc_entries = NULL;
 	(*section)->flags = flags;
 	(*section)->link = 0;
 	(*section)->info = 0;
 	(*section)->type = type;
-	(*section)->encoding_entities = NULL;
+	(*section)->parent = NULL;
 	(*section)->next = NULL;
 
+	switch(type) {
+		case SHT_NULL:
+			(*section)->alignment = 0;
+			(*section)->entry_size = 0;
+			break;
+		case SHT_PROGBITS:
+		case SHT_NOBITS:
+			// Instructions and words are aligned to the MIPS word size.
+			(*section)->alignment = sizeof(uint32_t);
+			(*section)->entry_size = 0;
+			break;
+		case SHT_SYMTAB:
+			(*section)->alignment = sizeof(Elf32_Word);
+			(*section)->entry_size = sizeof(Elf32_Sym);
+			break;
+		case SHT_REL:
+			(*section)->alignment = sizeof(Elf32_Word);
+			(*section)->entry_size = sizeof(Elf32_Rel);
+			break;
+		default:
+			(*section)->alignment = 1;
+			(*section)->entry_size = 0;
+	}
+
 	return ASSEMBLER_STATUS_SUCCESS;
 }
 
@@ -136,46 +170,227 @@ ssize_t find_section_index(const Section* section_list,
 
 
 /**
- * section_add_encoding_entity
+ * section_reserve
  */
-Encoding_Entity* section_add_encoding_entity(Section* section,
-	const Encoding_Entity* entity)
+Assembler_Status section_reserve(Section* section,
+	const size_t capacity)
 {
-	if(!section) {
-		fprintf(stderr, "Error: Invalid section provided to add entity function.\n");
+	/** The resized data buffer. */
+	uint8_t* data = NULL;
 
-		return NULL;
+	if(capacity <= section->capacity) {
+		return ASSEMBLER_STATUS_SUCCESS;
+	}
+
+	if(section->parent) {
+		// A window's data belongs to its parent, and can not be resized.
+		fprintf(stderr, "Error: Data written past the end of window into section `%s`\n",
+			section->name);
+
+		return ASSEMBLER_ERROR_BAD_SECTION_DATA;
 	}
 
-	if(!entity) {
-		fprintf(stderr, "Error: Invalid entity provided to add entity function.\n");
+	data = realloc(section->data, capacity);
+	if(!data) {
+		fprintf(stderr, "Error: Error allocating data for section `%s`\n",
+			section->name);
 
-		return NULL;
+		return ASSEMBLER_ERROR_BAD_ALLOC;
+	}
+
+	section->data = data;
+	section->capacity = capacity;
+
+	return ASSEMBLER_STATUS_SUCCESS;
+}
+
+
+/**
+ * section_append
+ */
+uint8_t* section_append(Section* section,
+	const size_t size)
+{
+	/** The new capacity of the section's data buffer. */
+	size_t capacity = section->capacity;
+	/** The appended space. */
+	uint8_t* appended = NULL;
+
+	if(section->size + size > capacity) {
+		// Grow geometrically, so that appending is amortised constant time.
+		if(capacity < SECTION_INITIAL_CAPACITY) {
+			capacity = SECTION_INITIAL_CAPACITY;
+		}
+
+		while(capacity < section->size + size) {
+			capacity *= 2;
+		}
+
+		if(!get_status(section_reserve(section, capacity))) {
+			// Error message printed in callee.
+			return NULL;
+		}
+	}
+
+	appended = section->data + section->size;
+	section->size += size;
+
+	return appended;
+}
+
+
+/**
+ * section_write
+ */
+Assembler_Status section_write(Section* section,
+	const void* data,
+	const size_t size)
+{
+	/** The space in the section that the data is written to. */
+	uint8_t* destination = NULL;
+
+	if(size == 0) {
+		return ASSEMBLER_STATUS_SUCCESS;
+	}
+
+	destination = section_append(section, size);
+	if(!destination) {
+		// Error message printed in callee.
+		return ASSEMBLER_ERROR_BAD_ALLOC;
+	}
+
+	memcpy(destination, data, size);
+
+	return ASSEMBLER_STATUS_SUCCESS;
+}
+
+
+/**
+ * section_add_reloc_entry
+ */
+Assembler_Status section_add_reloc_entry(Section* section,
+	const String_Id symbol_name,
+	const size_t offset,
+	const uint32_t type)
+{
+	/** The new capacity of the relocation entry array. */
+	size_t capacity = section->reloc_entries_capacity;
+	/** The resized relocation entry array. */
+	Reloc_Entry* reloc_entries = NULL;
+
+	if(section->n_reloc_entries == capacity) {
+		capacity = capacity ? capacity * 2 : SECTION_INITIAL_RELOC_ENTRIES_CAPACITY;
+
+		reloc_entries = realloc(section->reloc_entries, sizeof(Reloc_Entry) * capacity);
+		if(!reloc_entries) {
+			fprintf(stderr, "Error: Error allocating relocation entries for section `%s`\n",
+				section->name);
+
+			return ASSEMBLER_ERROR_BAD_ALLOC;
+		}
+
+		section->reloc_entries = reloc_entries;
+		section->reloc_entries_capacity = capacity;
 	}
 
-#if DEBUG_ASSEMBLER == 1
-	printf("Debug Assembler: Adding encoded entity to `%s`...\n", section->name);
-#endif
+	section->reloc_entries[section->n_reloc_entries].symbol_name = symbol_name;
+	section->reloc_entries[section->n_reloc_entries].offset = offset;
+	section->reloc_entries[section->n_reloc_entries].type = type;
+	section->n_reloc_entries++;
 
-	if(!section->encoding_entities) {
-		// If there is no current head of the encoded entities linked list.
-		section->encoding_entities = (Encoding_Entity*)entity;
-		section->size += entity->size;
+	return ASSEMBLER_STATUS_SUCCESS;
+}
 
-		return section->encoding_entities;
+
+/**
+ * section_window
+ */
+void section_window(Section* window,
+	Section* section,
+	const size_t offset,
+	const size_t size)
+{
+	*window = *section;
+
+	window->program_counter = offset;
+	window->size = 0;
+	window->capacity = size;
+	window->data = section->data ? section->data + offset : NULL;
+	window->n_reloc_entries = 0;
+	window->reloc_entries_capacity = 0;
+	window->reloc_entries = NULL;
+	window->parent = section;
+	window->next = NULL;
+}
+
+
+/**
+ * free_section_window
+ */
+void free_section_window(Section* window)
+{
+	free(window->reloc_entries);
+	window->reloc_entries = NULL;
+	window->n_reloc_entries = 0;
+	window->reloc_entries_capacity = 0;
+}
+
+
+/**
+ * align_file_offset
+ */
+size_t align_file_offset(const size_t offset,
+	const size_t alignment)
+{
+	if(alignment <= 1) {
+		return offset;
 	}
 
-	// If there is an encoded entities linked list, append the new entity
-	// to the end of the list.
-	Encoding_Entity* current_entity = section->encoding_entities;
-	section->size += entity->size;
+	return (offset + (alignment - 1)) & ~(alignment - 1);
+}
+
+
+/**
+ * section_has_file_data
+ */
+bool section_has_file_data(const Section* section)
+{
+	return section->type != SHT_NULL && section->type != SHT_NOBITS;
+}
+
 
-	while(current_entity->next != NULL) {
-		current_entity = current_entity->next;
+/**
+ * layout_sections
+ */
+size_t layout_sections(Section* sections,
+	const size_t start)
+{
+	/** The offset into the file of the next section's data. */
+	size_t file_offset = start;
+	/** Pointer to the current section being placed. */
+	Section* curr_section = sections;
+
+	while(curr_section) {
+		if(curr_section->type == SHT_NULL) {
+			// The null section has no place in the file.
+			curr_section->file_offset = 0;
+		} else {
+			file_offset = align_file_offset(file_offset, curr_section->alignment);
+			curr_section->file_offset = file_offset;
+
+			if(section_has_file_data(curr_section)) {
+				file_offset += curr_section->size;
+			}
+		}
+
+		TRACE(TRACE_CHANNEL_OUTPUT,
+			"Debug Output: Placing section: `%s` with size: `0x%lx` at `0x%lx`...\n",
+			curr_section->name, curr_section->size, curr_section->file_offset);
+
+		curr_section = curr_section->next;
 	}
 
-	current_entity->next = (Encoding_Entity*)entity;
-	return current_entity->next;
+	return file_offset;
 }
 
 
@@ -194,18 +409,8 @@ void free_section(Section* section)
 		free_section(section->next);
 	}
 
-	if(section->encoding_entities) {
-#if DEBUG_ASSEMBLER == 1
-		printf("Debug Assembler: Freeing entities for section `%s`...\n", section->name);
-#endif
-		free_encoding_entity(section->encoding_entities);
-	} else {
-#if DEBUG_ASSEMBLER == 1
-		printf("Debug Assembler: No entities to cleanup for section `%s`...\n",
-			section->name);
-#endif
-	}
-
+	free(section->data);
+	free(section->reloc_entries);
 	free(section);
 }
 
@@ -15,48 +15,36 @@
 #include <instruction.h>
 #include <directive.h>
 #include <statement.h>
+#include <trace.h>
 
 
 /**
- * free_statement
+ * append_statement
  */
-void free_statement(Statement* statement)
+void append_statement(Statement_List* list,
+	Statement* statement)
 {
-	if(!statement) {
-		fprintf(stderr, "Error: Invalid statement provided to free function.\n");
-
-		return;
-	}
-
-	if(statement->next) {
-		free_statement(statement->next);
-	}
-
-	for(size_t i = 0; i < statement->n_labels; i++) {
-		free(statement->labels[i]);
-	}
-
-	free(statement->labels);
-
-	if(statement->type == STATEMENT_TYPE_DIRECTIVE) {
-		free_directive(&statement->directive);
-	} else if(statement->type == STATEMENT_TYPE_INSTRUCTION) {
-		free_instruction(&statement->instruction);
+	if(!list->head) {
+		list->head = statement;
+	} else {
+		list->tail->next = statement;
 	}
 
-	free(statement);
+	list->tail = statement;
+	list->n_statements++;
 }
 
 
 /**
  * print_directive
  */
-void print_directive(const Directive* directive)
+void print_directive(const Directive* directive,
+	const String_Pool* string_pool)
 {
 	const char* directive_name = get_directive_string(directive);
-	printf("  Directive: Type: `%s`\n", directive_name);
+	trace_printf("  Directive: Type: `%s`\n", directive_name);
 	if(directive->opseq.n_operands > 0) {
-		print_operand_sequence(&directive->opseq);
+		print_operand_sequence(&directive->opseq, string_pool);
 	}
 }
 
@@ -66,8 +54,10 @@ void print_directive(const Directive* directive)
  *
  * This function prints information about a statement entity.
  * @param statement The statement to print.
+ * @param string_pool The string pool containing any symbol names.
  */
-void print_statement(const Statement* statement)
+void print_statement(const Statement* statement,
+	const String_Pool* string_pool)
 {
 	if(!statement) {
 		fprintf(stderr, "Error: Invalid statement provided to print function\n");
@@ -75,17 +65,17 @@ void print_statement(const Statement* statement)
 		return;
 	}
 
-	printf("Debug Parser: Statement: Type: `%i`\n", statement->type);
+	trace_printf("Debug Parser: Statement: Type: `%i`\n", statement->type);
 	if(statement->n_labels > 0) {
-		printf("  Labels: `%zu`:\n", statement->n_labels);
+		trace_printf("  Labels: `%zu`:\n", statement->n_labels);
 		for(size_t i=0; i<statement->n_labels; i++) {
-			printf("    Label: `%s`\n", statement->labels[i]);
+			trace_printf("    Label: `%s`\n", string_pool_get(string_pool, statement->labels[i]));
 		}
 	}
 
 	if(statement->type == STATEMENT_TYPE_DIRECTIVE) {
-		print_directive(&statement->directive);
+		print_directive(&statement->directive, string_pool);
 	} else if(statement->type == STATEMENT_TYPE_INSTRUCTION) {
-		print_instruction(&statement->instruction);
+		print_instruction(&statement->instruction, string_pool);
 	}
 }
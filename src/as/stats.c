@@ -0,0 +1,658 @@
+/**
+ * @file stats.c
+ * @author Anthony (ajxs [at] panoptic.online)
+ * @brief Functions for recording assembly statistics.
+ * Contains functions for timing the assembler phases, for printing the
+ * recorded statistics, and for recording and writing trace events.
+ * @version 0.1
+ * @date 2019-03-09
+ */
+
+#include <inttypes.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+#include <time.h>
+#include <as.h>
+#include <perf_counters.h>
+#include <stats.h>
+
+/** The number of trace events that the event list initially holds. */
+#define TRACE_EVENT_LIST_INITIAL_SIZE 256
+
+/**
+ * @brief Trace event type.
+ * A single completed span. Times are in microseconds, relative to the opening
+ * of the trace event file. The strings are not owned by the event, and must
+ * outlive the trace event file.
+ */
+typedef struct {
+	const char* name;
+	const char* category;
+	const char* input_filename;
+	uint32_t thread_id;
+	double start_time;
+	double duration;
+} Trace_Event;
+
+/**
+ * @brief Trace event list type.
+ * The events recorded by every thread, guarded by a single lock. Events are
+ * only recorded at phase and job boundaries, so the lock is rarely contended.
+ */
+typedef struct {
+	pthread_mutex_t lock;
+	Trace_Event* events;
+	size_t n_events;
+	size_t size;
+	size_t n_dropped_events;
+	struct timespec epoch;
+	FILE* file;
+} Trace_Event_List;
+
+/** The name of each phase, as printed in the report. */
+static const char* const stats_phase_names[STATS_PHASE_COUNT] = {
+	[STATS_PHASE_READ] = "read",
+	[STATS_PHASE_PARSE] = "parse",
+	[STATS_PHASE_EXPAND_MACROS] = "expand_macros",
+	[STATS_PHASE_FIRST_PASS] = "first_pass",
+	[STATS_PHASE_SECOND_PASS] = "second_pass",
+	[STATS_PHASE_RELOCATIONS] = "relocations",
+	[STATS_PHASE_SYMTAB] = "symtab",
+	[STATS_PHASE_OUTPUT] = "output"
+};
+
+bool trace_events_enabled = false;
+
+/** The recorded trace events. */
+static Trace_Event_List trace_event_list = {
+	.lock = PTHREAD_MUTEX_INITIALIZER
+};
+
+/** The next trace event thread ID to assign. */
+static atomic_uint_fast32_t next_trace_event_thread_id = 1;
+
+/**
+ * The calling thread's ID in the trace events. Each thread is assigned an ID
+ * when it records its first event.
+ */
+static _Thread_local uint32_t trace_event_thread_id = 0;
+
+
+/**
+ * @brief Gets the time elapsed between two clock readings, in seconds.
+ * @param start The earlier reading.
+ * @param end The later reading.
+ * @return The elapsed time.
+ */
+static double get_elapsed_time(const struct timespec* start,
+	const struct timespec* end);
+
+/**
+ * @brief Records a trace event on the calling thread.
+ * @param timer The timer started at the beginning of the event.
+ * @param end_time The wall clock at the end of the event.
+ * @param name The name of the event.
+ * @param category The category of the event.
+ * @param input_filename The input file that the event belongs to.
+ */
+static void record_trace_event(const Stats_Timer* timer,
+	const struct timespec* end_time,
+	const char* name,
+	const char* category,
+	const char* input_filename);
+
+/**
+ * @brief Prints a string as a JSON string literal.
+ * @param file The file to print to.
+ * @param string The string to print.
+ */
+static void print_json_string(FILE* file,
+	const char* string);
+
+/**
+ * @brief Gets the ratio of two performance counters.
+ * @param counts The counted events.
+ * @param numerator The counter of the numerator.
+ * @param denominator The counter of the denominator.
+ * @param ratio A pointer to the resulting ratio.
+ * @return Whether both counters were counted, and the ratio is defined.
+ */
+static bool get_perf_ratio(const Perf_Counts* counts,
+	const Perf_Counter numerator,
+	const Perf_Counter denominator,
+	double* ratio);
+
+/**
+ * @brief Prints a performance counter ratio as a JSON value.
+ * @param counts The counted events.
+ * @param numerator The counter of the numerator.
+ * @param denominator The counter of the denominator.
+ */
+static void print_perf_ratio_json(const Perf_Counts* counts,
+	const Perf_Counter numerator,
+	const Perf_Counter denominator);
+
+/**
+ * @brief Prints the statistics of a single file as text.
+ * @param stats The statistics to print.
+ */
+static void print_stats_text(const Assembly_Stats* stats);
+
+/**
+ * @brief Prints the statistics of a single file as a JSON object.
+ * @param stats The statistics to print.
+ */
+static void print_stats_json(const Assembly_Stats* stats);
+
+
+/**
+ * get_elapsed_time
+ */
+static double get_elapsed_time(const struct timespec* start,
+	const struct timespec* end)
+{
+	return (double)(end->tv_sec - start->tv_sec) +
+		(double)(end->tv_nsec - start->tv_nsec) / 1e9;
+}
+
+
+/**
+ * parse_stats_format
+ */
+Assembler_Status parse_stats_format(const char* format_name,
+	Stats_Format* format)
+{
+	if(!format_name || strcmp(format_name, "text") == 0) {
+		*format = STATS_FORMAT_TEXT;
+	} else if(strcmp(format_name, "json") == 0) {
+		*format = STATS_FORMAT_JSON;
+	} else {
+		return ASSEMBLER_STATUS_BAD_INPUT;
+	}
+
+	return ASSEMBLER_STATUS_SUCCESS;
+}
+
+
+/**
+ * stats_begin_phase
+ */
+void stats_begin_phase(const Assembly_Stats* stats,
+	Stats_Timer* timer)
+{
+	if(!stats) {
+		return;
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &timer->wall_time);
+	clock_gettime(CLOCK_THREAD_CPUTIME_ID, &timer->cpu_time);
+	perf_counters_begin(&timer->perf_counters);
+}
+
+
+/**
+ * stats_end_phase
+ */
+void stats_end_phase(Assembly_Stats* stats,
+	const Stats_Phase phase,
+	Stats_Timer* timer)
+{
+	/** The wall clock at the end of the phase. */
+	struct timespec wall_time;
+	/** The CPU clock at the end of the phase. */
+	struct timespec cpu_time;
+	/** The process' resource usage at the end of the phase. */
+	struct rusage usage;
+
+	if(!stats) {
+		return;
+	}
+
+	perf_counters_end(&timer->perf_counters, &stats->phases[phase].perf_counts);
+	clock_gettime(CLOCK_MONOTONIC, &wall_time);
+	clock_gettime(CLOCK_THREAD_CPUTIME_ID, &cpu_time);
+
+	if(trace_events_enabled) {
+		record_trace_event(timer, &wall_time, stats_phase_names[phase], "phase",
+			stats->input_filename);
+	}
+
+	stats->phases[phase].wall_time += get_elapsed_time(&timer->wall_time,
+		&wall_time);
+	stats->phases[phase].cpu_time += get_elapsed_time(&timer->cpu_time,
+		&cpu_time);
+
+	if(getrusage(RUSAGE_SELF, &usage) == 0 &&
+		(size_t)usage.ru_maxrss > stats->phases[phase].peak_rss) {
+		stats->phases[phase].peak_rss = usage.ru_maxrss;
+	}
+}
+
+
+/**
+ * stats_add_cpu_time
+ */
+void stats_add_cpu_time(Assembly_Stats* stats,
+	const Stats_Phase phase,
+	const double cpu_time)
+{
+	if(!stats) {
+		return;
+	}
+
+	stats->phases[phase].cpu_time += cpu_time;
+}
+
+
+/**
+ * stats_get_thread_cpu_time
+ */
+double stats_get_thread_cpu_time(void)
+{
+	/** The calling thread's CPU clock. */
+	struct timespec cpu_time;
+
+	clock_gettime(CLOCK_THREAD_CPUTIME_ID, &cpu_time);
+
+	return (double)cpu_time.tv_sec + (double)cpu_time.tv_nsec / 1e9;
+}
+
+
+/**
+ * stats_begin_span
+ */
+void stats_begin_span(Stats_Timer* timer)
+{
+	if(!trace_events_enabled) {
+		return;
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &timer->wall_time);
+}
+
+
+/**
+ * stats_end_span
+ */
+void stats_end_span(const Stats_Timer* timer,
+	const char* name,
+	const char* category,
+	const char* input_filename)
+{
+	/** The wall clock at the end of the span. */
+	struct timespec wall_time;
+
+	if(!trace_events_enabled) {
+		return;
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &wall_time);
+	record_trace_event(timer, &wall_time, name, category, input_filename);
+}
+
+
+/**
+ * record_trace_event
+ */
+static void record_trace_event(const Stats_Timer* timer,
+	const struct timespec* end_time,
+	const char* name,
+	const char* category,
+	const char* input_filename)
+{
+	/** The resized event list, if it needs to grow. */
+	Trace_Event* events = NULL;
+	/** The new size of the event list. */
+	size_t size = 0;
+
+	if(trace_event_thread_id == 0) {
+		trace_event_thread_id = atomic_fetch_add(&next_trace_event_thread_id, 1);
+	}
+
+	pthread_mutex_lock(&trace_event_list.lock);
+
+	if(trace_event_list.n_events == trace_event_list.size) {
+		size = trace_event_list.size ? trace_event_list.size * 2 :
+			TRACE_EVENT_LIST_INITIAL_SIZE;
+		events = realloc(trace_event_list.events, sizeof(Trace_Event) * size);
+		if(!events) {
+			trace_event_list.n_dropped_events++;
+			goto UNLOCK;
+		}
+
+		trace_event_list.events = events;
+		trace_event_list.size = size;
+	}
+
+	trace_event_list.events[trace_event_list.n_events++] = (Trace_Event){
+		.name = name,
+		.category = category,
+		.input_filename = input_filename,
+		.thread_id = trace_event_thread_id,
+		.start_time = get_elapsed_time(&trace_event_list.epoch,
+			&timer->wall_time) * 1e6,
+		.duration = get_elapsed_time(&timer->wall_time, end_time) * 1e6
+	};
+
+UNLOCK:
+	pthread_mutex_unlock(&trace_event_list.lock);
+}
+
+
+/**
+ * open_trace_event_file
+ */
+Assembler_Status open_trace_event_file(const char* filename)
+{
+	if(!filename) {
+		return ASSEMBLER_ERROR_BAD_FUNCTION_ARGS;
+	}
+
+	trace_event_list.file = fopen(filename, "w");
+	if(!trace_event_list.file) {
+		fprintf(stderr, "Error: Error opening trace event file `%s`\n", filename);
+
+		return ASSEMBLER_ERROR_FILE_FAILURE;
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &trace_event_list.epoch);
+	trace_events_enabled = true;
+
+	return ASSEMBLER_STATUS_SUCCESS;
+}
+
+
+/**
+ * close_trace_event_file
+ */
+Assembler_Status close_trace_event_file(void)
+{
+	/** The file that the events are written to. */
+	FILE* file = trace_event_list.file;
+	/** The status of closing the file. */
+	Assembler_Status status = ASSEMBLER_STATUS_SUCCESS;
+
+	if(!file) {
+		return ASSEMBLER_ERROR_BAD_FUNCTION_ARGS;
+	}
+
+	trace_events_enabled = false;
+
+	fprintf(file, "{\"traceEvents\":[");
+	for(size_t i = 0; i < trace_event_list.n_events; i++) {
+		/** The event being written. */
+		const Trace_Event* event = &trace_event_list.events[i];
+
+		fprintf(file, "%s\n{\"name\":", i ? "," : "");
+		print_json_string(file, event->name);
+		fprintf(file, ",\"cat\":");
+		print_json_string(file, event->category);
+		fprintf(file, ",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,"
+			"\"dur\":%.3f,\"args\":{\"file\":", event->thread_id,
+			event->start_time, event->duration);
+		print_json_string(file, event->input_filename);
+		fprintf(file, "}}");
+	}
+
+	fprintf(file, "\n],\"displayTimeUnit\":\"ms\"}\n");
+
+	if(ferror(file)) {
+		fprintf(stderr, "Error: Error writing trace event file\n");
+		status = ASSEMBLER_ERROR_FILE_FAILURE;
+	}
+
+	if(fclose(file) != 0) {
+		status = ASSEMBLER_ERROR_FILE_FAILURE;
+	}
+
+	if(trace_event_list.n_dropped_events) {
+		fprintf(stderr, "Warning: `%zu` trace events were dropped\n",
+			trace_event_list.n_dropped_events);
+	}
+
+	free(trace_event_list.events);
+	trace_event_list.events = NULL;
+	trace_event_list.n_events = 0;
+	trace_event_list.size = 0;
+	trace_event_list.n_dropped_events = 0;
+	trace_event_list.file = NULL;
+
+	return status;
+}
+
+
+/**
+ * stats_count_lines
+ */
+void stats_count_lines(Assembly_Stats* stats,
+	const char* buffer,
+	const size_t buffer_size)
+{
+	/** The end of the input buffer. */
+	const char* end = buffer + buffer_size;
+	/** The start of the current line. */
+	const char* line = buffer;
+
+	if(!stats) {
+		return;
+	}
+
+	stats->n_lines = 0;
+	while(line < end) {
+		stats->n_lines++;
+
+		line = memchr(line, '\n', end - line);
+		if(!line) {
+			break;
+		}
+
+		line++;
+	}
+}
+
+
+/**
+ * print_json_string
+ */
+static void print_json_string(FILE* file,
+	const char* string)
+{
+	fputc('"', file);
+
+	for(const unsigned char* c = (const unsigned char*)string; *c; c++) {
+		if(*c == '"' || *c == '\\') {
+			fprintf(file, "\\%c", *c);
+		} else if(*c < 0x20) {
+			fprintf(file, "\\u%04x", *c);
+		} else {
+			fputc(*c, file);
+		}
+	}
+
+	fputc('"', file);
+}
+
+
+/**
+ * get_perf_ratio
+ */
+static bool get_perf_ratio(const Perf_Counts* counts,
+	const Perf_Counter numerator,
+	const Perf_Counter denominator,
+	double* ratio)
+{
+	if(!(counts->counted & (1u << numerator)) ||
+		!(counts->counted & (1u << denominator)) ||
+		counts->counts[denominator] == 0) {
+		return false;
+	}
+
+	*ratio = (double)counts->counts[numerator] /
+		(double)counts->counts[denominator];
+
+	return true;
+}
+
+
+/**
+ * print_perf_ratio_json
+ */
+static void print_perf_ratio_json(const Perf_Counts* counts,
+	const Perf_Counter numerator,
+	const Perf_Counter denominator)
+{
+	/** The ratio of the counters. */
+	double ratio = 0;
+
+	if(get_perf_ratio(counts, numerator, denominator, &ratio)) {
+		printf("%.6f", ratio);
+	} else {
+		printf("null");
+	}
+}
+
+
+/**
+ * print_stats_text
+ */
+static void print_stats_text(const Assembly_Stats* stats)
+{
+	printf("Statistics for `%s`:\n", stats->input_filename);
+	printf("  %-16s %12s %12s %16s\n", "Phase", "Wall (ms)", "CPU (ms)",
+		"Peak RSS (KiB)");
+
+	for(size_t i = 0; i < STATS_PHASE_COUNT; i++) {
+		printf("  %-16s %12.3f %12.3f %16zu\n", stats_phase_names[i],
+			stats->phases[i].wall_time * 1e3, stats->phases[i].cpu_time * 1e3,
+			stats->phases[i].peak_rss);
+	}
+
+	if(perf_counters_enabled) {
+		printf("  %-16s %12s %16s %16s\n", "Phase", "IPC", "Cache miss (%)",
+			"Branch miss (%)");
+
+		for(size_t i = 0; i < STATS_PHASE_COUNT; i++) {
+			/** The counted events of the phase. */
+			const Perf_Counts* counts = &stats->phases[i].perf_counts;
+			/** The ratio of each column. */
+			double ratio = 0;
+
+			printf("  %-16s", stats_phase_names[i]);
+
+			if(get_perf_ratio(counts, PERF_COUNTER_INSTRUCTIONS,
+				PERF_COUNTER_CYCLES, &ratio)) {
+				printf(" %12.3f", ratio);
+			} else {
+				printf(" %12s", "n/a");
+			}
+
+			if(get_perf_ratio(counts, PERF_COUNTER_CACHE_MISSES,
+				PERF_COUNTER_CACHE_REFERENCES, &ratio)) {
+				printf(" %16.3f", ratio * 100);
+			} else {
+				printf(" %16s", "n/a");
+			}
+
+			if(get_perf_ratio(counts, PERF_COUNTER_BRANCH_MISSES,
+				PERF_COUNTER_BRANCHES, &ratio)) {
+				printf(" %16.3f\n", ratio * 100);
+			} else {
+				printf(" %16s\n", "n/a");
+			}
+		}
+	}
+
+	printf("  Lines: `%zu`\n", stats->n_lines);
+	printf("  Statements: `%zu`\n", stats->n_statements);
+	printf("  Symbols: `%zu`\n", stats->n_symbols);
+	printf("  Relocations: `%zu`\n", stats->n_relocations);
+	printf("  Encoded bytes: `%zu`\n", stats->n_encoded_bytes);
+	printf("  Arena allocations: `%zu`\n", stats->n_arena_allocations);
+	printf("  Arena blocks: `%zu`\n", stats->n_arena_blocks);
+	printf("  Arena bytes: `%zu`\n", stats->n_arena_bytes);
+}
+
+
+/**
+ * print_stats_json
+ */
+static void print_stats_json(const Assembly_Stats* stats)
+{
+	printf("{\"input\":");
+	print_json_string(stdout, stats->input_filename);
+
+	printf(",\"phases\":{");
+	for(size_t i = 0; i < STATS_PHASE_COUNT; i++) {
+		/** The counted events of the phase. */
+		const Perf_Counts* counts = &stats->phases[i].perf_counts;
+
+		printf("%s\"%s\":{\"wall_ms\":%.6f,\"cpu_ms\":%.6f,\"peak_rss_kb\":%zu",
+			i ? "," : "", stats_phase_names[i], stats->phases[i].wall_time * 1e3,
+			stats->phases[i].cpu_time * 1e3, stats->phases[i].peak_rss);
+
+		if(perf_counters_enabled) {
+			printf(",\"perf\":{");
+			for(size_t c = 0; c < PERF_COUNTER_COUNT; c++) {
+				printf("\"%s\":", perf_counter_name(c));
+				if(counts->counted & (1u << c)) {
+					printf("%" PRIu64 ",", counts->counts[c]);
+				} else {
+					printf("null,");
+				}
+			}
+
+			printf("\"ipc\":");
+			print_perf_ratio_json(counts, PERF_COUNTER_INSTRUCTIONS,
+				PERF_COUNTER_CYCLES);
+			printf(",\"cache_miss_rate\":");
+			print_perf_ratio_json(counts, PERF_COUNTER_CACHE_MISSES,
+				PERF_COUNTER_CACHE_REFERENCES);
+			printf(",\"branch_miss_rate\":");
+			print_perf_ratio_json(counts, PERF_COUNTER_BRANCH_MISSES,
+				PERF_COUNTER_BRANCHES);
+			putchar('}');
+		}
+
+		putchar('}');
+	}
+
+	printf("},\"counters\":{\"lines\":%zu,\"statements\":%zu,\"symbols\":%zu,"
+		"\"relocations\":%zu,\"encoded_bytes\":%zu,\"arena_allocations\":%zu,"
+		"\"arena_blocks\":%zu,\"arena_bytes\":%zu}}",
+		stats->n_lines, stats->n_statements, stats->n_symbols,
+		stats->n_relocations, stats->n_encoded_bytes, stats->n_arena_allocations,
+		stats->n_arena_blocks, stats->n_arena_bytes);
+}
+
+
+/**
+ * print_assembly_stats
+ */
+void print_assembly_stats(const Assembly_Stats* stats,
+	const size_t n_files,
+	const Stats_Format format)
+{
+	if(format == STATS_FORMAT_JSON) {
+		printf("{\"files\":[");
+		for(size_t i = 0; i < n_files; i++) {
+			if(i) {
+				putchar(',');
+			}
+
+			print_stats_json(&stats[i]);
+		}
+
+		printf("]}\n");
+	} else {
+		for(size_t i = 0; i < n_files; i++) {
+			print_stats_text(&stats[i]);
+		}
+	}
+}
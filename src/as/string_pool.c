@@ -0,0 +1,285 @@
+/**
+ * @file string_pool.c
+ * @author Anthony (ajxs [at] panoptic.online)
+ * @brief Functions for working with the string pool.
+ * Contains functions for interning strings and retrieving interned strings.
+ * @version 0.1
+ * @date 2019-03-09
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <as.h>
+#include <string_pool.h>
+
+/** The initial size of the string pool data. */
+#define STRING_POOL_INITIAL_CAPACITY 0x4000
+/** The initial number of slots in the string pool index. */
+#define STRING_POOL_INITIAL_INDEX_CAPACITY 256
+
+
+/**
+ * @brief Hashes a string.
+ *
+ * Computes the 32-bit FNV-1a hash of a string.
+ * @param string The string to hash.
+ * @param length The length of the string.
+ * @return The hash of the string.
+ */
+static uint32_t string_pool_hash(const char* string,
+	const size_t length);
+
+/**
+ * @brief Resizes the string pool index.
+ *
+ * Resizes the string pool index, reinserting every interned string.
+ * @param string_pool A pointer to the string pool.
+ * @param index_capacity The new number of slots in the index. This must be a
+ * power of two.
+ * @return A status entity indicating whether or not the resize was successful.
+ */
+static Assembler_Status string_pool_resize_index(String_Pool* string_pool,
+	const size_t index_capacity);
+
+
+/**
+ * string_pool_hash
+ */
+static uint32_t string_pool_hash(const char* string,
+	const size_t length)
+{
+	/** The running hash value. */
+	uint32_t hash = 0x811C9DC5;
+
+	for(size_t i = 0; i < length; i++) {
+		hash ^= (uint8_t)string[i];
+		hash *= 0x01000193;
+	}
+
+	return hash;
+}
+
+
+/**
+ * string_pool_resize_index
+ */
+static Assembler_Status string_pool_resize_index(String_Pool* string_pool,
+	const size_t index_capacity)
+{
+	/** Mask used to wrap slot numbers to the size of the index. */
+	const size_t mask = index_capacity - 1;
+	/** The resized index. */
+	String_Id* index = calloc(index_capacity, sizeof(String_Id));
+	/** The hashes of the strings in each slot of the resized index. */
+	uint32_t* index_hashes = malloc(index_capacity * sizeof(uint32_t));
+	/** The slot currently being probed. */
+	size_t slot = 0;
+
+	if(!index || !index_hashes) {
+		fprintf(stderr, "Error: Error resizing string pool index\n");
+		free(index);
+		free(index_hashes);
+
+		return ASSEMBLER_ERROR_BAD_ALLOC;
+	}
+
+	// The stored hashes are used to reinsert each string, so the strings
+	// themselves are never rehashed.
+	for(size_t i = 0; i < string_pool->index_capacity; i++) {
+		if(string_pool->index[i] != 0) {
+			slot = string_pool->index_hashes[i] & mask;
+			while(index[slot] != 0) {
+				slot = (slot + 1) & mask;
+			}
+
+			index[slot] = string_pool->index[i];
+			index_hashes[slot] = string_pool->index_hashes[i];
+		}
+	}
+
+	free(string_pool->index);
+	free(string_pool->index_hashes);
+	string_pool->index = index;
+	string_pool->index_hashes = index_hashes;
+	string_pool->index_capacity = index_capacity;
+
+	return ASSEMBLER_STATUS_SUCCESS;
+}
+
+
+/**
+ * initialise_string_pool
+ */
+Assembler_Status initialise_string_pool(String_Pool* string_pool)
+{
+	/** Holds the success status of internal operations. */
+	Assembler_Status status = ASSEMBLER_STATUS_SUCCESS;
+
+	if(!string_pool) {
+		fprintf(stderr, "Error: Invalid string pool provided to initialise function\n");
+
+		return ASSEMBLER_ERROR_BAD_FUNCTION_ARGS;
+	}
+
+	string_pool->size = 0;
+	string_pool->capacity = 0;
+	string_pool->n_strings = 0;
+	string_pool->index_capacity = 0;
+	string_pool->index = NULL;
+	string_pool->index_hashes = NULL;
+
+	string_pool->data = malloc(STRING_POOL_INITIAL_CAPACITY);
+	if(!string_pool->data) {
+		fprintf(stderr, "Error: Error allocating string pool\n");
+
+		return ASSEMBLER_ERROR_BAD_ALLOC;
+	}
+
+	string_pool->capacity = STRING_POOL_INITIAL_CAPACITY;
+
+	// The empty string is always present, at offset zero.
+	string_pool->data[0] = '\0';
+	string_pool->size = 1;
+	string_pool->n_strings = 1;
+
+	status = string_pool_resize_index(string_pool, STRING_POOL_INITIAL_INDEX_CAPACITY);
+	if(!get_status(status)) {
+		// Error message will have been printed by the callee.
+		free_string_pool(string_pool);
+
+		return status;
+	}
+
+	return ASSEMBLER_STATUS_SUCCESS;
+}
+
+
+/**
+ * string_pool_intern
+ */
+Assembler_Status string_pool_intern(String_Pool* string_pool,
+	const char* string,
+	const size_t length,
+	String_Id* id)
+{
+	/** Holds the success status of internal operations. */
+	Assembler_Status status = ASSEMBLER_STATUS_SUCCESS;
+	/** The hash of the string being interned. */
+	const uint32_t hash = string_pool_hash(string, length);
+	/** Mask used to wrap slot numbers to the size of the index. */
+	size_t mask = string_pool->index_capacity - 1;
+	/** The slot currently being probed. */
+	size_t slot = hash & mask;
+	/** The size of the data after the string has been added. */
+	size_t required_capacity = string_pool->size + length + 1;
+	/** The new capacity of the data, if it needs to be resized. */
+	size_t capacity = string_pool->capacity;
+	/** Used to track the result of resizing the data. */
+	char* resized_data = NULL;
+
+	if(length == 0) {
+		*id = 0;
+
+		return ASSEMBLER_STATUS_SUCCESS;
+	}
+
+	// Collisions are resolved by linear probing. The stored hashes are compared
+	// first, so that strings are only compared when they are likely to match.
+	while(string_pool->index[slot] != 0) {
+		if(string_pool->index_hashes[slot] == hash &&
+			strncmp(string_pool->data + string_pool->index[slot], string, length) == 0 &&
+			string_pool->data[string_pool->index[slot] + length] == '\0') {
+			*id = string_pool->index[slot];
+
+			return ASSEMBLER_STATUS_SUCCESS;
+		}
+
+		slot = (slot + 1) & mask;
+	}
+
+	if(required_capacity > UINT32_MAX) {
+		fprintf(stderr, "Error: String pool capacity exceeded\n");
+
+		return ASSEMBLER_ERROR_BAD_ALLOC;
+	}
+
+	if(required_capacity > string_pool->capacity) {
+		while(required_capacity > capacity) {
+			capacity *= 2;
+		}
+
+		resized_data = realloc(string_pool->data, capacity);
+		if(!resized_data) {
+			fprintf(stderr, "Error: Error resizing string pool\n");
+
+			return ASSEMBLER_ERROR_BAD_ALLOC;
+		}
+
+		string_pool->data = resized_data;
+		string_pool->capacity = capacity;
+	}
+
+	*id = (String_Id)string_pool->size;
+	memcpy(string_pool->data + string_pool->size, string, length);
+	string_pool->data[string_pool->size + length] = '\0';
+	string_pool->size += length + 1;
+	string_pool->n_strings++;
+
+	// Keep the load factor of the index at or below one half, so that probe
+	// sequences remain short.
+	if(string_pool->n_strings * 2 > string_pool->index_capacity) {
+		status = string_pool_resize_index(string_pool, string_pool->index_capacity * 2);
+		if(!get_status(status)) {
+			// Error message will have been printed by the callee.
+			return status;
+		}
+
+		mask = string_pool->index_capacity - 1;
+		slot = hash & mask;
+		while(string_pool->index[slot] != 0) {
+			slot = (slot + 1) & mask;
+		}
+	}
+
+	string_pool->index[slot] = *id;
+	string_pool->index_hashes[slot] = hash;
+
+	return ASSEMBLER_STATUS_SUCCESS;
+}
+
+
+/**
+ * string_pool_get
+ */
+const char* string_pool_get(const String_Pool* string_pool,
+	const String_Id id)
+{
+	return string_pool->data + id;
+}
+
+
+/**
+ * free_string_pool
+ */
+void free_string_pool(String_Pool* string_pool)
+{
+	if(!string_pool) {
+		fprintf(stderr, "Error: Invalid string pool provided to free function\n");
+
+		return;
+	}
+
+	free(string_pool->data);
+	free(string_pool->index);
+	free(string_pool->index_hashes);
+
+	string_pool->data = NULL;
+	string_pool->size = 0;
+	string_pool->capacity = 0;
+	string_pool->n_strings = 0;
+	string_pool->index = NULL;
+	string_pool->index_hashes = NULL;
+	string_pool->index_capacity = 0;
+}
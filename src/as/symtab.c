@@ -14,6 +14,249 @@
 #include <as.h>
 #include <section.h>
 #include <symtab.h>
+#include <trace.h>
+
+/** The initial number of symbols the symbol table has room for. */
+#define SYMTAB_INITIAL_CAPACITY 32
+/** The initial number of slots in the symbol table index. */
+#define SYMTAB_INITIAL_INDEX_CAPACITY 64
+
+
+/**
+ * @brief Hashes a symbol name.
+ *
+ * Computes the hash of an interned symbol name. Since interned names are equal
+ * only if their identifiers are equal, the identifier itself is hashed.
+ * @param name The interned symbol name to hash.
+ * @return The hash of the symbol name.
+ */
+static uint32_t symtab_hash_name(const String_Id name);
+
+/**
+ * @brief Inserts a symbol into the symbol table index.
+ *
+ * Inserts a symbol into the first free slot of its probe sequence in the symbol
+ * table index. The index must contain at least one free slot.
+ * @param symtab A pointer to the symbol table.
+ * @param symbol_index The index of the symbol in the symbol array.
+ */
+static void symtab_index_insert(Symbol_Table* symtab,
+	const size_t symbol_index);
+
+/**
+ * @brief Resizes the symbol table index.
+ *
+ * Resizes the symbol table index, reinserting every symbol in the table.
+ * Symbols are reinserted in the order in which they were added, so that the
+ * first symbol added with any given name is always found first.
+ * @param symtab A pointer to the symbol table.
+ * @param index_capacity The new number of slots in the index. This must be a
+ * power of two.
+ * @return A status entity indicating whether or not the resize was successful.
+ */
+static Assembler_Status symtab_resize_index(Symbol_Table* symtab,
+	const size_t index_capacity);
+
+/**
+ * @brief Finds a symbol's slot in the symbol table index.
+ *
+ * Searches the symbol table index for the first symbol whose name matches the
+ * supplied name exactly.
+ * @param symtab A pointer to the symbol table.
+ * @param name The name of the symbol to search for.
+ * @return The index of the matching symbol in the symbol array, or -1 if none
+ * exists.
+ */
+static ssize_t symtab_index_find(const Symbol_Table* symtab,
+	const String_Id name);
+
+
+/**
+ * symtab_hash_name
+ */
+static uint32_t symtab_hash_name(const String_Id name)
+{
+	// Fibonacci hashing. The multiplication spreads the identifiers, which are
+	// offsets into the string pool, across all of the hash bits.
+	return (uint32_t)(name * 0x9E3779B1u) ^ (name >> 16);
+}
+
+
+/**
+ * symtab_index_insert
+ */
+static void symtab_index_insert(Symbol_Table* symtab,
+	const size_t symbol_index)
+{
+	/** Mask used to wrap slot numbers to the size of the index. */
+	const size_t mask = symtab->index_capacity - 1;
+	/** The slot currently being probed. */
+	size_t slot = symtab->symbols[symbol_index].name_hash & mask;
+
+	// Collisions are resolved by linear probing.
+	while(symtab->index[slot] != 0) {
+		slot = (slot + 1) & mask;
+	}
+
+	symtab->index[slot] = symbol_index + 1;
+}
+
+
+/**
+ * symtab_resize_index
+ */
+static Assembler_Status symtab_resize_index(Symbol_Table* symtab,
+	const size_t index_capacity)
+{
+	/** The resized index. */
+	size_t* index = calloc(index_capacity, sizeof(size_t));
+	if(!index) {
+		fprintf(stderr, "Error: Error resizing symbol table index\n");
+
+		return ASSEMBLER_ERROR_BAD_ALLOC;
+	}
+
+	free(symtab->index);
+	symtab->index = index;
+	symtab->index_capacity = index_capacity;
+
+	for(size_t i = 0; i < symtab->n_entries; i++) {
+		symtab_index_insert(symtab, i);
+	}
+
+	return ASSEMBLER_STATUS_SUCCESS;
+}
+
+
+/**
+ * symtab_index_find
+ */
+static ssize_t symtab_index_find(const Symbol_Table* symtab,
+	const String_Id name)
+{
+	/** The hash of the name being searched for. */
+	const uint32_t name_hash = symtab_hash_name(name);
+	/** Mask used to wrap slot numbers to the size of the index. */
+	const size_t mask = symtab->index_capacity - 1;
+	/** The slot currently being probed. */
+	size_t slot = name_hash & mask;
+	/** The symbol referenced by the current slot. */
+	const Symbol* symbol = NULL;
+
+	if(!symtab->index) {
+		return -1;
+	}
+
+	while(symtab->index[slot] != 0) {
+		symbol = &symtab->symbols[symtab->index[slot] - 1];
+		if(symbol->name == name) {
+			return symtab->index[slot] - 1;
+		}
+
+		slot = (slot + 1) & mask;
+	}
+
+	return -1;
+}
+
+
+/**
+ * symtab_reserve
+ */
+Assembler_Status symtab_reserve(Symbol_Table* symtab,
+	const size_t n_entries)
+{
+	/** Holds the success status of internal operations. */
+	Assembler_Status status = ASSEMBLER_STATUS_SUCCESS;
+	/** The number of slots needed to hold the symbols at the maximum load factor. */
+	size_t index_capacity = SYMTAB_INITIAL_INDEX_CAPACITY;
+	/** Used to track the result of resizing the symbol array. */
+	Symbol* resized_symbols = NULL;
+
+	if(!symtab) {
+		fprintf(stderr, "Error: Invalid symbol table provided to reserve function\n");
+
+		return ASSEMBLER_ERROR_BAD_FUNCTION_ARGS;
+	}
+
+	if(n_entries > symtab->capacity) {
+		resized_symbols = realloc(symtab->symbols, sizeof(Symbol) * n_entries);
+		if(!resized_symbols) {
+			fprintf(stderr, "Error: Error resizing symbol table array\n");
+
+			return ASSEMBLER_ERROR_BAD_ALLOC;
+		}
+
+		symtab->symbols = resized_symbols;
+		symtab->capacity = n_entries;
+	}
+
+	if(symtab->index_capacity > index_capacity) {
+		index_capacity = symtab->index_capacity;
+	}
+
+	// Keep the load factor of the index at or below one half, so that probe
+	// sequences remain short.
+	while(n_entries * 2 > index_capacity) {
+		index_capacity *= 2;
+	}
+
+	if(index_capacity != symtab->index_capacity) {
+		status = symtab_resize_index(symtab, index_capacity);
+		if(!get_status(status)) {
+			// Error message will have been printed by the callee.
+			return status;
+		}
+	}
+
+	return ASSEMBLER_STATUS_SUCCESS;
+}
+
+
+/**
+ * initialise_symbol_table
+ */
+Assembler_Status initialise_symbol_table(Symbol_Table* symtab,
+	const String_Pool* string_pool)
+{
+	/** Holds the success status of internal operations. */
+	Assembler_Status status = ASSEMBLER_STATUS_SUCCESS;
+
+	if(!symtab) {
+		fprintf(stderr, "Error: Invalid symbol table provided to initialise function\n");
+
+		return ASSEMBLER_ERROR_BAD_FUNCTION_ARGS;
+	}
+
+	symtab->string_pool = string_pool;
+	symtab->n_entries = 0;
+	symtab->capacity = 0;
+	symtab->symbols = NULL;
+	symtab->index_capacity = 0;
+	symtab->index = NULL;
+
+	// Initialise with room for the null symbol entry.
+	status = symtab_reserve(symtab, SYMTAB_INITIAL_CAPACITY);
+	if(!get_status(status)) {
+		// Error message will have been printed by the callee.
+		free_symbol_table(symtab);
+
+		return status;
+	}
+
+	// Create the null symbol entry.
+	// This is required as per ELF specification.
+	// The empty string is used as its name, so as to not disrupt other
+	// processes that require handling of this string.
+	symtab->symbols[0].name = 0;
+	symtab->symbols[0].name_hash = symtab_hash_name(symtab->symbols[0].name);
+	symtab->symbols[0].section = NULL;
+	symtab->symbols[0].offset = 0;
+	symtab->n_entries = 1;
+	symtab_index_insert(symtab, 0);
+
+	return ASSEMBLER_STATUS_SUCCESS;
+}
 
 
 /**
@@ -27,11 +270,14 @@ void free_symbol_table(Symbol_Table* symtab)
 		return;
 	}
 
-	for(size_t i = 0; i < symtab->n_entries; i++) {
-		free(symtab->symbols[i].name);
-	}
-
 	free(symtab->symbols);
+	free(symtab->index);
+
+	symtab->n_entries = 0;
+	symtab->capacity = 0;
+	symtab->symbols = NULL;
+	symtab->index_capacity = 0;
+	symtab->index = NULL;
 }
 
 
@@ -48,9 +294,10 @@ void print_symbol_table(const Symbol_Table* symbol_table)
 	for(size_t i = 0; i < symbol_table->n_entries; i++) {
 		if(symbol_table->symbols[i].section) {
 			// Allow for null symbol entry.
-			printf("  Symbol: `%s`", symbol_table->symbols[i].name);
-			printf(" in section `%s`", symbol_table->symbols[i].section->name);
-			printf(" at `%#zx`\n", symbol_table->symbols[i].offset);
+			trace_printf("  Symbol: `%s`", string_pool_get(symbol_table->string_pool,
+				symbol_table->symbols[i].name));
+			trace_printf(" in section `%s`", symbol_table->symbols[i].section->name);
+			trace_printf(" at `%#zx`\n", symbol_table->symbols[i].offset);
 		}
 	}
 }
@@ -60,40 +307,46 @@ void print_symbol_table(const Symbol_Table* symbol_table)
  * symtab_add_symbol
  */
 Symbol* symtab_add_symbol(Symbol_Table* symtab,
-	char* name,
+	const String_Id name,
 	const Section* section,
 	const size_t offset)
 {
+	/** Holds the success status of internal operations. */
+	Assembler_Status status = ASSEMBLER_STATUS_SUCCESS;
+
 	if(!symtab) {
 		fprintf(stderr, "Error: Invalid symbol table provided to add symbol function\n");
 		return NULL;
 	}
 
-	if(!name) {
-		fprintf(stderr, "Error: Invalid symbol provided to add symbol function\n");
-		return NULL;
-	}
-
 	if(!section) {
 		fprintf(stderr, "Error: Invalid section data provided to add symbol function\n");
 		return NULL;
 	}
 
-	symtab->n_entries++;
-	symtab->symbols = realloc(symtab->symbols, sizeof(Symbol) * symtab->n_entries);
-	if(!symtab->symbols) {
-		fprintf(stderr, "Error: Error resizing symbol table array\n");
-		return NULL;
+	// Grow geometrically, so that the cost of copying the array is amortised
+	// over all insertions.
+	if(symtab->n_entries == symtab->capacity) {
+		status = symtab_reserve(symtab, symtab->capacity ?
+			symtab->capacity * 2 : SYMTAB_INITIAL_CAPACITY);
+		if(!get_status(status)) {
+			// Error message will have been printed by the callee.
+			return NULL;
+		}
 	}
 
-	symtab->symbols[symtab->n_entries - 1].name = strdup(name);
+	symtab->n_entries++;
+
+	symtab->symbols[symtab->n_entries - 1].name = name;
+	symtab->symbols[symtab->n_entries - 1].name_hash = symtab_hash_name(name);
 	symtab->symbols[symtab->n_entries - 1].section = section;
 	symtab->symbols[symtab->n_entries - 1].offset = offset;
 
-#if DEBUG_SYMBOLS == 1
-	printf("Debug Assembler: Added symbol `%s` in section `%s` at `%#zx`\n",
-		name, section->name, offset);
-#endif
+	symtab_index_insert(symtab, symtab->n_entries - 1);
+
+	TRACE(TRACE_CHANNEL_SYMBOLS,
+		"Debug Assembler: Added symbol `%s` in section `%s` at `%#zx`\n",
+		string_pool_get(symtab->string_pool, name), section->name, offset);
 
 	return &symtab->symbols[symtab->n_entries - 1];
 }
@@ -103,26 +356,20 @@ Symbol* symtab_add_symbol(Symbol_Table* symtab,
  * symtab_find_symbol
  */
 Symbol* symtab_find_symbol(const Symbol_Table* symtab,
-	const char* name)
+	const String_Id name)
 {
 	if(!symtab) {
 		fprintf(stderr, "Error: Invalid symbol table provided to find symbol function\n");
 		return NULL;
 	}
 
-	if(!name) {
-		fprintf(stderr, "Error: Invalid name provided to find symbol function\n");
+	/** The index of the matching symbol. */
+	const ssize_t symbol_index = symtab_index_find(symtab, name);
+	if(symbol_index == -1) {
 		return NULL;
 	}
 
-	int name_len = strlen(name);
-	for(size_t i = 0; i < symtab->n_entries; i++) {
-		if(strncmp(name, symtab->symbols[i].name, name_len) == 0) {
-			return &symtab->symbols[i];
-		}
-	}
-
-	return NULL;
+	return &symtab->symbols[symbol_index];
 }
 
 
@@ -130,26 +377,14 @@ Symbol* symtab_find_symbol(const Symbol_Table* symtab,
  * symtab_find_symbol_index
  */
 ssize_t symtab_find_symbol_index(const Symbol_Table* symtab,
-	const char* name)
+	const String_Id name)
 {
 	if(!symtab) {
 		fprintf(stderr, "Error: Invalid symbol table provided to find symbol function\n");
 		return -1;
 	}
 
-	if(!name) {
-		fprintf(stderr, "Error: Invalid name provided to find symbol function\n");
-		return -1;
-	}
-
-	int name_len = strlen(name);
-	for(size_t i = 0; i < symtab->n_entries; i++) {
-		if(strncmp(name, symtab->symbols[i].name, name_len) == 0) {
-			return i;
-		}
-	}
-
-	return -1;
+	return symtab_index_find(symtab, name);
 }
 
 
@@ -160,12 +395,10 @@ ssize_t symtab_find_symbol_index(const Symbol_Table* symtab,
 Assembler_Status populate_symtab(const Section* sections,
 	const Symbol_Table* symbol_table)
 {
-	/** Used for tracking the result of adding the entity to a section. */
-	Encoding_Entity* added_entity = NULL;
+	/** The status of writing each entry to its section. */
+	Assembler_Status status = ASSEMBLER_STATUS_SUCCESS;
 	Section* strtab = NULL;
 	Section* symtab = NULL;
-	/** Encoding entity to hold the null byte entity inserted into the symtab. */
-	Encoding_Entity* null_byte_entity = NULL;
 
 	if(!sections) {
 		fprintf(stderr, "Error: Invalid section data populating symbol table\n");
@@ -190,42 +423,20 @@ Assembler_Status populate_symtab(const Section* sections,
 	}
 
 	// Add the initial null byte to strtab as per ELF specification.
-	null_byte_entity = malloc(sizeof(Encoding_Entity));
-	if(!null_byte_entity) {
-		fprintf(stderr, "Error: Error allocating null byte symbol entity\n");
-		return ASSEMBLER_ERROR_BAD_ALLOC;
-	}
-
-	null_byte_entity->n_reloc_entries = 0;
-	null_byte_entity->reloc_entries = NULL;
-
-	null_byte_entity->size = 1;
-	null_byte_entity->data = malloc(1);
-	if(!null_byte_entity->data) {
-		fprintf(stderr, "Error: Error allocating null byte symbol entity data\n");
-
-		// Cleanup.
-		free(null_byte_entity);
-		return ASSEMBLER_ERROR_BAD_ALLOC;
-	}
-
-	null_byte_entity->data[0] = '\0';
-
-	null_byte_entity->next = NULL;
-
-	added_entity = section_add_encoding_entity(strtab, null_byte_entity);
-	if(!added_entity) {
-		// Error message should already be set.
-		return ASSEMBLER_ERROR_SECTION_ENTITY_FAILURE;
+	status = section_write(strtab, "", 1);
+	if(!get_status(status)) {
+		// Error message printed in callee.
+		return status;
 	}
 
-#if DEBUG_OUTPUT == 1
-	printf("Debug Output: Added null byte to .strtab.\n");
-#endif
+	TRACE(TRACE_CHANNEL_OUTPUT, "Debug Output: Added null byte to .strtab.\n");
 
 	for(size_t i = 0; i < symbol_table->n_entries; i++) {
 		// Add each symbol name to the string table, and each symbol entry to the
 		// symbol table section.
+		/** The name of the current symbol. */
+		const char* symbol_name = string_pool_get(symbol_table->string_pool,
+			symbol_table->symbols[i].name);
 
 		Elf32_Sym symbol_entry;
 		symbol_entry.st_name = strtab->size;
@@ -253,88 +464,32 @@ Assembler_Status populate_symtab(const Section* sections,
 		// Get the section index.
 		symbol_entry.st_shndx = shndx;
 
-#if DEBUG_OUTPUT == 1
-	printf("Debug Output: Matched section index: `%i` for symbol name `%s`\n",
-		symbol_entry.st_shndx, symbol_table->symbols[i].name);
-#endif
-
-		size_t symbol_entry_size = sizeof(Elf32_Sym);
-
-		// Create an encoding entity for each symbol entry, this will be encoded
-		// in the symbol table section during the writing of the section data.
-		Encoding_Entity* symbol_entry_entity = malloc(sizeof(Encoding_Entity));
-		if(!symbol_entry_entity) {
-			fprintf(stderr, "Error: Error allocating symbol entity\n");
-
-			return ASSEMBLER_ERROR_BAD_ALLOC;
-		}
-
-		symbol_entry_entity->n_reloc_entries = 0;
-		symbol_entry_entity->reloc_entries = NULL;
-
-		symbol_entry_entity->size = symbol_entry_size;
-		symbol_entry_entity->data = malloc(symbol_entry_size);
-		if(!symbol_entry_entity->data) {
-			fprintf(stderr, "Error: Error allocating symbol entity data\n");
-
-			return ASSEMBLER_ERROR_BAD_ALLOC;
-		}
-
-		symbol_entry_entity->data = memcpy(symbol_entry_entity->data,
-			&symbol_entry, symbol_entry_size);
-
-		symbol_entry_entity->next = NULL;
-
-		added_entity = section_add_encoding_entity(symtab, symbol_entry_entity);
-		if(!added_entity) {
-			// Error message should already have been printed.
-
-			return ASSEMBLER_ERROR_SECTION_ENTITY_FAILURE;
-		}
-
-#if DEBUG_OUTPUT == 1
-	printf("Debug Output: Adding symbol: `%s` to .symtab at offset `0x%lx`\n",
-		symbol_table->symbols[i].name, symtab->size);
-#endif
-
-		// Create an encoding entity for each symbol name, this will be encoded
-		// in the string table during the writing of the section data.
-		Encoding_Entity* symbol_name_entity = malloc(sizeof(Encoding_Entity));
-		if(!symbol_name_entity) {
-			fprintf(stderr, "Error: Error allocating symbol name entity\n");
-
-			return ASSEMBLER_ERROR_BAD_ALLOC;
-		}
-
-		symbol_name_entity->n_reloc_entries = 0;
-		symbol_name_entity->reloc_entries = NULL;
-
-		size_t symbol_name_len = strlen(symbol_table->symbols[i].name) + 1;
-		symbol_name_entity->size = symbol_name_len;
-		symbol_name_entity->data = malloc(symbol_name_len);
-		if(!symbol_name_entity->data) {
-			fprintf(stderr, "Error: Error allocating symbol name entity data\n");
+		TRACE(TRACE_CHANNEL_OUTPUT,
+			"Debug Output: Matched section index: `%i` for symbol name `%s`\n",
+			symbol_entry.st_shndx, symbol_name);
 
-			return ASSEMBLER_ERROR_BAD_ALLOC;
+		// Write each symbol entry into the symbol table section's data.
+		status = section_write(symtab, &symbol_entry, sizeof(Elf32_Sym));
+		if(!get_status(status)) {
+			// Error message printed in callee.
+			return status;
 		}
 
-		symbol_name_entity->data = memcpy(symbol_name_entity->data,
-			symbol_table->symbols[i].name, symbol_name_len);
-		symbol_name_entity->data[symbol_name_len-1] = '\0';
-
-		symbol_name_entity->next = NULL;
-
-		added_entity = section_add_encoding_entity(strtab, symbol_name_entity);
-		if(!added_entity) {
-			// Error message should already have been printed.
+		TRACE(TRACE_CHANNEL_OUTPUT,
+			"Debug Output: Adding symbol: `%s` to .symtab at offset `0x%zx`\n",
+			symbol_name, symtab->size);
 
-			return ASSEMBLER_ERROR_SECTION_ENTITY_FAILURE;
+		// Write each symbol name, including its NUL terminator, into the string
+		// table section's data.
+		status = section_write(strtab, symbol_name, strlen(symbol_name) + 1);
+		if(!get_status(status)) {
+			// Error message printed in callee.
+			return status;
 		}
 
-#if DEBUG_OUTPUT == 1
-	printf("Debug Output: Added symbol name: `%s` to .strtab at offset `0x%lx`\n",
-		symbol_table->symbols[i].name, strtab->size);
-#endif
+		TRACE(TRACE_CHANNEL_OUTPUT,
+			"Debug Output: Added symbol name: `%s` to .strtab at offset `0x%zx`\n",
+			symbol_name, strtab->size);
 	}
 
 	return ASSEMBLER_STATUS_SUCCESS;
@@ -0,0 +1,172 @@
+/**
+ * @file trace.c
+ * @author Anthony (ajxs [at] panoptic.online)
+ * @brief Functions for printing trace output.
+ * Contains functions for enabling trace channels, and for buffering and writing
+ * trace output.
+ * @version 0.1
+ * @date 2019-03-09
+ */
+
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <as.h>
+#include <trace.h>
+
+/** The size of each thread's trace buffer. */
+#define TRACE_BUFFER_SIZE 0x2000
+
+/**
+ * @brief Trace buffer type.
+ * Buffers trace output so that it is written in large blocks, rather than with
+ * a write for every message.
+ */
+typedef struct {
+	char data[TRACE_BUFFER_SIZE];
+	size_t len;
+} Trace_Buffer;
+
+/** The name of each trace channel, as given on the command line. */
+static const char* const trace_channel_names[TRACE_CHANNEL_COUNT] = {
+	[TRACE_CHANNEL_ASSEMBLER] = "assembler",
+	[TRACE_CHANNEL_CODEGEN] = "codegen",
+	[TRACE_CHANNEL_INPUT] = "input",
+	[TRACE_CHANNEL_LEXER] = "lexer",
+	[TRACE_CHANNEL_MACRO] = "macro",
+	[TRACE_CHANNEL_OUTPUT] = "output",
+	[TRACE_CHANNEL_STATEMENTS] = "statements",
+	[TRACE_CHANNEL_SYMBOLS] = "symbols"
+};
+
+uint32_t trace_enabled_channels = 0;
+
+/**
+ * The calling thread's trace buffer. Each thread has its own buffer, so that
+ * tracing requires no locking until the buffer is written.
+ */
+static _Thread_local Trace_Buffer trace_buffer;
+
+
+/**
+ * trace_enable_channels
+ */
+Assembler_Status trace_enable_channels(const char* channel_list)
+{
+	/** The channels named in the list. */
+	uint32_t channels = 0;
+	/** The start of the current channel name. */
+	const char* name = channel_list;
+	/** The length of the current channel name. */
+	size_t name_len = 0;
+	/** Whether the current channel name was matched. */
+	bool matched = false;
+
+	if(!channel_list) {
+		return ASSEMBLER_ERROR_BAD_FUNCTION_ARGS;
+	}
+
+	while(true) {
+		name_len = strcspn(name, ",");
+		matched = false;
+
+		if(name_len == strlen("all") && strncmp(name, "all", name_len) == 0) {
+			channels = (1u << TRACE_CHANNEL_COUNT) - 1;
+			matched = true;
+		}
+
+		for(size_t i = 0; !matched && i < TRACE_CHANNEL_COUNT; i++) {
+			if(name_len == strlen(trace_channel_names[i]) &&
+				strncmp(name, trace_channel_names[i], name_len) == 0) {
+				channels |= 1u << i;
+				matched = true;
+			}
+		}
+
+		if(!matched) {
+			fprintf(stderr, "Error: Unrecognised trace channel `%.*s`\n",
+				(int)name_len, name);
+
+			return ASSEMBLER_STATUS_BAD_INPUT;
+		}
+
+		if(name[name_len] == '\0') {
+			break;
+		}
+
+		name += name_len + 1;
+	}
+
+	trace_enabled_channels |= channels;
+
+	return ASSEMBLER_STATUS_SUCCESS;
+}
+
+
+/**
+ * trace_enable_channel
+ */
+void trace_enable_channel(const Trace_Channel channel)
+{
+	trace_enabled_channels |= 1u << channel;
+}
+
+
+/**
+ * trace_printf
+ */
+void trace_printf(const char* format,
+	...)
+{
+	/** The message's arguments. */
+	va_list args;
+	/** The space remaining in the buffer. */
+	const size_t remaining = TRACE_BUFFER_SIZE - trace_buffer.len;
+	/** The length of the formatted message. */
+	int message_len = 0;
+
+	va_start(args, format);
+	message_len = vsnprintf(trace_buffer.data + trace_buffer.len, remaining,
+		format, args);
+	va_end(args);
+
+	if(message_len < 0) {
+		return;
+	}
+
+	if((size_t)message_len < remaining) {
+		trace_buffer.len += message_len;
+		return;
+	}
+
+	// The message was truncated. Write out the preceding messages, and format
+	// it again at the start of the buffer.
+	trace_flush();
+
+	va_start(args, format);
+	if((size_t)message_len < TRACE_BUFFER_SIZE) {
+		vsnprintf(trace_buffer.data, TRACE_BUFFER_SIZE, format, args);
+		trace_buffer.len = message_len;
+	} else {
+		// Messages larger than the buffer are written directly.
+		vfprintf(stderr, format, args);
+	}
+	va_end(args);
+}
+
+
+/**
+ * trace_flush
+ */
+void trace_flush(void)
+{
+	if(trace_buffer.len == 0) {
+		return;
+	}
+
+	fwrite(trace_buffer.data, 1, trace_buffer.len, stderr);
+	trace_buffer.len = 0;
+}
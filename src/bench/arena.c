@@ -0,0 +1,105 @@
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <arena.h>
+#include <as.h>
+#include <statement.h>
+#include <bench.h>
+
+/** The number of statements allocated in each iteration. */
+#define BENCH_ARENA_STATEMENTS 100000
+/** The number of times each benchmark is repeated. */
+#define BENCH_ARENA_ITERATIONS 20
+/** The number of operands allocated for each statement. */
+#define BENCH_ARENA_OPERANDS 3
+
+
+/**
+ * Prevents the compiler from optimising away the allocations.
+ */
+static volatile uintptr_t bench_arena_sink;
+
+
+/**
+ * Allocates a statement and its operands for each parsed statement using
+ * malloc, then frees them all individually, as the assembler previously did.
+ */
+static void bench_arena_malloc(Statement** statements)
+{
+	for(size_t i = 0; i < BENCH_ARENA_STATEMENTS; i++) {
+		statements[i] = malloc(sizeof(Statement));
+		statements[i]->instruction.opseq.operands =
+			malloc(sizeof(Operand) * BENCH_ARENA_OPERANDS);
+		bench_arena_sink += (uintptr_t)statements[i];
+	}
+
+	for(size_t i = 0; i < BENCH_ARENA_STATEMENTS; i++) {
+		free(statements[i]->instruction.opseq.operands);
+		free(statements[i]);
+	}
+}
+
+
+/**
+ * Allocates the same objects from an arena, then releases them all at once.
+ */
+static void bench_arena_arena(Statement** statements,
+	Arena* totals)
+{
+	Arena arena;
+
+	if(!get_status(initialise_arena(&arena))) {
+		return;
+	}
+
+	for(size_t i = 0; i < BENCH_ARENA_STATEMENTS; i++) {
+		statements[i] = arena_alloc(&arena, sizeof(Statement));
+		statements[i]->instruction.opseq.operands =
+			arena_alloc(&arena, sizeof(Operand) * BENCH_ARENA_OPERANDS);
+		bench_arena_sink += (uintptr_t)statements[i];
+	}
+
+	*totals = arena;
+	free_arena(&arena);
+}
+
+
+/**
+ * Benchmarks allocating and releasing the parsed program's statements using
+ * malloc and free against using an arena.
+ */
+void bench_arena(void)
+{
+	/** The allocated statements. */
+	Statement** statements = malloc(sizeof(Statement*) * BENCH_ARENA_STATEMENTS);
+	/** The counters of the final arena used. */
+	Arena totals = { NULL, 0, 0, 0, 0 };
+	double start = 0;
+
+	if(!statements) {
+		fprintf(stderr, "Bench Error: Error allocating statement array\n");
+		return;
+	}
+
+	start = bench_now();
+	for(size_t i = 0; i < BENCH_ARENA_ITERATIONS; i++) {
+		bench_arena_malloc(statements);
+	}
+
+	bench_report("statements (malloc/free)", BENCH_ARENA_ITERATIONS, 0,
+		bench_now() - start);
+
+	start = bench_now();
+	for(size_t i = 0; i < BENCH_ARENA_ITERATIONS; i++) {
+		bench_arena_arena(statements, &totals);
+	}
+
+	bench_report("statements (arena)", BENCH_ARENA_ITERATIONS, 0,
+		bench_now() - start);
+
+	printf("  arena: %zu allocations, %zu bytes allocated, %zu bytes reserved in %zu blocks\n",
+		totals.n_allocations, totals.n_bytes_allocated, totals.n_bytes_reserved,
+		totals.n_blocks);
+
+	free(statements);
+}
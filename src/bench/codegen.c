@@ -0,0 +1,187 @@
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <as.h>
+#include <codegen.h>
+#include <instruction.h>
+#include <section.h>
+#include <symtab.h>
+#include <bench.h>
+
+/** The number of instructions in the encoded block. */
+#define BENCH_CODEGEN_INSTRUCTIONS 4096
+/** The number of times each benchmark is repeated. */
+#define BENCH_CODEGEN_ITERATIONS 500
+/** The number of operands allocated for each instruction. */
+#define BENCH_CODEGEN_OPERANDS 3
+
+
+/**
+ * Prevents the compiler from optimising away the encoded instructions.
+ */
+static volatile uintptr_t bench_codegen_sink;
+
+
+/**
+ * Fills a block of straight-line code with a mix of register, immediate, offset
+ * and jump type instructions. One in eight instructions references a symbol.
+ */
+static void bench_codegen_fill(Instruction* instructions,
+	Operand* operands,
+	const String_Id symbol)
+{
+	for(size_t i = 0; i < BENCH_CODEGEN_INSTRUCTIONS; i++) {
+		/** The operands of this instruction. */
+		Operand* instruction_operands = &operands[i * BENCH_CODEGEN_OPERANDS];
+
+		for(size_t j = 0; j < BENCH_CODEGEN_OPERANDS; j++) {
+			instruction_operands[j].type = OPERAND_TYPE_REGISTER;
+			instruction_operands[j].flags = DEFAULT_OPERAND_FLAGS;
+			instruction_operands[j].offset = 0;
+			instruction_operands[j].reg = REGISTER_$T0 + ((i + j) % 8);
+		}
+
+		instructions[i].opseq.operands = instruction_operands;
+
+		switch(i % 8) {
+			case 0:
+			case 4:
+				instructions[i].opcode = OPCODE_ADDU;
+				instructions[i].opseq.n_operands = 3;
+				break;
+			case 1:
+			case 5:
+				instructions[i].opcode = OPCODE_ADDIU;
+				instructions[i].opseq.n_operands = 3;
+				instruction_operands[2].type = OPERAND_TYPE_NUMERIC_LITERAL;
+				instruction_operands[2].numeric_literal = i & 0x7FFF;
+				break;
+			case 2:
+				instructions[i].opcode = OPCODE_LW;
+				instructions[i].opseq.n_operands = 2;
+				instruction_operands[1].offset = (i % 16) * 4;
+				break;
+			case 3:
+				instructions[i].opcode = OPCODE_SW;
+				instructions[i].opseq.n_operands = 2;
+				instruction_operands[1].offset = (i % 16) * 4;
+				break;
+			case 6:
+				instructions[i].opcode = OPCODE_SLL;
+				instructions[i].opseq.n_operands = 3;
+				instruction_operands[2].type = OPERAND_TYPE_NUMERIC_LITERAL;
+				instruction_operands[2].numeric_literal = 2;
+				break;
+			default:
+				instructions[i].opcode = OPCODE_JAL;
+				instructions[i].opseq.n_operands = 1;
+				instruction_operands[0].type = OPERAND_TYPE_SYMBOL;
+				instruction_operands[0].symbol = symbol;
+				break;
+		}
+	}
+}
+
+
+/**
+ * Benchmarks encoding a block of instructions one statement at a time into a
+ * section, as the second pass does, against encoding it with a single call to
+ * the batch encoder.
+ */
+void bench_codegen(void)
+{
+	/** The string pool holding the symbol name. */
+	String_Pool string_pool;
+	/** The symbol table containing the referenced symbol. */
+	Symbol_Table symbol_table;
+	/** The section that instructions are individually encoded in. */
+	Section* section = NULL;
+	/** The interned name of the referenced symbol. */
+	String_Id symbol = 0;
+	/** The block of instructions to encode. */
+	Instruction* instructions = NULL;
+	/** The operands of every instruction. */
+	Operand* operands = NULL;
+	/** The batch encoded instructions. */
+	uint32_t* encoding = NULL;
+	/** The batch relocation entries. */
+	Reloc_Entry* reloc_entries = NULL;
+	size_t n_reloc_entries = 0;
+	double start = 0;
+
+	if(!get_status(initialise_string_pool(&string_pool))) {
+		return;
+	}
+
+	if(!get_status(initialise_symbol_table(&symbol_table, &string_pool))) {
+		goto FAIL_FREE_STRING_POOL;
+	}
+
+	if(!get_status(create_section(&section, ".text", SHT_PROGBITS,
+		SHF_ALLOC | SHF_EXECINSTR))) {
+		goto FAIL_FREE_SYMBOL_TABLE;
+	}
+
+	instructions = malloc(sizeof(Instruction) * BENCH_CODEGEN_INSTRUCTIONS);
+	operands = malloc(sizeof(Operand) * BENCH_CODEGEN_INSTRUCTIONS *
+		BENCH_CODEGEN_OPERANDS);
+	encoding = malloc(sizeof(uint32_t) * BENCH_CODEGEN_INSTRUCTIONS);
+	reloc_entries = malloc(sizeof(Reloc_Entry) * BENCH_CODEGEN_INSTRUCTIONS);
+	if(!instructions || !operands || !encoding || !reloc_entries) {
+		fprintf(stderr, "Bench Error: Error allocating instruction block\n");
+		goto FAIL_FREE_BLOCK;
+	}
+
+	if(!get_status(string_pool_intern(&string_pool, "target", 6, &symbol)) ||
+		!symtab_add_symbol(&symbol_table, symbol, section, 0x40)) {
+		goto FAIL_FREE_BLOCK;
+	}
+
+	bench_codegen_fill(instructions, operands, symbol);
+
+	start = bench_now();
+	for(size_t i = 0; i < BENCH_CODEGEN_ITERATIONS; i++) {
+		// Reuse the section's storage between iterations.
+		section->size = 0;
+		section->n_reloc_entries = 0;
+
+		for(size_t j = 0; j < BENCH_CODEGEN_INSTRUCTIONS; j++) {
+			if(!get_status(encode_instruction(section, &symbol_table,
+				&instructions[j], j * sizeof(uint32_t)))) {
+				goto FAIL_FREE_BLOCK;
+			}
+		}
+
+		bench_codegen_sink += section->data[i % section->size];
+	}
+
+	bench_report("encode_instruction (per statement)",
+		BENCH_CODEGEN_ITERATIONS * BENCH_CODEGEN_INSTRUCTIONS, 0,
+		bench_now() - start);
+
+	start = bench_now();
+	for(size_t i = 0; i < BENCH_CODEGEN_ITERATIONS; i++) {
+		if(!get_status(encode_instruction_batch(&symbol_table, instructions,
+			BENCH_CODEGEN_INSTRUCTIONS, 0, encoding, reloc_entries,
+			&n_reloc_entries))) {
+			goto FAIL_FREE_BLOCK;
+		}
+
+		bench_codegen_sink += encoding[i % BENCH_CODEGEN_INSTRUCTIONS] + n_reloc_entries;
+	}
+
+	bench_report("encode_instruction_batch",
+		BENCH_CODEGEN_ITERATIONS * BENCH_CODEGEN_INSTRUCTIONS, 0,
+		bench_now() - start);
+
+FAIL_FREE_BLOCK:
+	free(reloc_entries);
+	free(encoding);
+	free(operands);
+	free(instructions);
+	free_section(section);
+FAIL_FREE_SYMBOL_TABLE:
+	free_symbol_table(&symbol_table);
+FAIL_FREE_STRING_POOL:
+	free_string_pool(&string_pool);
+}
@@ -0,0 +1,62 @@
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+/**
+ * Benchmark timing.
+ */
+double bench_now(void);
+void bench_report(const char* name,
+	const size_t iterations,
+	const size_t bytes,
+	const double elapsed);
+
+/**
+ * Arena benchmarks.
+ */
+void bench_arena(void);
+
+/**
+ * Codegen benchmarks.
+ */
+void bench_codegen(void);
+
+/**
+ * Opcode benchmarks.
+ */
+void bench_opcode(void);
+
+/**
+ * Scan benchmarks.
+ */
+void bench_scan(void);
+
+/**
+ * Throughput benchmarks.
+ * Runs the assembler binary over generated workloads.
+ */
+void bench_throughput(const char* assembler);
+
+/**
+ * Workload generation.
+ * Densities and ratios are percentages of lines.
+ */
+typedef struct {
+	/** The number of lines to generate. */
+	size_t n_lines;
+	/** The percentage of lines which define a label. */
+	unsigned label_density;
+	/** The percentage of blocks in the data section. */
+	unsigned data_ratio;
+	/** The percentage of instructions which are `la` or `li` macros. */
+	unsigned macro_density;
+	/** The percentage of data directives which are `.asciiz` strings. */
+	unsigned string_density;
+	/** The length of each `.asciiz` string. */
+	size_t string_length;
+	/** The seed of the generated sequence. */
+	uint64_t seed;
+} Bench_Workload;
+
+void bench_generate_workload(FILE* file,
+	const Bench_Workload* workload);
@@ -0,0 +1,176 @@
+#define _GNU_SOURCE
+
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <bench.h>
+
+
+/**
+ * Returns the current value of the monotonic clock, in seconds.
+ */
+double bench_now(void)
+{
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+
+	return (double)now.tv_sec + ((double)now.tv_nsec / 1e9);
+}
+
+
+/**
+ * Prints the result of a single benchmark.
+ * Throughput is only reported for benchmarks that process a known number of
+ * bytes.
+ */
+void bench_report(const char* name,
+	const size_t iterations,
+	const size_t bytes,
+	const double elapsed)
+{
+	printf("%-40s %10zu iterations %10.3f ms %10.1f ns/iter",
+		name, iterations, elapsed * 1e3, (elapsed * 1e9) / (double)iterations);
+
+	if(bytes > 0) {
+		printf(" %8.2f GB/s", ((double)bytes * (double)iterations) / elapsed / 1e9);
+	}
+
+	printf("\n");
+}
+
+
+/**
+ * Parses a numeric option, exiting if it is invalid.
+ */
+static unsigned long long bench_parse_number(const char* option,
+	const char* argument)
+{
+	/** The end of the parsed number. */
+	char* end = NULL;
+	/** The parsed number. */
+	unsigned long long number = strtoull(argument, &end, 0);
+
+	if(*argument == '\0' || *end != '\0') {
+		fprintf(stderr, "Bench Error: Invalid value for `--%s`\n", option);
+		exit(EXIT_FAILURE);
+	}
+
+	return number;
+}
+
+
+/**
+ * Prints the usage of the benchmark program.
+ */
+static void bench_print_help(void)
+{
+	printf("Usage 'bench-{ARCH}-ajxs-elf-as'\n");
+	printf("[-h|--help]\n");
+	printf("[-a|--assembler FILE]\n");
+	printf("[-g|--generate FILE [--lines N] [--label-density N] [--data-ratio N]\n");
+	printf("  [--macro-density N] [--string-density N] [--string-length N] [--seed N]]\n");
+	printf("assembler: Also runs the throughput benchmarks over generated workloads with the given assembler.\n");
+	printf("generate: Writes a single generated workload to FILE instead of running the benchmarks.\n");
+	printf("  Densities and ratios are percentages. Defaults to 100000 lines.\n");
+}
+
+
+int main(int argc, char **argv) {
+	/** The assembler run by the throughput benchmarks. */
+	const char* assembler = NULL;
+	/** The file to write a generated workload to. */
+	const char* workload_filename = NULL;
+	/** The generated workload. */
+	Bench_Workload workload = {
+		.n_lines = 100000,
+		.label_density = 10,
+		.data_ratio = 20,
+		.macro_density = 10,
+		.string_density = 10,
+		.string_length = 32,
+		.seed = 1
+	};
+	/** The workload file. */
+	FILE* workload_file = NULL;
+	/** getopts configuration. */
+	static struct option long_options[] = {
+		{"assembler", required_argument, NULL, 'a'},
+		{"data-ratio", required_argument, NULL, 'D'},
+		{"generate", required_argument, NULL, 'g'},
+		{"help", no_argument, NULL, 'h'},
+		{"label-density", required_argument, NULL, 'L'},
+		{"lines", required_argument, NULL, 'n'},
+		{"macro-density", required_argument, NULL, 'M'},
+		{"seed", required_argument, NULL, 'S'},
+		{"string-density", required_argument, NULL, 'T'},
+		{"string-length", required_argument, NULL, 'l'},
+		{0, 0, 0, 0}
+	};
+	/** The option char being checked. */
+	int c = 0;
+	/** The option index being checked. */
+	int option_index = 0;
+
+	while((c = getopt_long(argc, argv, "a:g:h", long_options, &option_index)) != -1) {
+		switch(c) {
+			case 'a':
+				assembler = optarg;
+				break;
+			case 'D':
+				workload.data_ratio = bench_parse_number("data-ratio", optarg);
+				break;
+			case 'g':
+				workload_filename = optarg;
+				break;
+			case 'L':
+				workload.label_density = bench_parse_number("label-density", optarg);
+				break;
+			case 'l':
+				workload.string_length = bench_parse_number("string-length", optarg);
+				break;
+			case 'M':
+				workload.macro_density = bench_parse_number("macro-density", optarg);
+				break;
+			case 'n':
+				workload.n_lines = bench_parse_number("lines", optarg);
+				break;
+			case 'S':
+				workload.seed = bench_parse_number("seed", optarg);
+				break;
+			case 'T':
+				workload.string_density = bench_parse_number("string-density", optarg);
+				break;
+			case 'h':
+				bench_print_help();
+				exit(EXIT_SUCCESS);
+			default:
+				bench_print_help();
+				exit(EXIT_FAILURE);
+		}
+	}
+
+	if(workload_filename) {
+		workload_file = fopen(workload_filename, "w");
+		if(!workload_file) {
+			fprintf(stderr, "Bench Error: Error opening `%s`\n", workload_filename);
+			exit(EXIT_FAILURE);
+		}
+
+		bench_generate_workload(workload_file, &workload);
+		fclose(workload_file);
+
+		return 0;
+	}
+
+	bench_arena();
+	bench_codegen();
+	bench_opcode();
+	bench_scan();
+
+	if(assembler) {
+		bench_throughput(assembler);
+	}
+
+	return 0;
+}
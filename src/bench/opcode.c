@@ -0,0 +1,155 @@
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <as.h>
+#include <parsing.h>
+#include <bench.h>
+
+/** The number of times each benchmark is repeated. */
+#define BENCH_OPCODE_ITERATIONS 200000
+
+
+/**
+ * Prevents the compiler from optimising away the parsed opcodes.
+ */
+static volatile uintptr_t bench_opcode_sink;
+
+/**
+ * Every recognised mnemonic, in the mixed case found in source files.
+ */
+static const char* bench_opcode_mnemonics[] = {
+	"add", "addi", "addiu", "addu", "and", "andi", "bal", "beq", "beqz", "bgez",
+	"bne", "blez", "div", "j", "jal", "jalr", "jr", "la", "lb", "lbu", "lhu",
+	"li", "lui", "lw", "move", "muh", "muhu", "mul", "mulu", "mult", "multu",
+	"nor", "nop", "or", "ori", "sb", "sh", "sll", "sub", "subu", "sw", "syscall",
+	"ADD", "ADDIU", "BEQ", "JAL", "LUI", "LW", "ORI", "SW", "SYSCALL", "NOP"
+};
+
+
+/**
+ * The chain of prefix comparisons previously used to parse opcodes, kept for
+ * comparison.
+ */
+static Opcode bench_opcode_parse_chain(const char* opcode_symbol)
+{
+	if(!strncasecmp(opcode_symbol, "addiu", 5)) {
+		return OPCODE_ADDIU;
+	} else if(!strncasecmp(opcode_symbol, "addi", 4)) {
+		return OPCODE_ADDI;
+	} else if(!strncasecmp(opcode_symbol, "addu", 4)) {
+		return OPCODE_ADDU;
+	} else if(!strncasecmp(opcode_symbol, "add", 3)) {
+		return OPCODE_ADD;
+	} else if(!strncasecmp(opcode_symbol, "bal", 5)) {
+		return OPCODE_BAL;
+	} else if(!strncasecmp(opcode_symbol, "beqz", 4)) {
+		return OPCODE_BEQZ;
+	} else if(!strncasecmp(opcode_symbol, "beq", 3)) {
+		return OPCODE_BEQ;
+	} else if(!strncasecmp(opcode_symbol, "bgez", 4)) {
+		return OPCODE_BGEZ;
+	} else if(!strncasecmp(opcode_symbol, "bne", 3)) {
+		return OPCODE_BNE;
+	} else if(!strncasecmp(opcode_symbol, "blez", 4)) {
+		return OPCODE_BLEZ;
+	} else if(!strncasecmp(opcode_symbol, "div", 3)) {
+		return OPCODE_DIV;
+	} else if(!strncasecmp(opcode_symbol, "jalr", 4)) {
+		return OPCODE_JALR;
+	} else if(!strncasecmp(opcode_symbol, "jal", 3)) {
+		return OPCODE_JAL;
+	} else if(!strncasecmp(opcode_symbol, "jr", 2)) {
+		return OPCODE_JR;
+	} else if(!strncasecmp(opcode_symbol, "j", 1)) {
+		return OPCODE_J;
+	} else if(!strncasecmp(opcode_symbol, "la", 2)) {
+		return OPCODE_LA;
+	} else if(!strncasecmp(opcode_symbol, "lbu", 3)) {
+		return OPCODE_LBU;
+	} else if(!strncasecmp(opcode_symbol, "lb", 2)) {
+		return OPCODE_LB;
+	} else if(!strncasecmp(opcode_symbol, "lhu", 3)) {
+		return OPCODE_LHU;
+	} else if(!strncasecmp(opcode_symbol, "li", 2)) {
+		return OPCODE_LI;
+	} else if(!strncasecmp(opcode_symbol, "lui", 3)) {
+		return OPCODE_LUI;
+	} else if(!strncasecmp(opcode_symbol, "lw", 2)) {
+		return OPCODE_LW;
+	} else if(!strncasecmp(opcode_symbol, "move", 4)) {
+		return OPCODE_MOVE;
+	} else if(!strncasecmp(opcode_symbol, "muhu", 4)) {
+		return OPCODE_MUHU;
+	} else if(!strncasecmp(opcode_symbol, "muh", 3)) {
+		return OPCODE_MUH;
+	} else if(!strncasecmp(opcode_symbol, "multu", 4)) {
+		// Deprecated.
+		return OPCODE_MULTU;
+	} else if(!strncasecmp(opcode_symbol, "mulu", 4)) {
+		return OPCODE_MULU;
+	} else if(!strncasecmp(opcode_symbol, "mult", 4)) {
+		// Deprecated.
+		return OPCODE_MULT;
+	} else if(!strncasecmp(opcode_symbol, "mul", 3)) {
+		return OPCODE_MUL;
+	} else if(!strncasecmp(opcode_symbol, "nor", 3)) {
+		return OPCODE_NOR;
+	} else if(!strncasecmp(opcode_symbol, "nop", 3)) {
+		return OPCODE_NOP;
+	} else if(!strncasecmp(opcode_symbol, "ori", 3)) {
+		return OPCODE_ORI;
+	} else if(!strncasecmp(opcode_symbol, "or", 2)) {
+		return OPCODE_OR;
+	} else if(!strncasecmp(opcode_symbol, "sb", 2)) {
+		return OPCODE_SB;
+	} else if(!strncasecmp(opcode_symbol, "sh", 2)) {
+		return OPCODE_SH;
+	} else if(!strncasecmp(opcode_symbol, "sll", 3)) {
+		return OPCODE_SLL;
+	} else if(!strncasecmp(opcode_symbol, "subu", 4)) {
+		return OPCODE_SUBU;
+	} else if(!strncasecmp(opcode_symbol, "sub", 3)) {
+		return OPCODE_SUB;
+	} else if(!strncasecmp(opcode_symbol, "sw", 2)) {
+		return OPCODE_SW;
+	} else if(!strncasecmp(opcode_symbol, "syscall", 6)) {
+		return OPCODE_SYSCALL;
+	}
+
+	return OPCODE_UNKNOWN;
+}
+
+
+/**
+ * Benchmarks a single opcode parsing function over every mnemonic.
+ */
+static void bench_opcode_function(const char* name,
+	Opcode (*parse_function)(const char*))
+{
+	/** The number of mnemonics parsed in each iteration. */
+	const size_t n_mnemonics = sizeof(bench_opcode_mnemonics) /
+		sizeof(bench_opcode_mnemonics[0]);
+	const double start = bench_now();
+
+	for(size_t i = 0; i < BENCH_OPCODE_ITERATIONS; i++) {
+		for(size_t m = 0; m < n_mnemonics; m++) {
+			bench_opcode_sink += parse_function(bench_opcode_mnemonics[m]);
+		}
+	}
+
+	bench_report(name, BENCH_OPCODE_ITERATIONS * n_mnemonics, 0,
+		bench_now() - start);
+}
+
+
+/**
+ * Benchmarks the cost of parsing each opcode mnemonic using the perfect hash
+ * against the previous chain of comparisons.
+ */
+void bench_opcode(void)
+{
+	bench_opcode_function("parse_opcode_symbol (comparison chain)",
+		bench_opcode_parse_chain);
+	bench_opcode_function("parse_opcode_symbol (perfect hash)",
+		parse_opcode_symbol);
+}
@@ -0,0 +1,74 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <scan.h>
+#include <bench.h>
+
+/** The length of each generated source line. */
+#define BENCH_SCAN_LINE_LENGTH 4096
+/** The number of times each benchmark is repeated. */
+#define BENCH_SCAN_ITERATIONS 100000
+
+
+/**
+ * Prevents the compiler from optimising away the result of a benchmark.
+ */
+static volatile uintptr_t bench_scan_sink;
+
+
+/**
+ * Benchmarks a single scanning function over a buffer.
+ */
+static void bench_scan_function(const char* name,
+	const char* (*scan_function)(const char*, const char*),
+	const char* buffer,
+	const size_t buffer_size)
+{
+	const double start = bench_now();
+
+	for(size_t i = 0; i < BENCH_SCAN_ITERATIONS; i++) {
+		bench_scan_sink += (uintptr_t)scan_function(buffer, buffer + buffer_size);
+	}
+
+	bench_report(name, BENCH_SCAN_ITERATIONS, buffer_size, bench_now() - start);
+}
+
+
+/**
+ * Benchmarks the scanning functions against their scalar implementations,
+ * over a long run of indentation and a long comment.
+ */
+void bench_scan(void)
+{
+	/** A line consisting entirely of blank characters. */
+	char* blank_line = malloc(BENCH_SCAN_LINE_LENGTH + 1);
+	/** The text of a comment, which contains no newline. */
+	char* comment_line = malloc(BENCH_SCAN_LINE_LENGTH + 1);
+
+	if(!blank_line || !comment_line) {
+		fprintf(stderr, "Bench Error: Error allocating line buffers\n");
+		goto cleanup;
+	}
+
+	for(size_t i = 0; i < BENCH_SCAN_LINE_LENGTH; i++) {
+		blank_line[i] = (i % 8 == 7) ? '\t' : ' ';
+		comment_line[i] = (i % 6 == 5) ? ' ' : 'a' + (i % 26);
+	}
+
+	blank_line[BENCH_SCAN_LINE_LENGTH] = '\0';
+	comment_line[BENCH_SCAN_LINE_LENGTH] = '\0';
+
+	bench_scan_function("scan_skip_blank_scalar", scan_skip_blank_scalar,
+		blank_line, BENCH_SCAN_LINE_LENGTH);
+	bench_scan_function("scan_skip_blank", scan_skip_blank,
+		blank_line, BENCH_SCAN_LINE_LENGTH);
+	bench_scan_function("scan_find_newline_scalar", scan_find_newline_scalar,
+		comment_line, BENCH_SCAN_LINE_LENGTH);
+	bench_scan_function("scan_find_newline", scan_find_newline,
+		comment_line, BENCH_SCAN_LINE_LENGTH);
+
+cleanup:
+	free(blank_line);
+	free(comment_line);
+}
@@ -0,0 +1,189 @@
+#include <errno.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <bench.h>
+
+/** The number of lines in each generated workload. */
+#define BENCH_THROUGHPUT_LINES 200000
+/** The number of times the assembler is run over each workload. */
+#define BENCH_THROUGHPUT_RUNS 3
+/** The maximum length of a generated file path. */
+#define BENCH_THROUGHPUT_PATH_SIZE 256
+
+
+/**
+ * A named workload of the throughput suite.
+ */
+typedef struct {
+	const char* name;
+	Bench_Workload workload;
+} Bench_Throughput_Workload;
+
+/**
+ * The workloads of the throughput suite. Each stresses a different part of the
+ * assembler: the symbol table, the data directives, macro expansion, and the
+ * scanning of long string literals.
+ */
+static const Bench_Throughput_Workload bench_throughput_workloads[] = {
+	{ "throughput_mixed", {
+		.n_lines = BENCH_THROUGHPUT_LINES, .label_density = 10, .data_ratio = 20,
+		.macro_density = 10, .string_density = 10, .string_length = 32, .seed = 1 } },
+	{ "throughput_label_dense", {
+		.n_lines = BENCH_THROUGHPUT_LINES, .label_density = 60, .data_ratio = 20,
+		.macro_density = 10, .string_density = 10, .string_length = 32, .seed = 2 } },
+	{ "throughput_data_heavy", {
+		.n_lines = BENCH_THROUGHPUT_LINES, .label_density = 10, .data_ratio = 80,
+		.macro_density = 10, .string_density = 20, .string_length = 32, .seed = 3 } },
+	{ "throughput_macro_dense", {
+		.n_lines = BENCH_THROUGHPUT_LINES, .label_density = 10, .data_ratio = 10,
+		.macro_density = 60, .string_density = 10, .string_length = 32, .seed = 4 } },
+	{ "throughput_long_strings", {
+		.n_lines = BENCH_THROUGHPUT_LINES, .label_density = 10, .data_ratio = 50,
+		.macro_density = 10, .string_density = 80, .string_length = 1024, .seed = 5 } }
+};
+
+
+/**
+ * Runs the assembler once over an input file, recording the wall time and the
+ * peak memory of the assembler process.
+ * Returns whether the assembler ran successfully.
+ */
+static bool bench_throughput_run(const char* assembler,
+	const char* input_filename,
+	const char* output_filename,
+	double* elapsed,
+	size_t* peak_rss)
+{
+	/** The assembler process. */
+	pid_t pid = 0;
+	/** The exit status of the assembler. */
+	int status = 0;
+	/** The resources used by the assembler. */
+	struct rusage usage;
+	/** The time at which the assembler was started. */
+	const double start = bench_now();
+
+	pid = fork();
+	if(pid == -1) {
+		fprintf(stderr, "Bench Error: Error starting assembler: %s\n",
+			strerror(errno));
+		return false;
+	}
+
+	if(pid == 0) {
+		execl(assembler, assembler, input_filename, "--output", output_filename,
+			(char*)NULL);
+		_exit(127);
+	}
+
+	if(wait4(pid, &status, 0, &usage) == -1) {
+		fprintf(stderr, "Bench Error: Error waiting for assembler: %s\n",
+			strerror(errno));
+		return false;
+	}
+
+	*elapsed = bench_now() - start;
+	*peak_rss = usage.ru_maxrss;
+
+	if(!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+		fprintf(stderr, "Bench Error: Assembler `%s` failed on `%s`\n", assembler,
+			input_filename);
+		return false;
+	}
+
+	return true;
+}
+
+
+/**
+ * Generates each workload, then runs the assembler over it several times.
+ * The fastest run is reported, along with the largest peak memory.
+ */
+void bench_throughput(const char* assembler)
+{
+	/** The directory the workloads are generated in. */
+	char directory[] = "/tmp/ajxs-bench-XXXXXX";
+	/** The path of the current workload. */
+	char input_filename[BENCH_THROUGHPUT_PATH_SIZE];
+	/** The path of the assembler's output. */
+	char output_filename[BENCH_THROUGHPUT_PATH_SIZE];
+
+	if(!mkdtemp(directory)) {
+		fprintf(stderr, "Bench Error: Error creating workload directory: %s\n",
+			strerror(errno));
+		return;
+	}
+
+	snprintf(output_filename, BENCH_THROUGHPUT_PATH_SIZE, "%s/out.elf", directory);
+
+	for(size_t i = 0; i < sizeof(bench_throughput_workloads) /
+		sizeof(Bench_Throughput_Workload); i++) {
+		/** The workload being run. */
+		const Bench_Throughput_Workload* workload = &bench_throughput_workloads[i];
+		/** The workload file. */
+		FILE* file = NULL;
+		/** The size of the workload file. */
+		struct stat file_stat;
+		/** The fastest run. */
+		double best = 0;
+		/** The largest peak memory of any run. */
+		size_t peak_rss = 0;
+		/** The wall time of the current run. */
+		double elapsed = 0;
+		/** The peak memory of the current run. */
+		size_t run_peak_rss = 0;
+		/** Whether every run was successful. */
+		bool success = true;
+
+		snprintf(input_filename, BENCH_THROUGHPUT_PATH_SIZE, "%s/%s.S", directory,
+			workload->name);
+
+		file = fopen(input_filename, "w");
+		if(!file) {
+			fprintf(stderr, "Bench Error: Error creating workload `%s`\n",
+				input_filename);
+			continue;
+		}
+
+		bench_generate_workload(file, &workload->workload);
+		fclose(file);
+
+		if(stat(input_filename, &file_stat) == -1) {
+			fprintf(stderr, "Bench Error: Error reading workload `%s`\n",
+				input_filename);
+			remove(input_filename);
+			continue;
+		}
+
+		for(size_t run = 0; success && run < BENCH_THROUGHPUT_RUNS; run++) {
+			success = bench_throughput_run(assembler, input_filename, output_filename,
+				&elapsed, &run_peak_rss);
+			if(run == 0 || elapsed < best) {
+				best = elapsed;
+			}
+
+			if(run_peak_rss > peak_rss) {
+				peak_rss = run_peak_rss;
+			}
+		}
+
+		if(success) {
+			printf("%-40s %10zu lines %10.3f ms %12.0f lines/s %8.2f MB/s %8zu KiB peak\n",
+				workload->name, workload->workload.n_lines, best * 1e3,
+				(double)workload->workload.n_lines / best,
+				(double)file_stat.st_size / best / 1e6, peak_rss);
+		}
+
+		remove(input_filename);
+	}
+
+	remove(output_filename);
+	rmdir(directory);
+}
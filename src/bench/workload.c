@@ -0,0 +1,369 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <as.h>
+#include <bench.h>
+
+/** The number of lines in each block of a single section. */
+#define BENCH_WORKLOAD_BLOCK_LINES 64
+/** The number of recent labels that branches may target. */
+#define BENCH_WORKLOAD_BRANCH_WINDOW 16
+
+
+/**
+ * The registers used as instruction operands, weighted towards the
+ * temporaries as in compiler output.
+ */
+static const char* bench_workload_registers[] = {
+	"$t0", "$t1", "$t2", "$t3", "$t4", "$t5", "$t6", "$t7", "$t8", "$t9",
+	"$t0", "$t1", "$t2", "$t3", "$s0", "$s1", "$s2", "$s3", "$s4", "$s5",
+	"$s6", "$s7", "$a0", "$a1", "$a2", "$a3", "$v0", "$v1", "$zero", "$ra"
+};
+
+/** The base registers of load and store instructions. */
+static const char* bench_workload_base_registers[] = {
+	"$sp", "$sp", "$fp", "$gp", "$a0", "$a1", "$t0", "$s0"
+};
+
+
+/**
+ * The state of a workload being generated.
+ */
+typedef struct {
+	FILE* file;
+	const Bench_Workload* workload;
+	uint64_t random;
+	size_t n_lines;
+	size_t n_text_labels;
+	size_t n_data_labels;
+	/** The weight of each opcode in the instruction mix, indexed by opcode. */
+	unsigned opcode_weights[OPCODE_SYSCALL + 1];
+	unsigned total_opcode_weight;
+} Bench_Workload_State;
+
+
+/**
+ * Returns the next pseudo-random number. The sequence is fixed by the seed, so
+ * that each workload is reproducible.
+ */
+static uint64_t bench_workload_random(Bench_Workload_State* state)
+{
+	// xorshift64*.
+	state->random ^= state->random >> 12;
+	state->random ^= state->random << 25;
+	state->random ^= state->random >> 27;
+
+	return state->random * 0x2545F4914F6CDD1DULL;
+}
+
+
+/**
+ * Returns a pseudo-random number less than the given bound.
+ */
+static size_t bench_workload_below(Bench_Workload_State* state,
+	const size_t bound)
+{
+	return (size_t)(bench_workload_random(state) >> 11) % bound;
+}
+
+
+/**
+ * Returns true with the given percentage chance.
+ */
+static bool bench_workload_chance(Bench_Workload_State* state,
+	const unsigned percent)
+{
+	return bench_workload_below(state, 100) < percent;
+}
+
+
+/**
+ * Returns a random operand register.
+ */
+static const char* bench_workload_register(Bench_Workload_State* state)
+{
+	return bench_workload_registers[bench_workload_below(state,
+		sizeof(bench_workload_registers) / sizeof(const char*))];
+}
+
+
+/**
+ * Weights each encodable instruction in `arch.h` by how common its form is in
+ * compiled code. Pseudo-instructions and instructions removed in `MIPS32r6`
+ * are excluded, with `la` and `li` generated separately at the macro density.
+ */
+static void bench_workload_weight_opcodes(Bench_Workload_State* state)
+{
+	state->total_opcode_weight = 0;
+
+	for(size_t opcode = 0; opcode <= OPCODE_SYSCALL; opcode++) {
+		/** The description of the instruction. */
+		const Instruction_Description* description =
+			get_instruction_description(opcode);
+		/** The weight of the instruction. */
+		unsigned weight = 0;
+
+		if(description->type != INSTRUCTION_TYPE_UNKNOWN &&
+			!description->deprecated) {
+			switch(description->signature) {
+				case OPERAND_SIGNATURE_RD_RS_RT:
+					// Multiplies are far less common than other arithmetic.
+					weight = description->sa ? 1 : 6;
+					break;
+				case OPERAND_SIGNATURE_RT_OFFSET:
+					weight = 6;
+					break;
+				case OPERAND_SIGNATURE_RT_RS_IMM:
+					weight = description->delay_slot ? 4 : 6;
+					break;
+				case OPERAND_SIGNATURE_RD_RT_SA:
+				case OPERAND_SIGNATURE_RT_IMM:
+				case OPERAND_SIGNATURE_TARGET:
+					weight = 3;
+					break;
+				default:
+					weight = 1;
+			}
+		}
+
+		state->opcode_weights[opcode] = weight;
+		state->total_opcode_weight += weight;
+	}
+}
+
+
+/**
+ * Returns a random opcode from the instruction mix.
+ */
+static Opcode bench_workload_opcode(Bench_Workload_State* state)
+{
+	/** The position of the opcode in the cumulative weights. */
+	size_t position = bench_workload_below(state, state->total_opcode_weight);
+	/** The opcode at the position. */
+	size_t opcode = 0;
+
+	while(position >= state->opcode_weights[opcode]) {
+		position -= state->opcode_weights[opcode];
+		opcode++;
+	}
+
+	return opcode;
+}
+
+
+/**
+ * Prints a label to branch to. Branches target one of the most recent labels,
+ * so that their offsets remain within range.
+ */
+static void bench_workload_print_branch_target(Bench_Workload_State* state)
+{
+	/** The number of labels that may be targeted. */
+	size_t window = state->n_text_labels < BENCH_WORKLOAD_BRANCH_WINDOW ?
+		state->n_text_labels : BENCH_WORKLOAD_BRANCH_WINDOW;
+
+	fprintf(state->file, "L%zu",
+		state->n_text_labels - 1 - bench_workload_below(state, window));
+}
+
+
+/**
+ * Prints a single instruction, or a `la` or `li` macro, with random operands
+ * matching its signature.
+ */
+static void bench_workload_print_instruction(Bench_Workload_State* state)
+{
+	/** The opcode of the instruction. */
+	Opcode opcode = OPCODE_UNKNOWN;
+	/** The description of the instruction. */
+	const Instruction_Description* description = NULL;
+	/** The mnemonic of the instruction, which is lowercase in source files. */
+	char mnemonic[16];
+	/** The length of the mnemonic. */
+	size_t mnemonic_len = 0;
+
+	if(bench_workload_chance(state, state->workload->macro_density)) {
+		if(bench_workload_chance(state, 50)) {
+			fprintf(state->file, "\tla %s, D%zu", bench_workload_register(state),
+				bench_workload_below(state, state->n_data_labels));
+		} else {
+			fprintf(state->file, "\tli %s, 0x%llx", bench_workload_register(state),
+				(unsigned long long)(bench_workload_random(state) >>
+				(bench_workload_chance(state, 50) ? 32 : 49)));
+		}
+
+		return;
+	}
+
+	opcode = bench_workload_opcode(state);
+	description = get_instruction_description(opcode);
+
+	for(mnemonic_len = 0; description->mnemonic[mnemonic_len] &&
+		mnemonic_len < sizeof(mnemonic) - 1; mnemonic_len++) {
+		mnemonic[mnemonic_len] = description->mnemonic[mnemonic_len] | 0x20;
+	}
+	mnemonic[mnemonic_len] = '\0';
+
+	fprintf(state->file, "\t%s", mnemonic);
+
+	switch(description->signature) {
+		case OPERAND_SIGNATURE_NONE:
+			break;
+		case OPERAND_SIGNATURE_IMM:
+			fputc(' ', state->file);
+			bench_workload_print_branch_target(state);
+			break;
+		case OPERAND_SIGNATURE_RD_RS:
+			fprintf(state->file, " %s, %s", bench_workload_register(state),
+				bench_workload_register(state));
+			break;
+		case OPERAND_SIGNATURE_RD_RS_RT:
+			fprintf(state->file, " %s, %s, %s", bench_workload_register(state),
+				bench_workload_register(state), bench_workload_register(state));
+			break;
+		case OPERAND_SIGNATURE_RD_RT_SA:
+			fprintf(state->file, " %s, %s, %zu", bench_workload_register(state),
+				bench_workload_register(state), bench_workload_below(state, 32));
+			break;
+		case OPERAND_SIGNATURE_RS:
+			fprintf(state->file, " %s", bench_workload_register(state));
+			break;
+		case OPERAND_SIGNATURE_RS_IMM:
+			fprintf(state->file, " %s, ", bench_workload_register(state));
+			bench_workload_print_branch_target(state);
+			break;
+		case OPERAND_SIGNATURE_RT_IMM:
+			fprintf(state->file, " %s, 0x%zx", bench_workload_register(state),
+				bench_workload_below(state, 0x10000));
+			break;
+		case OPERAND_SIGNATURE_RT_OFFSET:
+			fprintf(state->file, " %s, %zu(%s)", bench_workload_register(state),
+				bench_workload_below(state, 256) * 4,
+				bench_workload_base_registers[bench_workload_below(state,
+				sizeof(bench_workload_base_registers) / sizeof(const char*))]);
+			break;
+		case OPERAND_SIGNATURE_RT_RS_IMM:
+			fprintf(state->file, " %s, %s, ", bench_workload_register(state),
+				bench_workload_register(state));
+			if(description->delay_slot) {
+				bench_workload_print_branch_target(state);
+			} else {
+				fprintf(state->file, "%zu", bench_workload_below(state, 0x8000));
+			}
+			break;
+		case OPERAND_SIGNATURE_TARGET:
+			fprintf(state->file, " L%zu",
+				bench_workload_below(state, state->n_text_labels));
+			break;
+	}
+}
+
+
+/**
+ * Prints a single data directive.
+ */
+static void bench_workload_print_data(Bench_Workload_State* state)
+{
+	/** The kind of directive. */
+	size_t kind = bench_workload_below(state, 8);
+
+	if(bench_workload_chance(state, state->workload->string_density)) {
+		fprintf(state->file, "\t.asciiz \"");
+		for(size_t i = 0; i < state->workload->string_length; i++) {
+			/** A printable character, other than those needing an escape. */
+			char c = ' ' + bench_workload_below(state, '~' - ' ' + 1);
+
+			fputc((c == '"' || c == '\\') ? '_' : c, state->file);
+		}
+
+		fputc('"', state->file);
+		return;
+	}
+
+	if(kind < 4) {
+		fprintf(state->file, "\t.word 0x%llx",
+			(unsigned long long)(bench_workload_random(state) >> 32));
+		for(size_t i = bench_workload_below(state, 4); i > 0; i--) {
+			if(bench_workload_chance(state, 25)) {
+				fprintf(state->file, ", D%zu",
+					bench_workload_below(state, state->n_data_labels));
+			} else {
+				fprintf(state->file, ", %zu", bench_workload_below(state, 100000));
+			}
+		}
+	} else if(kind < 6) {
+		fprintf(state->file, "\t.byte %zu", bench_workload_below(state, 256));
+		for(size_t i = bench_workload_below(state, 8); i > 0; i--) {
+			fprintf(state->file, ", %zu", bench_workload_below(state, 256));
+		}
+	} else if(kind < 7) {
+		fprintf(state->file, "\t.short %zu", bench_workload_below(state, 0x10000));
+	} else {
+		fprintf(state->file, "\t.space %zu", 4 + bench_workload_below(state, 60));
+	}
+}
+
+
+/**
+ * Prints a block of lines in a single section.
+ */
+static void bench_workload_print_block(Bench_Workload_State* state,
+	const bool data)
+{
+	fprintf(state->file, data ? "\t.data\n" : "\t.text\n");
+	state->n_lines++;
+
+	for(size_t i = 1; i < BENCH_WORKLOAD_BLOCK_LINES &&
+		state->n_lines < state->workload->n_lines; i++) {
+		if(bench_workload_chance(state, state->workload->label_density)) {
+			if(data) {
+				fprintf(state->file, "D%zu:", state->n_data_labels++);
+			} else {
+				fprintf(state->file, "L%zu:", state->n_text_labels++);
+			}
+		}
+
+		if(data) {
+			bench_workload_print_data(state);
+		} else {
+			bench_workload_print_instruction(state);
+		}
+
+		if(bench_workload_chance(state, 10)) {
+			fprintf(state->file, "    # line %zu", state->n_lines + 1);
+		}
+
+		fputc('\n', state->file);
+		state->n_lines++;
+	}
+}
+
+
+/**
+ * Writes a generated MIPS source file. Blocks of text and data are
+ * interleaved at the configured ratio, beginning with a label in each section
+ * so that every reference has a target.
+ */
+void bench_generate_workload(FILE* file,
+	const Bench_Workload* workload)
+{
+	/** The state of the workload being generated. */
+	Bench_Workload_State state = {
+		.file = file,
+		.workload = workload,
+		.random = workload->seed ? workload->seed : 1
+	};
+
+	bench_workload_weight_opcodes(&state);
+
+	fprintf(file, "# Generated workload: %zu lines, seed %llu\n", workload->n_lines,
+		(unsigned long long)workload->seed);
+	fprintf(file, "\t.data\nD0:\t.word 0\n\t.text\n\t.globl L0\nL0:\tnop\n");
+	state.n_lines = 6;
+	state.n_data_labels = 1;
+	state.n_text_labels = 1;
+
+	while(state.n_lines < workload->n_lines) {
+		bench_workload_print_block(&state,
+			bench_workload_chance(&state, workload->data_ratio));
+	}
+}
@@ -6,9 +6,13 @@
 #include <as.h>
 #include <arch.h>
 #include <codegen.h>
+#include <directive.h>
+#include <instruction.h>
 #include <operand.h>
 #include <section.h>
 #include <stdlib.h>
+#include <string.h>
+#include <statement.h>
 #include <symtab.h>
 #include <test.h>
 
@@ -25,27 +29,25 @@ int teardown_codegen_test_suite(void) {
 void test_encode_i_type(void) {
 	/** The executable symbol table. */
 	Symbol_Table symbol_table;
+	/** The string pool holding symbol names. */
+	String_Pool string_pool;
+	/** The section that instructions are encoded in. */
+	Section* section = NULL;
 	uint8_t opcode = 0;
 	uint8_t rs = 0;
 	uint8_t rt = 0;
 	Operand imm;
 	size_t program_counter = 0;
-	Encoding_Entity* encoded_instruction = NULL;
 	Assembler_Status status;
 
-	// Initialise with room for the null symbol entry.
-	symbol_table.n_entries = 1;
-	symbol_table.symbols = malloc(sizeof(Symbol));
-
-	// Create the null symbol entry.
-	// This is required as per ELF specification.
-	symbol_table.symbols[0].section = NULL;
-	symbol_table.symbols[0].offset = 0;
-
-	// Create an empty name entry, so as to not disrupt other processes that
-	// require handling of this string.
-	symbol_table.symbols[0].name = malloc(1);
-	symbol_table.symbols[0].name[0] = '\0';
+	// Initialise with the null symbol entry.
+	status = initialise_string_pool(&string_pool);
+	CU_ASSERT(status == ASSEMBLER_STATUS_SUCCESS);
+	status = initialise_symbol_table(&symbol_table, &string_pool);
+	CU_ASSERT(status == ASSEMBLER_STATUS_SUCCESS);
+	status = create_section(&section, ".text", SHT_PROGBITS,
+		SHF_ALLOC | SHF_EXECINSTR);
+	CU_ASSERT(status == ASSEMBLER_STATUS_SUCCESS);
 
 	// ADDI $t1, $t0, 0x50
 	opcode = 0x8;
@@ -54,7 +56,7 @@ void test_encode_i_type(void) {
 	imm.type = OPERAND_TYPE_NUMERIC_LITERAL;
 	imm.numeric_literal = 0x50;
 
-	status = encode_i_type(&encoded_instruction,
+	status = encode_i_type(section,
 		&symbol_table,
 		opcode,
 		rs,
@@ -62,7 +64,7 @@ void test_encode_i_type(void) {
 		imm,
 		program_counter);
 
-	CU_ASSERT(*(uint32_t*)encoded_instruction->data == 0x21090050);
+	CU_ASSERT(*(uint32_t*)section->data == 0x21090050);
 	CU_ASSERT(status == ASSEMBLER_STATUS_SUCCESS);
 
 	// ORI $t3, $a0, 0x50
@@ -72,7 +74,7 @@ void test_encode_i_type(void) {
 	imm.type = OPERAND_TYPE_NUMERIC_LITERAL;
 	imm.numeric_literal = 0x50;
 
-	status = encode_i_type(&encoded_instruction,
+	status = encode_i_type(section,
 		&symbol_table,
 		opcode,
 		rs,
@@ -80,22 +82,75 @@ void test_encode_i_type(void) {
 		imm,
 		program_counter);
 
-	CU_ASSERT(*(uint32_t*)encoded_instruction->data == 0x348B0050);
+	CU_ASSERT(*(uint32_t*)(section->data + 4) == 0x348B0050);
 	CU_ASSERT(status == ASSEMBLER_STATUS_SUCCESS);
+	CU_ASSERT(section->size == 8);
+	CU_ASSERT(section->n_reloc_entries == 0);
 
-	free_encoding_entity(encoded_instruction);
+	free_section(section);
 
 	free_symbol_table(&symbol_table);
+	free_string_pool(&string_pool);
 }
 
 
 void test_encode_j_type(void) {
+	/** The executable symbol table. */
+	Symbol_Table symbol_table;
+	/** The string pool holding symbol names. */
+	String_Pool string_pool;
+	/** The section that instructions are encoded in. */
+	Section* section = NULL;
+	Operand imm;
+	size_t program_counter = 0;
+	Assembler_Status status;
+
+	status = initialise_string_pool(&string_pool);
+	CU_ASSERT(status == ASSEMBLER_STATUS_SUCCESS);
+	status = initialise_symbol_table(&symbol_table, &string_pool);
+	CU_ASSERT(status == ASSEMBLER_STATUS_SUCCESS);
+	status = create_section(&section, ".text", SHT_PROGBITS,
+		SHF_ALLOC | SHF_EXECINSTR);
+	CU_ASSERT(status == ASSEMBLER_STATUS_SUCCESS);
+
+	// J 0x100
+	imm.type = OPERAND_TYPE_NUMERIC_LITERAL;
+	imm.numeric_literal = 0x100;
+
+	status = encode_j_type(section,
+		&symbol_table,
+		0x2,
+		imm,
+		program_counter);
+
+	CU_ASSERT(*(uint32_t*)section->data == 0x8000040);
+	CU_ASSERT(status == ASSEMBLER_STATUS_SUCCESS);
+
+	// J undefined, which is not in the symbol table.
+	imm.type = OPERAND_TYPE_SYMBOL;
+	status = string_pool_intern(&string_pool, "undefined", 9, &imm.symbol);
+	CU_ASSERT(status == ASSEMBLER_STATUS_SUCCESS);
+
+	status = encode_j_type(section,
+		&symbol_table,
+		0x2,
+		imm,
+		program_counter + 4);
+
+	CU_ASSERT(status == CODEGEN_ERROR_MISSING_SYMBOL);
+	CU_ASSERT(section->size == 4);
+	CU_ASSERT(section->n_reloc_entries == 0);
 
+	free_section(section);
+
+	free_symbol_table(&symbol_table);
+	free_string_pool(&string_pool);
 }
 
 
 void test_encode_r_type(void) {
-	Encoding_Entity* encoded_instruction = NULL;
+	/** The section that instructions are encoded in. */
+	Section* section = NULL;
 	Assembler_Status status;
 	uint8_t opcode = 0;
 	uint8_t func = 0;
@@ -103,6 +158,10 @@ void test_encode_r_type(void) {
 	uint8_t rs = 0;
 	uint8_t rt = 0;
 
+	status = create_section(&section, ".text", SHT_PROGBITS,
+		SHF_ALLOC | SHF_EXECINSTR);
+	CU_ASSERT(status == ASSEMBLER_STATUS_SUCCESS);
+
 	// ADD, $t0, $t0, $t1
 	opcode = 0;
 	func = 0x20;
@@ -110,14 +169,12 @@ void test_encode_r_type(void) {
 	rs = encode_operand_register(REGISTER_$T0);
 	rt = encode_operand_register(REGISTER_$T1);
 
-	status = encode_r_type(&encoded_instruction,
+	status = encode_r_type(section,
 		opcode, rd, rs, rt, 0, func);
 
-	CU_ASSERT(*(uint32_t*)encoded_instruction->data == 0x1094020);
+	CU_ASSERT(*(uint32_t*)section->data == 0x1094020);
 	CU_ASSERT(status == ASSEMBLER_STATUS_SUCCESS);
 
-	free_encoding_entity(encoded_instruction);
-
 	// SUB, $t1, $t1, $t0
 	opcode = 0;
 	func = 0x22;
@@ -125,11 +182,332 @@ void test_encode_r_type(void) {
 	rs = encode_operand_register(REGISTER_$T1);
 	rt = encode_operand_register(REGISTER_$T0);
 
-	status = encode_r_type(&encoded_instruction,
+	status = encode_r_type(section,
 		opcode, rd, rs, rt, 0, func);
 
-	CU_ASSERT(*(uint32_t*)encoded_instruction->data == 0x1284822);
+	CU_ASSERT(*(uint32_t*)(section->data + 4) == 0x1284822);
+	CU_ASSERT(status == ASSEMBLER_STATUS_SUCCESS);
+	CU_ASSERT(section->size == 8);
+
+	free_section(section);
+}
+
+
+/**
+ * Tests that instructions are encoded from their instruction descriptions.
+ */
+void test_encode_instruction(void) {
+	/** The executable symbol table. */
+	Symbol_Table symbol_table;
+	/** The string pool holding symbol names. */
+	String_Pool string_pool;
+	/** The section that instructions are encoded in. */
+	Section* section = NULL;
+	/** The instruction to encode. */
+	Instruction instruction;
+	/** The operands of the instruction being encoded. */
+	Operand operands[3];
+	/** The encoded instruction words. */
+	uint32_t* encoding = NULL;
+	Assembler_Status status;
+
+	status = initialise_string_pool(&string_pool);
+	CU_ASSERT(status == ASSEMBLER_STATUS_SUCCESS);
+	status = initialise_symbol_table(&symbol_table, &string_pool);
+	CU_ASSERT(status == ASSEMBLER_STATUS_SUCCESS);
+	status = create_section(&section, ".text", SHT_PROGBITS,
+		SHF_ALLOC | SHF_EXECINSTR);
+	CU_ASSERT(status == ASSEMBLER_STATUS_SUCCESS);
+
+	instruction.opseq.operands = operands;
+
+	// MUL $t5, $t4, $t3
+	instruction.opcode = OPCODE_MUL;
+	instruction.opseq.n_operands = 3;
+	operands[0].type = OPERAND_TYPE_REGISTER;
+	operands[0].reg = REGISTER_$T5;
+	operands[1].type = OPERAND_TYPE_REGISTER;
+	operands[1].reg = REGISTER_$T4;
+	operands[2].type = OPERAND_TYPE_REGISTER;
+	operands[2].reg = REGISTER_$T3;
+	status = encode_instruction(section, &symbol_table, &instruction, 0);
+	CU_ASSERT(status == ASSEMBLER_STATUS_SUCCESS);
+
+	// SLL $t6, $t5, 2
+	instruction.opcode = OPCODE_SLL;
+	operands[0].reg = REGISTER_$T6;
+	operands[1].reg = REGISTER_$T5;
+	operands[2].type = OPERAND_TYPE_NUMERIC_LITERAL;
+	operands[2].numeric_literal = 2;
+	status = encode_instruction(section, &symbol_table, &instruction, 4);
 	CU_ASSERT(status == ASSEMBLER_STATUS_SUCCESS);
 
-	free_encoding_entity(encoded_instruction);
+	// JALR $t9
+	instruction.opcode = OPCODE_JALR;
+	instruction.opseq.n_operands = 1;
+	operands[0].reg = REGISTER_$T9;
+	status = encode_instruction(section, &symbol_table, &instruction, 8);
+	CU_ASSERT(status == ASSEMBLER_STATUS_SUCCESS);
+
+	// BGEZ $a0, 0x10
+	instruction.opcode = OPCODE_BGEZ;
+	instruction.opseq.n_operands = 2;
+	operands[0].reg = REGISTER_$A0;
+	operands[1].type = OPERAND_TYPE_NUMERIC_LITERAL;
+	operands[1].numeric_literal = 0x10;
+	status = encode_instruction(section, &symbol_table, &instruction, 12);
+	CU_ASSERT(status == ASSEMBLER_STATUS_SUCCESS);
+
+	// BAL 0x10
+	instruction.opcode = OPCODE_BAL;
+	instruction.opseq.n_operands = 1;
+	operands[0].type = OPERAND_TYPE_NUMERIC_LITERAL;
+	operands[0].numeric_literal = 0x10;
+	status = encode_instruction(section, &symbol_table, &instruction, 16);
+	CU_ASSERT(status == ASSEMBLER_STATUS_SUCCESS);
+
+	// JAL 0x40
+	instruction.opcode = OPCODE_JAL;
+	operands[0].numeric_literal = 0x40;
+	status = encode_instruction(section, &symbol_table, &instruction, 20);
+	CU_ASSERT(status == ASSEMBLER_STATUS_SUCCESS);
+
+	CU_ASSERT(section->size == 24);
+	encoding = (uint32_t*)section->data;
+	CU_ASSERT(encoding[0] == 0x018B6898);
+	CU_ASSERT(encoding[1] == 0x000D7080);
+	CU_ASSERT(encoding[2] == 0x0320F809);
+	CU_ASSERT(encoding[3] == 0x04810010);
+	CU_ASSERT(encoding[4] == 0x04110010);
+	CU_ASSERT(encoding[5] == 0x0C000010);
+
+	// Operand counts are checked against the operand signature.
+	instruction.opcode = OPCODE_ADD;
+	status = encode_instruction(section, &symbol_table, &instruction, 24);
+	CU_ASSERT(status == CODEGEN_ERROR_OPERAND_COUNT_MISMATCH);
+
+	// Deprecated instructions and unexpanded pseudo-instructions are rejected.
+	instruction.opcode = OPCODE_MULT;
+	status = encode_instruction(section, &symbol_table, &instruction, 24);
+	CU_ASSERT(status == CODEGEN_ERROR_DEPRECATED_OPCODE);
+	instruction.opcode = OPCODE_LA;
+	status = encode_instruction(section, &symbol_table, &instruction, 24);
+	CU_ASSERT(status == CODEGEN_ERROR_BAD_OPCODE);
+	CU_ASSERT(section->size == 24);
+
+	CU_ASSERT(get_instruction_description(OPCODE_JAL)->delay_slot);
+	CU_ASSERT(!get_instruction_description(OPCODE_ADDIU)->delay_slot);
+	CU_ASSERT(get_instruction_description(OPCODE_SW)->size == 4);
+	CU_ASSERT_STRING_EQUAL(get_opcode_string(OPCODE_SYSCALL), "SYSCALL");
+
+	free_section(section);
+
+	free_symbol_table(&symbol_table);
+	free_string_pool(&string_pool);
+}
+
+
+/**
+ * Tests that a batch of instructions is encoded identically to encoding each
+ * instruction individually, with the same relocation entries.
+ */
+void test_encode_instruction_batch(void) {
+	/** The executable symbol table. */
+	Symbol_Table symbol_table;
+	/** The string pool holding symbol names. */
+	String_Pool string_pool;
+	/** The section that instructions are individually encoded in. */
+	Section* section = NULL;
+	/** The interned name of the symbol referenced by the instructions. */
+	String_Id target;
+	/** The batch of instructions to encode. */
+	Instruction instructions[5];
+	/** The operands of each instruction. */
+	Operand operands[5][3];
+	/** The batch encoded instructions. */
+	uint32_t encoding[5];
+	/** The batch relocation entries. */
+	Reloc_Entry reloc_entries[5];
+	size_t n_reloc_entries = 0;
+	Assembler_Status status;
+
+	status = initialise_string_pool(&string_pool);
+	CU_ASSERT(status == ASSEMBLER_STATUS_SUCCESS);
+	status = initialise_symbol_table(&symbol_table, &string_pool);
+	CU_ASSERT(status == ASSEMBLER_STATUS_SUCCESS);
+	status = create_section(&section, ".text", SHT_PROGBITS,
+		SHF_ALLOC | SHF_EXECINSTR);
+	CU_ASSERT(status == ASSEMBLER_STATUS_SUCCESS);
+
+	status = string_pool_intern(&string_pool, "target", 6, &target);
+	CU_ASSERT(status == ASSEMBLER_STATUS_SUCCESS);
+	CU_ASSERT_PTR_NOT_NULL(symtab_add_symbol(&symbol_table, target, section, 0x40));
+
+	for(size_t i = 0; i < 5; i++) {
+		instructions[i].opseq.operands = operands[i];
+		for(size_t j = 0; j < 3; j++) {
+			operands[i][j].type = OPERAND_TYPE_REGISTER;
+			operands[i][j].flags = DEFAULT_OPERAND_FLAGS;
+			operands[i][j].offset = 0;
+		}
+	}
+
+	// ADD $t2, $t0, $t1
+	instructions[0].opcode = OPCODE_ADD;
+	instructions[0].opseq.n_operands = 3;
+	operands[0][0].reg = REGISTER_$T2;
+	operands[0][1].reg = REGISTER_$T0;
+	operands[0][2].reg = REGISTER_$T1;
+
+	// LW $t1, 4($sp)
+	instructions[1].opcode = OPCODE_LW;
+	instructions[1].opseq.n_operands = 2;
+	operands[1][0].reg = REGISTER_$T1;
+	operands[1][1].reg = REGISTER_$SP;
+	operands[1][1].offset = 4;
+
+	// LUI $t0, %hi(target)
+	instructions[2].opcode = OPCODE_LUI;
+	instructions[2].opseq.n_operands = 2;
+	operands[2][0].reg = REGISTER_$T0;
+	operands[2][1].type = OPERAND_TYPE_SYMBOL;
+	operands[2][1].symbol = target;
+	operands[2][1].flags.mask = OPERAND_MASK_HIGH;
+
+	// ADDIU $t0, $t0, -1
+	instructions[3].opcode = OPCODE_ADDIU;
+	instructions[3].opseq.n_operands = 3;
+	operands[3][0].reg = REGISTER_$T0;
+	operands[3][1].reg = REGISTER_$T0;
+	operands[3][2].type = OPERAND_TYPE_NUMERIC_LITERAL;
+	operands[3][2].numeric_literal = -1;
+
+	// JAL target
+	instructions[4].opcode = OPCODE_JAL;
+	instructions[4].opseq.n_operands = 1;
+	operands[4][0].type = OPERAND_TYPE_SYMBOL;
+	operands[4][0].symbol = target;
+
+	for(size_t i = 0; i < 5; i++) {
+		status = encode_instruction(section, &symbol_table, &instructions[i],
+			0x100 + (i * 4));
+		CU_ASSERT(status == ASSEMBLER_STATUS_SUCCESS);
+	}
+
+	status = encode_instruction_batch(&symbol_table, instructions, 5, 0x100,
+		encoding, reloc_entries, &n_reloc_entries);
+	CU_ASSERT(status == ASSEMBLER_STATUS_SUCCESS);
+
+	CU_ASSERT(section->size == sizeof(encoding));
+	CU_ASSERT(memcmp(section->data, encoding, sizeof(encoding)) == 0);
+
+	CU_ASSERT(n_reloc_entries == 2);
+	CU_ASSERT(section->n_reloc_entries == n_reloc_entries);
+	for(size_t i = 0; i < n_reloc_entries && i < section->n_reloc_entries; i++) {
+		CU_ASSERT(reloc_entries[i].symbol_name == section->reloc_entries[i].symbol_name);
+		CU_ASSERT(reloc_entries[i].offset == section->reloc_entries[i].offset);
+		CU_ASSERT(reloc_entries[i].type == section->reloc_entries[i].type);
+	}
+
+	CU_ASSERT(reloc_entries[0].offset == 0x108);
+	CU_ASSERT(reloc_entries[0].type == R_MIPS_HI16);
+	CU_ASSERT(reloc_entries[1].offset == 0x110);
+	CU_ASSERT(reloc_entries[1].type == R_MIPS_26);
+
+	// Errors in any instruction fail the batch.
+	instructions[1].opseq.n_operands = 3;
+	status = encode_instruction_batch(&symbol_table, instructions, 5, 0x100,
+		encoding, reloc_entries, &n_reloc_entries);
+	CU_ASSERT(status == CODEGEN_ERROR_OPERAND_COUNT_MISMATCH);
+
+	free_section(section);
+
+	free_symbol_table(&symbol_table);
+	free_string_pool(&string_pool);
+}
+
+
+/**
+ * Tests that data directives encode exactly the number of bytes calculated for
+ * them by `get_statement_size`.
+ */
+void test_encode_directive_size(void) {
+	/** The executable symbol table. */
+	Symbol_Table symbol_table;
+	/** The string pool holding symbol names. */
+	String_Pool string_pool;
+	/** The section that directives are encoded in. */
+	Section* section = NULL;
+	/** The statement containing the directive to encode. */
+	Statement statement;
+	/** The operands of the directive. */
+	Operand operands[3];
+	/** The directives to encode, with the number of operands of each. */
+	const Directive_Type types[] = {
+		DIRECTIVE_BYTE, DIRECTIVE_SHORT, DIRECTIVE_LONG, DIRECTIVE_WORD,
+		DIRECTIVE_FILL, DIRECTIVE_SKIP, DIRECTIVE_SPACE
+	};
+	const size_t n_operands[] = { 3, 3, 2, 3, 3, 1, 2 };
+	const size_t expected_sizes[] = { 3, 6, 8, 12, 6, 3, 3 };
+	size_t statement_size = 0;
+	size_t initial_size = 0;
+	Assembler_Status status;
+
+	status = initialise_string_pool(&string_pool);
+	CU_ASSERT(status == ASSEMBLER_STATUS_SUCCESS);
+	status = initialise_symbol_table(&symbol_table, &string_pool);
+	CU_ASSERT(status == ASSEMBLER_STATUS_SUCCESS);
+	status = create_section(&section, ".data", SHT_PROGBITS,
+		SHF_ALLOC | SHF_WRITE);
+	CU_ASSERT(status == ASSEMBLER_STATUS_SUCCESS);
+
+	statement.type = STATEMENT_TYPE_DIRECTIVE;
+	statement.n_labels = 0;
+	statement.labels = NULL;
+	statement.next = NULL;
+	statement.directive.opseq.operands = operands;
+
+	for(size_t i = 0; i < 3; i++) {
+		operands[i].type = OPERAND_TYPE_NUMERIC_LITERAL;
+		operands[i].flags = DEFAULT_OPERAND_FLAGS;
+	}
+
+	for(size_t i = 0; i < sizeof(types) / sizeof(types[0]); i++) {
+		// For `.fill` this is a count of 3, a size of 2 and a value of 0x1234.
+		// For `.skip` and `.space` this is a size of 3, filled with 2.
+		operands[0].numeric_literal = 3;
+		operands[1].numeric_literal = 2;
+		operands[2].numeric_literal = 0x1234;
+
+		statement.directive.type = types[i];
+		statement.directive.opseq.n_operands = n_operands[i];
+
+		status = get_statement_size(&statement, &statement_size);
+		CU_ASSERT(status == ASSEMBLER_STATUS_SUCCESS);
+		CU_ASSERT(statement_size == expected_sizes[i]);
+
+		initial_size = section->size;
+		status = encode_directive(section, &symbol_table, &statement.directive,
+			initial_size);
+		CU_ASSERT(status == ASSEMBLER_STATUS_SUCCESS);
+		CU_ASSERT(section->size - initial_size == statement_size);
+	}
+
+	// `.byte 3, 2, 0x1234` is truncated to a byte per value.
+	CU_ASSERT(section->data[0] == 3);
+	CU_ASSERT(section->data[2] == 0x34);
+	// `.short 3, 2, 0x1234` is encoded in little-endian order.
+	CU_ASSERT(section->data[7] == 0x34);
+	CU_ASSERT(section->data[8] == 0x12);
+	// `.fill 3, 2, 0x1234`.
+	CU_ASSERT(section->data[29] == 0x34);
+	CU_ASSERT(section->data[34] == 0x12);
+	// `.space 3, 2`.
+	CU_ASSERT(section->data[40] == 2);
+	CU_ASSERT(section->size == 41);
+
+	free_section(section);
+
+	free_symbol_table(&symbol_table);
+	free_string_pool(&string_pool);
 }
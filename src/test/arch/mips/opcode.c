@@ -0,0 +1,88 @@
+#include <CUnit/CUnit.h>
+#include <CUnit/CUError.h>
+#include <CUnit/Basic.h>
+#include <ctype.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+#include <as.h>
+#include <arch.h>
+#include <parsing.h>
+#include <test.h>
+
+/**
+ * Every recognised mnemonic, and the opcode that it is parsed as.
+ */
+static const struct {
+	const char* mnemonic;
+	Opcode opcode;
+} test_opcode_mnemonics[] = {
+	{ "add", OPCODE_ADD }, { "addi", OPCODE_ADDI }, { "addiu", OPCODE_ADDIU },
+	{ "addu", OPCODE_ADDU }, { "and", OPCODE_AND }, { "andi", OPCODE_ANDI },
+	{ "bal", OPCODE_BAL }, { "beq", OPCODE_BEQ }, { "beqz", OPCODE_BEQZ },
+	{ "bgez", OPCODE_BGEZ }, { "bne", OPCODE_BNE }, { "blez", OPCODE_BLEZ },
+	{ "div", OPCODE_DIV }, { "j", OPCODE_J }, { "jal", OPCODE_JAL },
+	{ "jalr", OPCODE_JALR }, { "jr", OPCODE_JR }, { "la", OPCODE_LA },
+	{ "lb", OPCODE_LB }, { "lbu", OPCODE_LBU }, { "lhu", OPCODE_LHU },
+	{ "li", OPCODE_LI }, { "lui", OPCODE_LUI }, { "lw", OPCODE_LW },
+	{ "move", OPCODE_MOVE }, { "muh", OPCODE_MUH }, { "muhu", OPCODE_MUHU },
+	{ "mul", OPCODE_MUL }, { "mulu", OPCODE_MULU }, { "mult", OPCODE_MULT },
+	{ "multu", OPCODE_MULTU }, { "nor", OPCODE_NOR }, { "nop", OPCODE_NOP },
+	{ "or", OPCODE_OR }, { "ori", OPCODE_ORI }, { "sb", OPCODE_SB },
+	{ "sh", OPCODE_SH }, { "sll", OPCODE_SLL }, { "sub", OPCODE_SUB },
+	{ "subu", OPCODE_SUBU }, { "sw", OPCODE_SW }, { "syscall", OPCODE_SYSCALL }
+};
+
+int init_opcode_test_suite(void) {
+	return 0;
+}
+
+
+int teardown_opcode_test_suite(void) {
+	return 0;
+}
+
+
+/**
+ * Tests that every mnemonic is parsed as its opcode, regardless of case.
+ */
+void test_parse_opcode_symbol(void)
+{
+	/** The number of mnemonics tested. */
+	const size_t n_mnemonics = sizeof(test_opcode_mnemonics) /
+		sizeof(test_opcode_mnemonics[0]);
+	/** An upper-case copy of each mnemonic. */
+	char upper[16];
+
+	for(size_t i = 0; i < n_mnemonics; i++) {
+		CU_ASSERT(parse_opcode_symbol(test_opcode_mnemonics[i].mnemonic) ==
+			test_opcode_mnemonics[i].opcode);
+
+		for(size_t c = 0; c <= strlen(test_opcode_mnemonics[i].mnemonic); c++) {
+			upper[c] = toupper(test_opcode_mnemonics[i].mnemonic[c]);
+		}
+
+		CU_ASSERT(parse_opcode_symbol(upper) == test_opcode_mnemonics[i].opcode);
+	}
+
+	CU_ASSERT(parse_opcode_symbol("AddIu") == OPCODE_ADDIU);
+}
+
+
+/**
+ * Tests that only exact mnemonics are recognised.
+ */
+void test_parse_opcode_symbol_exact(void)
+{
+	// Prefixes and extensions of valid mnemonics.
+	CU_ASSERT(parse_opcode_symbol("ad") == OPCODE_UNKNOWN);
+	CU_ASSERT(parse_opcode_symbol("addiux") == OPCODE_UNKNOWN);
+	CU_ASSERT(parse_opcode_symbol("balc") == OPCODE_UNKNOWN);
+	CU_ASSERT(parse_opcode_symbol("syscal") == OPCODE_UNKNOWN);
+	CU_ASSERT(parse_opcode_symbol("syscalls") == OPCODE_UNKNOWN);
+	CU_ASSERT(parse_opcode_symbol("jx") == OPCODE_UNKNOWN);
+
+	CU_ASSERT(parse_opcode_symbol("") == OPCODE_UNKNOWN);
+	CU_ASSERT(parse_opcode_symbol("foo") == OPCODE_UNKNOWN);
+	CU_ASSERT(parse_opcode_symbol("a_d") == OPCODE_UNKNOWN);
+}
@@ -0,0 +1,82 @@
+#include <CUnit/CUnit.h>
+#include <CUnit/CUError.h>
+#include <CUnit/Basic.h>
+#include <ctype.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include <as.h>
+#include <arch.h>
+#include <parsing.h>
+#include <test.h>
+
+/**
+ * The ABI name of each register, indexed by register number.
+ */
+static const char* test_register_names[32] = {
+	"$zero", "$at", "$v0", "$v1", "$a0", "$a1", "$a2", "$a3",
+	"$t0", "$t1", "$t2", "$t3", "$t4", "$t5", "$t6", "$t7",
+	"$s0", "$s1", "$s2", "$s3", "$s4", "$s5", "$s6", "$s7",
+	"$t8", "$t9", "$k0", "$k1", "$gp", "$sp", "$fp", "$ra"
+};
+
+int init_register_test_suite(void) {
+	return 0;
+}
+
+
+int teardown_register_test_suite(void) {
+	return 0;
+}
+
+
+/**
+ * Tests every register number and ABI name, in both cases, and that each
+ * register encodes as its number.
+ */
+void test_parse_register_symbol(void)
+{
+	/** The numeric name of each register. */
+	char number[8];
+	/** An upper-case copy of each ABI name. */
+	char upper[8];
+	Register reg;
+
+	for(size_t i = 0; i < 32; i++) {
+		snprintf(number, sizeof(number), "$%zu", i);
+		reg = parse_register_symbol(number);
+		CU_ASSERT(reg != REGISTER_NONE);
+		CU_ASSERT(encode_operand_register(reg) == i);
+
+		CU_ASSERT(parse_register_symbol(test_register_names[i]) == reg);
+
+		for(size_t c = 0; c <= strlen(test_register_names[i]); c++) {
+			upper[c] = toupper(test_register_names[i][c]);
+		}
+
+		CU_ASSERT(parse_register_symbol(upper) == reg);
+	}
+
+	// `$s8` is an alias of `$fp`.
+	CU_ASSERT(parse_register_symbol("$s8") == REGISTER_$FP);
+	CU_ASSERT(parse_register_symbol("$1") == REGISTER_$AT);
+	CU_ASSERT(parse_register_symbol("$10") == REGISTER_$T2);
+}
+
+
+/**
+ * Tests that only exact register names are recognised.
+ */
+void test_parse_register_symbol_exact(void)
+{
+	const char* invalid[] = {
+		"$", "$32", "$99", "$100", "$01", "$1x", "$-1",
+		"$t", "$t10", "$s9", "$a4", "$v2", "$k2", "$zer", "$zeroo", "$ze",
+		"$ra0", "$gpx", "$xy", "t0", "0", ""
+	};
+
+	for(size_t i = 0; i < sizeof(invalid) / sizeof(invalid[0]); i++) {
+		CU_ASSERT(parse_register_symbol(invalid[i]) == REGISTER_NONE);
+	}
+}
@@ -0,0 +1,137 @@
+#include <CUnit/CUnit.h>
+#include <CUnit/CUError.h>
+#include <CUnit/Basic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <arena.h>
+#include <as.h>
+#include <test.h>
+
+int init_arena_test_suite(void) {
+	return 0;
+}
+
+
+int teardown_arena_test_suite(void) {
+	return 0;
+}
+
+
+/**
+ * Tests that allocations are aligned, do not overlap, and are counted.
+ */
+void test_arena_alloc(void)
+{
+	Arena arena;
+	Assembler_Status status;
+	uint8_t* first = NULL;
+	uint8_t* second = NULL;
+
+	status = initialise_arena(&arena);
+	CU_ASSERT(status == ASSEMBLER_STATUS_SUCCESS);
+	CU_ASSERT(arena.n_blocks == 1);
+
+	first = arena_alloc(&arena, 3);
+	second = arena_alloc(&arena, 24);
+	CU_ASSERT_PTR_NOT_NULL(first);
+	CU_ASSERT_PTR_NOT_NULL(second);
+	CU_ASSERT((uintptr_t)first % _Alignof(max_align_t) == 0);
+	CU_ASSERT((uintptr_t)second % _Alignof(max_align_t) == 0);
+	CU_ASSERT(second >= first + 3);
+
+	memset(first, 0xAA, 3);
+	memset(second, 0x55, 24);
+	CU_ASSERT(first[2] == 0xAA);
+
+	CU_ASSERT(arena.n_allocations == 2);
+	CU_ASSERT(arena.n_bytes_allocated == 27);
+
+	free_arena(&arena);
+	CU_ASSERT_PTR_NULL(arena.blocks);
+}
+
+
+/**
+ * Tests that the most recent allocation is extended in place, and that any
+ * other allocation is copied when resized.
+ */
+void test_arena_realloc(void)
+{
+	Arena arena;
+	Assembler_Status status;
+	uint32_t* words = NULL;
+	uint32_t* resized = NULL;
+	uint8_t* other = NULL;
+
+	status = initialise_arena(&arena);
+	CU_ASSERT(status == ASSEMBLER_STATUS_SUCCESS);
+
+	words = arena_realloc(&arena, NULL, 0, sizeof(uint32_t));
+	CU_ASSERT_PTR_NOT_NULL(words);
+	words[0] = 0xDEADBEEF;
+
+	// Growing the most recent allocation does not move it.
+	for(size_t i = 1; i < 64; i++) {
+		resized = arena_realloc(&arena, words, sizeof(uint32_t) * i,
+			sizeof(uint32_t) * (i + 1));
+		CU_ASSERT(resized == words);
+		words[i] = i;
+	}
+
+	// Once another allocation has been made, growing it requires a copy.
+	other = arena_alloc(&arena, 1);
+	CU_ASSERT_PTR_NOT_NULL(other);
+	resized = arena_realloc(&arena, words, sizeof(uint32_t) * 64,
+		sizeof(uint32_t) * 65);
+	CU_ASSERT_PTR_NOT_NULL(resized);
+	CU_ASSERT(resized != words);
+	CU_ASSERT(resized[0] == 0xDEADBEEF);
+	CU_ASSERT(resized[63] == 63);
+
+	free_arena(&arena);
+}
+
+
+/**
+ * Tests allocations larger than a block, and allocations spanning many blocks.
+ */
+void test_arena_growth(void)
+{
+	Arena arena;
+	Assembler_Status status;
+	uint8_t* large = NULL;
+	uint8_t* small = NULL;
+	uint8_t* next = NULL;
+	char* copy = NULL;
+
+	status = initialise_arena(&arena);
+	CU_ASSERT(status == ASSEMBLER_STATUS_SUCCESS);
+
+	small = arena_alloc(&arena, 16);
+	large = arena_alloc(&arena, 0x100000);
+	CU_ASSERT_PTR_NOT_NULL(large);
+	memset(large, 0xFF, 0x100000);
+
+	// A large allocation is given its own block, and allocation continues from
+	// the current block.
+	next = arena_alloc(&arena, 16);
+	CU_ASSERT(next == small + 16);
+	CU_ASSERT(arena.n_blocks == 2);
+
+	for(size_t i = 0; i < 0x10000; i++) {
+		CU_ASSERT_PTR_NOT_NULL(arena_alloc(&arena, 40));
+	}
+
+	CU_ASSERT(arena.n_blocks > 2);
+	CU_ASSERT(arena.n_allocations == 0x10003);
+	CU_ASSERT(arena.n_bytes_reserved >= arena.n_bytes_allocated);
+
+	copy = arena_strndup(&arena, "label_name: ", 10);
+	CU_ASSERT_PTR_NOT_NULL(copy);
+	CU_ASSERT(strcmp(copy, "label_name") == 0);
+
+	free_arena(&arena);
+	CU_ASSERT(arena.n_blocks == 0);
+}
@@ -1,19 +1,116 @@
+/**
+ * Arena test suite.
+ */
+int init_arena_test_suite(void);
+int teardown_arena_test_suite(void);
+
+void test_arena_alloc(void);
+void test_arena_realloc(void);
+void test_arena_growth(void);
+
 /**
  * Codegen test suite.
  */
 int init_codegen_test_suite(void);
 int teardown_codegen_test_suite(void);
 
+void test_encode_directive_size(void);
 void test_encode_i_type(void);
+void test_encode_instruction(void);
+void test_encode_instruction_batch(void);
 void test_encode_j_type(void);
 void test_encode_r_type(void);
 
 /**
- * Preprocessor test suite.
+ * Opcode test suite.
+ */
+int init_opcode_test_suite(void);
+int teardown_opcode_test_suite(void);
+
+void test_parse_opcode_symbol(void);
+void test_parse_opcode_symbol_exact(void);
+
+/**
+ * Parser test suite.
+ */
+int init_parser_test_suite(void);
+int teardown_parser_test_suite(void);
+
+void test_parser_error_line(void);
+void test_parser_unterminated_string(void);
+void test_parser_unknown_register(void);
+
+/**
+ * Performance counters test suite.
+ */
+int init_perf_counters_test_suite(void);
+int teardown_perf_counters_test_suite(void);
+
+void test_perf_counters_count(void);
+
+/**
+ * Register test suite.
+ */
+int init_register_test_suite(void);
+int teardown_register_test_suite(void);
+
+void test_parse_register_symbol(void);
+void test_parse_register_symbol_exact(void);
+
+/**
+ * Scan test suite.
+ */
+int init_scan_test_suite(void);
+int teardown_scan_test_suite(void);
+
+void test_scan_skip_blank(void);
+void test_scan_find_newline(void);
+
+/**
+ * Section test suite.
+ */
+int init_section_test_suite(void);
+int teardown_section_test_suite(void);
+
+void test_section_write_growth(void);
+void test_section_reserve_and_reloc(void);
+void test_section_layout(void);
+void test_section_window(void);
+
+/**
+ * Stats test suite.
+ */
+int init_stats_test_suite(void);
+int teardown_stats_test_suite(void);
+
+void test_stats_count_lines(void);
+void test_stats_phase_timing(void);
+void test_stats_thread_cpu_time(void);
+void test_stats_trace_events(void);
+
+/**
+ * Symbol table test suite.
+ */
+int init_symtab_test_suite(void);
+int teardown_symtab_test_suite(void);
+
+void test_symtab_find_exact_match(void);
+void test_symtab_find_after_growth(void);
+void test_symtab_reserve(void);
+
+/**
+ * String pool test suite.
+ */
+int init_string_pool_test_suite(void);
+int teardown_string_pool_test_suite(void);
+
+void test_string_pool_deduplicate(void);
+void test_string_pool_growth(void);
+
+/**
+ * Trace test suite.
  */
-int init_preprocessor_test_suite(void);
-int teardown_preprocessor_test_suite(void);
+int init_trace_test_suite(void);
+int teardown_trace_test_suite(void);
 
-void test_trim_leading_whitespace(void);
-void test_trim_internal_whitespace(void);
-void test_no_trailing_newline(void);
+void test_trace_enable_channels(void);
@@ -11,6 +11,28 @@ int main(int argc, char **argv) {
 		return CU_get_error();
 	}
 
+	CU_pSuite arena_test_suite = CU_add_suite("Arena",
+		init_arena_test_suite, teardown_arena_test_suite);
+	if(!arena_test_suite) {
+		return CU_get_error();
+	}
+
+	/* add the tests to the suite */
+	if(!CU_add_test(arena_test_suite,
+		"Allocate from arena", test_arena_alloc)) {
+		return CU_get_error();
+	}
+
+	if(!CU_add_test(arena_test_suite,
+		"Resize arena allocations", test_arena_realloc)) {
+		return CU_get_error();
+	}
+
+	if(!CU_add_test(arena_test_suite,
+		"Allocate across arena blocks", test_arena_growth)) {
+		return CU_get_error();
+	}
+
 	CU_pSuite codegen_test_suite = CU_add_suite("Codegen",
 		init_codegen_test_suite, teardown_codegen_test_suite);
 	if(!codegen_test_suite) {
@@ -33,27 +55,210 @@ int main(int argc, char **argv) {
 		return CU_get_error();
 	}
 
-	CU_pSuite preprocessor_test_suite = CU_add_suite("Preprocessor",
-		init_preprocessor_test_suite, teardown_preprocessor_test_suite);
-	if(!preprocessor_test_suite) {
+	if(!CU_add_test(codegen_test_suite,
+		"Encode instructions from descriptions", test_encode_instruction)) {
+		return CU_get_error();
+	}
+
+	if(!CU_add_test(codegen_test_suite,
+		"Encode a batch of instructions", test_encode_instruction_batch)) {
+		return CU_get_error();
+	}
+
+	if(!CU_add_test(codegen_test_suite,
+		"Encode directives at their calculated size", test_encode_directive_size)) {
+		return CU_get_error();
+	}
+
+	CU_pSuite opcode_test_suite = CU_add_suite("Opcode",
+		init_opcode_test_suite, teardown_opcode_test_suite);
+	if(!opcode_test_suite) {
+		return CU_get_error();
+	}
+
+	/* add the tests to the suite */
+	if(!CU_add_test(opcode_test_suite,
+		"Parse opcode mnemonics", test_parse_opcode_symbol)) {
+		return CU_get_error();
+	}
+
+	if(!CU_add_test(opcode_test_suite,
+		"Reject inexact opcode mnemonics", test_parse_opcode_symbol_exact)) {
+		return CU_get_error();
+	}
+
+	CU_pSuite parser_test_suite = CU_add_suite("Parser",
+		init_parser_test_suite, teardown_parser_test_suite);
+	if(!parser_test_suite) {
+		return CU_get_error();
+	}
+
+	/* add the tests to the suite */
+	if(!CU_add_test(parser_test_suite,
+		"Report syntax errors on their line", test_parser_error_line)) {
+		return CU_get_error();
+	}
+
+	if(!CU_add_test(parser_test_suite,
+		"Report unterminated string literals on their line",
+		test_parser_unterminated_string)) {
+		return CU_get_error();
+	}
+
+	if(!CU_add_test(parser_test_suite,
+		"Report unrecognised registers on their line",
+		test_parser_unknown_register)) {
+		return CU_get_error();
+	}
+
+	CU_pSuite perf_counters_test_suite = CU_add_suite("Performance Counters",
+		init_perf_counters_test_suite, teardown_perf_counters_test_suite);
+	if(!perf_counters_test_suite) {
+		return CU_get_error();
+	}
+
+	/* add the tests to the suite */
+	if(!CU_add_test(perf_counters_test_suite,
+		"Count hardware events", test_perf_counters_count)) {
+		return CU_get_error();
+	}
+
+	CU_pSuite register_test_suite = CU_add_suite("Register",
+		init_register_test_suite, teardown_register_test_suite);
+	if(!register_test_suite) {
+		return CU_get_error();
+	}
+
+	/* add the tests to the suite */
+	if(!CU_add_test(register_test_suite,
+		"Parse every register name", test_parse_register_symbol)) {
+		return CU_get_error();
+	}
+
+	if(!CU_add_test(register_test_suite,
+		"Reject inexact register names", test_parse_register_symbol_exact)) {
+		return CU_get_error();
+	}
+
+	CU_pSuite scan_test_suite = CU_add_suite("Scan",
+		init_scan_test_suite, teardown_scan_test_suite);
+	if(!scan_test_suite) {
 		return CU_get_error();
 	}
 
 	/* add the tests to the suite */
-	if(!CU_add_test(preprocessor_test_suite,
-		"Trim leading whitespace", test_trim_leading_whitespace)) {
+	if(!CU_add_test(scan_test_suite,
+		"Skip blank characters", test_scan_skip_blank)) {
+		return CU_get_error();
+	}
+
+	if(!CU_add_test(scan_test_suite,
+		"Find newline characters", test_scan_find_newline)) {
+		return CU_get_error();
+	}
+
+	CU_pSuite section_test_suite = CU_add_suite("Section",
+		init_section_test_suite, teardown_section_test_suite);
+	if(!section_test_suite) {
 		return CU_get_error();
 	}
 
 	/* add the tests to the suite */
-	if(!CU_add_test(preprocessor_test_suite,
-		"Trim internal whitespace", test_trim_internal_whitespace)) {
+	if(!CU_add_test(section_test_suite,
+		"Write contiguous section data", test_section_write_growth)) {
+		return CU_get_error();
+	}
+
+	if(!CU_add_test(section_test_suite,
+		"Reserve section data and add relocations", test_section_reserve_and_reloc)) {
+		return CU_get_error();
+	}
+
+	if(!CU_add_test(section_test_suite,
+		"Lay out sections in the output file", test_section_layout)) {
+		return CU_get_error();
+	}
+
+	if(!CU_add_test(section_test_suite,
+		"Write through section windows", test_section_window)) {
+		return CU_get_error();
+	}
+
+	CU_pSuite stats_test_suite = CU_add_suite("Stats",
+		init_stats_test_suite, teardown_stats_test_suite);
+	if(!stats_test_suite) {
+		return CU_get_error();
+	}
+
+	/* add the tests to the suite */
+	if(!CU_add_test(stats_test_suite,
+		"Count input lines", test_stats_count_lines)) {
+		return CU_get_error();
+	}
+
+	if(!CU_add_test(stats_test_suite,
+		"Time assembler phases", test_stats_phase_timing)) {
+		return CU_get_error();
+	}
+
+	if(!CU_add_test(stats_test_suite,
+		"Time the CPU use of other threads", test_stats_thread_cpu_time)) {
+		return CU_get_error();
+	}
+
+	if(!CU_add_test(stats_test_suite,
+		"Write trace events", test_stats_trace_events)) {
+		return CU_get_error();
+	}
+
+	CU_pSuite string_pool_test_suite = CU_add_suite("String Pool",
+		init_string_pool_test_suite, teardown_string_pool_test_suite);
+	if(!string_pool_test_suite) {
+		return CU_get_error();
+	}
+
+	/* add the tests to the suite */
+	if(!CU_add_test(string_pool_test_suite,
+		"Deduplicate interned strings", test_string_pool_deduplicate)) {
+		return CU_get_error();
+	}
+
+	if(!CU_add_test(string_pool_test_suite,
+		"Intern strings after pool growth", test_string_pool_growth)) {
+		return CU_get_error();
+	}
+
+	CU_pSuite symtab_test_suite = CU_add_suite("Symbol Table",
+		init_symtab_test_suite, teardown_symtab_test_suite);
+	if(!symtab_test_suite) {
+		return CU_get_error();
+	}
+
+	/* add the tests to the suite */
+	if(!CU_add_test(symtab_test_suite,
+		"Find symbol by exact name", test_symtab_find_exact_match)) {
+		return CU_get_error();
+	}
+
+	if(!CU_add_test(symtab_test_suite,
+		"Find symbols after index growth", test_symtab_find_after_growth)) {
+		return CU_get_error();
+	}
+
+	if(!CU_add_test(symtab_test_suite,
+		"Reserve symbol table space", test_symtab_reserve)) {
+		return CU_get_error();
+	}
+
+	CU_pSuite trace_test_suite = CU_add_suite("Trace",
+		init_trace_test_suite, teardown_trace_test_suite);
+	if(!trace_test_suite) {
 		return CU_get_error();
 	}
 
 	/* add the tests to the suite */
-	if(!CU_add_test(preprocessor_test_suite,
-		"Process line without trailing newline", test_no_trailing_newline)) {
+	if(!CU_add_test(trace_test_suite,
+		"Enable trace channels by name", test_trace_enable_channels)) {
 		return CU_get_error();
 	}
 
@@ -0,0 +1,137 @@
+#include <CUnit/CUnit.h>
+#include <CUnit/CUError.h>
+#include <CUnit/Basic.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <arena.h>
+#include <as.h>
+#include <input.h>
+#include <statement.h>
+#include <string_pool.h>
+#include <test.h>
+
+/** The size of the buffer that error messages are captured into. */
+#define PARSER_TEST_ERRORS_SIZE 1024
+
+int init_parser_test_suite(void) {
+	return 0;
+}
+
+
+int teardown_parser_test_suite(void) {
+	return 0;
+}
+
+
+/**
+ * Scans and parses a source string, capturing any error messages printed to
+ * STDERR.
+ */
+static Assembler_Status parse_source(const char* source,
+	Statement_List* statements,
+	char* errors)
+{
+	Arena arena;
+	String_Pool string_pool;
+	Assembler_Status status;
+	const size_t source_len = strlen(source);
+	// The scanner requires two trailing NUL bytes.
+	char* buffer = calloc(source_len + 2, 1);
+	FILE* error_file = tmpfile();
+	int saved_stderr = -1;
+	size_t errors_len = 0;
+
+	CU_ASSERT_FATAL(buffer != NULL);
+	CU_ASSERT_FATAL(error_file != NULL);
+	CU_ASSERT_FATAL(initialise_arena(&arena) == ASSEMBLER_STATUS_SUCCESS);
+	CU_ASSERT_FATAL(initialise_string_pool(&string_pool) ==
+		ASSEMBLER_STATUS_SUCCESS);
+	memcpy(buffer, source, source_len);
+	memset(statements, 0, sizeof(Statement_List));
+
+	fflush(stderr);
+	saved_stderr = dup(STDERR_FILENO);
+	dup2(fileno(error_file), STDERR_FILENO);
+
+	status = scan_buffer(buffer, source_len, &arena, &string_pool, statements);
+
+	fflush(stderr);
+	dup2(saved_stderr, STDERR_FILENO);
+	close(saved_stderr);
+
+	rewind(error_file);
+	errors_len = fread(errors, 1, PARSER_TEST_ERRORS_SIZE - 1, error_file);
+	errors[errors_len] = '\0';
+	fclose(error_file);
+
+	// Only the number of statements is checked, so the statements themselves
+	// are freed with the arena.
+	free_string_pool(&string_pool);
+	free_arena(&arena);
+	free(buffer);
+
+	return status;
+}
+
+
+/**
+ * Tests that a syntax error is reported on the line containing it, and that
+ * parsing resumes at the next statement.
+ */
+void test_parser_error_line(void)
+{
+	Statement_List statements;
+	char errors[PARSER_TEST_ERRORS_SIZE];
+	const char* source = "addu $t0, $t1, $t2\n"
+		"addu $t0, $t1,\n"
+		"nop\n";
+
+	CU_ASSERT(parse_source(source, &statements, errors) ==
+		ASSEMBLER_STATUS_BAD_INPUT);
+	CU_ASSERT(strstr(errors, "Line 2:") != NULL);
+	CU_ASSERT(strstr(errors, "Line 3:") == NULL);
+	CU_ASSERT(statements.n_statements == 2);
+}
+
+
+/**
+ * Tests that an unterminated string literal is reported on its own line, and
+ * that it does not consume the statements which follow it.
+ */
+void test_parser_unterminated_string(void)
+{
+	Statement_List statements;
+	char errors[PARSER_TEST_ERRORS_SIZE];
+	const char* source = ".asciiz \"unterminated\n"
+		"nop\n"
+		".asciiz \"terminated\"\n";
+
+	CU_ASSERT(parse_source(source, &statements, errors) ==
+		ASSEMBLER_STATUS_BAD_INPUT);
+	CU_ASSERT(strstr(errors, "Line 1: Unterminated string literal") != NULL);
+	CU_ASSERT(strstr(errors, "Line 2:") == NULL);
+	CU_ASSERT(strstr(errors, "Line 3:") == NULL);
+	CU_ASSERT(statements.n_statements == 2);
+}
+
+
+/**
+ * Tests that an unrecognised register name is reported on its own line, rather
+ * than being assembled as another register.
+ */
+void test_parser_unknown_register(void)
+{
+	Statement_List statements;
+	char errors[PARSER_TEST_ERRORS_SIZE];
+	const char* source = "addu $t10, $a0, $a1\n"
+		"nop\n";
+
+	CU_ASSERT(parse_source(source, &statements, errors) ==
+		ASSEMBLER_STATUS_BAD_INPUT);
+	CU_ASSERT(strstr(errors, "Line 1: Unrecognised register `$t10`") != NULL);
+	CU_ASSERT(strstr(errors, "Line 2:") == NULL);
+	CU_ASSERT(statements.n_statements == 1);
+}
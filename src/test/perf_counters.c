@@ -0,0 +1,64 @@
+#include <CUnit/CUnit.h>
+#include <CUnit/CUError.h>
+#include <CUnit/Basic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+#include <as.h>
+#include <perf_counters.h>
+#include <test.h>
+
+int init_perf_counters_test_suite(void) {
+	return 0;
+}
+
+
+int teardown_perf_counters_test_suite(void) {
+	return 0;
+}
+
+
+/**
+ * Tests counting hardware events, where the kernel allows it.
+ */
+void test_perf_counters_count(void)
+{
+	Perf_Counter_Group group;
+	Perf_Counts counts;
+	Assembler_Status status = ASSEMBLER_STATUS_SUCCESS;
+	volatile size_t sum = 0;
+
+	memset(&counts, 0, sizeof(Perf_Counts));
+
+	// Nothing is counted while the counters are disabled.
+	perf_counters_begin(&group);
+	perf_counters_end(&group, &counts);
+	CU_ASSERT(counts.counted == 0);
+
+	// The counters are unavailable in many virtual machines and containers, in
+	// which case they must remain disabled.
+	status = perf_counters_enable();
+	CU_ASSERT(status == ASSEMBLER_STATUS_SUCCESS ||
+		status == ASSEMBLER_STATUS_BAD_INPUT);
+	CU_ASSERT(perf_counters_enabled == (status == ASSEMBLER_STATUS_SUCCESS));
+	if(!perf_counters_enabled) {
+		return;
+	}
+
+	perf_counters_begin(&group);
+	for(size_t i = 0; i < 100000; i++) {
+		sum += i;
+	}
+	perf_counters_end(&group, &counts);
+
+	CU_ASSERT(counts.counted != 0);
+	if(counts.counted & (1u << PERF_COUNTER_INSTRUCTIONS)) {
+		CU_ASSERT(counts.counts[PERF_COUNTER_INSTRUCTIONS] >= 100000);
+	}
+
+	for(size_t i = 0; i < PERF_COUNTER_COUNT; i++) {
+		CU_ASSERT(group.fds[i] == -1);
+	}
+
+	perf_counters_enabled = false;
+}
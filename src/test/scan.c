@@ -0,0 +1,79 @@
+#include <CUnit/CUError.h>
+#include <CUnit/Basic.h>
+#include <stdbool.h>
+#include <string.h>
+#include <scan.h>
+#include <test.h>
+
+int init_scan_test_suite(void) {
+	return 0;
+}
+
+
+int teardown_scan_test_suite(void) {
+	return 0;
+}
+
+
+/**
+ * Tests that blank characters are skipped at every offset and length, including
+ * where the result lies in the tail that is not a whole vector.
+ */
+void test_scan_skip_blank(void)
+{
+	char test_buffer[96];
+	bool results_match = true;
+
+	for(size_t length = 0; length <= sizeof(test_buffer); length++) {
+		for(size_t offset = 0; offset <= length; offset++) {
+			memset(test_buffer, ' ', sizeof(test_buffer));
+			memset(test_buffer, '\t', offset / 2);
+			if(offset < length) {
+				test_buffer[offset] = 'x';
+			}
+
+			const char* end = test_buffer + length;
+			const char* expected = scan_skip_blank_scalar(test_buffer, end);
+
+			if(expected != test_buffer + offset ||
+				scan_skip_blank(test_buffer, end) != expected) {
+				results_match = false;
+			}
+		}
+	}
+
+	CU_ASSERT(results_match);
+}
+
+
+/**
+ * Tests that a newline is found at every offset and length, and that other
+ * characters significant to the lexer are not mistaken for one.
+ */
+void test_scan_find_newline(void)
+{
+	const char others[] = { ' ', '\t', '\"', '#', '\r', '\0' };
+	char test_buffer[96];
+	bool results_match = true;
+
+	for(size_t o = 0; o < sizeof(others); o++) {
+		for(size_t length = 0; length <= sizeof(test_buffer); length++) {
+			for(size_t offset = 0; offset <= length; offset++) {
+				memset(test_buffer, others[o], sizeof(test_buffer));
+				if(offset < length) {
+					test_buffer[offset] = '\n';
+				}
+
+				const char* end = test_buffer + length;
+				const char* expected = scan_find_newline_scalar(test_buffer, end);
+
+				if(expected != test_buffer + offset ||
+					scan_find_newline(test_buffer, end) != expected) {
+					results_match = false;
+				}
+			}
+		}
+	}
+
+	CU_ASSERT(results_match);
+}
@@ -0,0 +1,210 @@
+#include <CUnit/CUnit.h>
+#include <CUnit/CUError.h>
+#include <CUnit/Basic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <as.h>
+#include <section.h>
+#include <string_pool.h>
+#include <test.h>
+
+int init_section_test_suite(void) {
+	return 0;
+}
+
+
+int teardown_section_test_suite(void) {
+	return 0;
+}
+
+
+/**
+ * Tests that data written to a section remains contiguous as the section grows.
+ */
+void test_section_write_growth(void)
+{
+	Section* section = NULL;
+	Assembler_Status status;
+	uint32_t word = 0;
+	bool contiguous = true;
+
+	status = create_section(&section, ".text", SHT_PROGBITS,
+		SHF_ALLOC | SHF_EXECINSTR);
+	CU_ASSERT(status == ASSEMBLER_STATUS_SUCCESS);
+	CU_ASSERT(section->size == 0);
+
+	for(uint32_t i = 0; i < 0x4000; i++) {
+		status = section_write(section, &i, sizeof(uint32_t));
+		CU_ASSERT_FATAL(status == ASSEMBLER_STATUS_SUCCESS);
+	}
+
+	CU_ASSERT(section->size == 0x4000 * sizeof(uint32_t));
+	CU_ASSERT(section->capacity >= section->size);
+
+	for(uint32_t i = 0; i < 0x4000; i++) {
+		memcpy(&word, section->data + (i * sizeof(uint32_t)), sizeof(uint32_t));
+		if(word != i) {
+			contiguous = false;
+		}
+	}
+
+	CU_ASSERT(contiguous);
+
+	// Writing nothing does not change the section.
+	status = section_write(section, NULL, 0);
+	CU_ASSERT(status == ASSEMBLER_STATUS_SUCCESS);
+	CU_ASSERT(section->size == 0x4000 * sizeof(uint32_t));
+
+	free_section(section);
+}
+
+
+/**
+ * Tests reserving section data, and recording relocation entries.
+ */
+void test_section_reserve_and_reloc(void)
+{
+	Section* section = NULL;
+	Assembler_Status status;
+	uint8_t* data = NULL;
+
+	status = create_section(&section, ".data", SHT_PROGBITS,
+		SHF_ALLOC | SHF_WRITE);
+	CU_ASSERT(status == ASSEMBLER_STATUS_SUCCESS);
+
+	status = section_reserve(section, 0x10000);
+	CU_ASSERT(status == ASSEMBLER_STATUS_SUCCESS);
+	CU_ASSERT(section->capacity >= 0x10000);
+
+	data = section->data;
+	CU_ASSERT_PTR_NOT_NULL(section_append(section, 0x10000));
+
+	// Appending within the reserved capacity does not move the data.
+	CU_ASSERT(section->data == data);
+	CU_ASSERT(section->size == 0x10000);
+
+	for(size_t i = 0; i < 100; i++) {
+		status = section_add_reloc_entry(section, (String_Id)i, i * 4, R_MIPS_26);
+		CU_ASSERT_FATAL(status == ASSEMBLER_STATUS_SUCCESS);
+	}
+
+	CU_ASSERT(section->n_reloc_entries == 100);
+	CU_ASSERT(section->reloc_entries[0].offset == 0);
+	CU_ASSERT(section->reloc_entries[99].symbol_name == 99);
+	CU_ASSERT(section->reloc_entries[99].offset == 396);
+	CU_ASSERT(section->reloc_entries[99].type == R_MIPS_26);
+
+	free_section(section);
+}
+
+
+/**
+ * Tests that sections are laid out at aligned, disjoint file offsets.
+ */
+void test_section_layout(void)
+{
+	Section* sections = NULL;
+	Section* text = NULL;
+	Section* strtab = NULL;
+	Section* bss = NULL;
+	Section* symtab = NULL;
+	Assembler_Status status;
+	size_t end = 0;
+
+	status = create_section(&text, ".text", SHT_PROGBITS,
+		SHF_ALLOC | SHF_EXECINSTR);
+	CU_ASSERT_FATAL(status == ASSEMBLER_STATUS_SUCCESS);
+	status = create_section(&strtab, ".strtab", SHT_STRTAB, 0);
+	CU_ASSERT_FATAL(status == ASSEMBLER_STATUS_SUCCESS);
+	status = create_section(&bss, ".bss", SHT_NOBITS, SHF_ALLOC | SHF_WRITE);
+	CU_ASSERT_FATAL(status == ASSEMBLER_STATUS_SUCCESS);
+	status = create_section(&symtab, ".symtab", SHT_SYMTAB, SHF_ALLOC);
+	CU_ASSERT_FATAL(status == ASSEMBLER_STATUS_SUCCESS);
+
+	CU_ASSERT(text->alignment == 4);
+	CU_ASSERT(strtab->alignment == 1);
+	CU_ASSERT(symtab->entry_size == sizeof(Elf32_Sym));
+
+	add_section(&sections, text);
+	add_section(&sections, strtab);
+	add_section(&sections, bss);
+	add_section(&sections, symtab);
+
+	CU_ASSERT_PTR_NOT_NULL(section_append(text, 8));
+	CU_ASSERT_PTR_NOT_NULL(section_append(strtab, 5));
+	CU_ASSERT_PTR_NOT_NULL(section_append(bss, 64));
+	CU_ASSERT_PTR_NOT_NULL(section_append(symtab, sizeof(Elf32_Sym)));
+
+	end = layout_sections(sections, 0x34);
+
+	CU_ASSERT(text->file_offset == 0x34);
+	CU_ASSERT(strtab->file_offset == 0x3C);
+	// The strtab ends at 0x41, and `.bss` occupies no space in the file.
+	CU_ASSERT(bss->file_offset == 0x44);
+	CU_ASSERT(symtab->file_offset == 0x44);
+	CU_ASSERT(end == 0x44 + sizeof(Elf32_Sym));
+
+	CU_ASSERT(align_file_offset(0x41, 0) == 0x41);
+	CU_ASSERT(align_file_offset(0x41, 16) == 0x50);
+
+	free_section(sections);
+}
+
+
+/**
+ * Tests that windows write directly into their range of a section's data,
+ * keep their own relocation entries, and can not be grown past their range.
+ */
+void test_section_window(void)
+{
+	Section* section = NULL;
+	Section first;
+	Section second;
+	Assembler_Status status;
+	uint32_t word = 0;
+
+	status = create_section(&section, ".text", SHT_PROGBITS,
+		SHF_ALLOC | SHF_EXECINSTR);
+	CU_ASSERT(status == ASSEMBLER_STATUS_SUCCESS);
+
+	status = section_reserve(section, 16);
+	CU_ASSERT_FATAL(status == ASSEMBLER_STATUS_SUCCESS);
+
+	section_window(&first, section, 0, 8);
+	section_window(&second, section, 8, 8);
+	CU_ASSERT(first.parent == section);
+	CU_ASSERT(second.program_counter == 8);
+
+	// Windows can be written in any order.
+	word = 0xCAFEBABE;
+	CU_ASSERT(section_write(&second, &word, sizeof(uint32_t)) == ASSEMBLER_STATUS_SUCCESS);
+	CU_ASSERT(section_write(&second, &word, sizeof(uint32_t)) == ASSEMBLER_STATUS_SUCCESS);
+	word = 0xDEADBEEF;
+	CU_ASSERT(section_write(&first, &word, sizeof(uint32_t)) == ASSEMBLER_STATUS_SUCCESS);
+	CU_ASSERT(section_write(&first, &word, sizeof(uint32_t)) == ASSEMBLER_STATUS_SUCCESS);
+
+	memcpy(&word, section->data + 4, sizeof(uint32_t));
+	CU_ASSERT(word == 0xDEADBEEF);
+	memcpy(&word, section->data + 8, sizeof(uint32_t));
+	CU_ASSERT(word == 0xCAFEBABE);
+	CU_ASSERT(section->size == 0);
+
+	status = section_add_reloc_entry(&second, 1, 12, R_MIPS_26);
+	CU_ASSERT(status == ASSEMBLER_STATUS_SUCCESS);
+	CU_ASSERT(second.n_reloc_entries == 1);
+	CU_ASSERT(section->n_reloc_entries == 0);
+
+	// Writing past the end of the window fails rather than resizing the
+	// parent's data.
+	status = section_write(&first, &word, 1);
+	CU_ASSERT(!get_status(status));
+	CU_ASSERT(first.size == 8);
+
+	free_section_window(&first);
+	free_section_window(&second);
+	CU_ASSERT_PTR_NULL(second.reloc_entries);
+
+	free_section(section);
+}
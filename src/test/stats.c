@@ -0,0 +1,184 @@
+#include <CUnit/CUnit.h>
+#include <CUnit/CUError.h>
+#include <CUnit/Basic.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <as.h>
+#include <stats.h>
+#include <test.h>
+
+/** The CPU time used by the job thread in the CPU time test, in seconds. */
+#define STATS_TEST_JOB_CPU_TIME 0.02
+
+int init_stats_test_suite(void) {
+	return 0;
+}
+
+
+int teardown_stats_test_suite(void) {
+	return 0;
+}
+
+
+/**
+ * Tests counting the lines of input, with and without a trailing newline.
+ */
+void test_stats_count_lines(void)
+{
+	Assembly_Stats stats;
+	const char* terminated = "li $t0, 1\n\nsyscall\n";
+	const char* unterminated = "li $t0, 1\nsyscall";
+
+	memset(&stats, 0, sizeof(Assembly_Stats));
+
+	stats_count_lines(&stats, terminated, strlen(terminated));
+	CU_ASSERT(stats.n_lines == 3);
+
+	stats_count_lines(&stats, unterminated, strlen(unterminated));
+	CU_ASSERT(stats.n_lines == 2);
+
+	stats_count_lines(&stats, "", 0);
+	CU_ASSERT(stats.n_lines == 0);
+
+	// Nothing is recorded when statistics are disabled.
+	stats_count_lines(NULL, terminated, strlen(terminated));
+}
+
+
+/**
+ * Tests that phase timings accumulate, and that the report format is parsed.
+ */
+void test_stats_phase_timing(void)
+{
+	Assembly_Stats stats;
+	Stats_Timer timer;
+	Stats_Format format = STATS_FORMAT_TEXT;
+	volatile size_t sum = 0;
+
+	memset(&stats, 0, sizeof(Assembly_Stats));
+
+	stats_begin_phase(&stats, &timer);
+	for(size_t i = 0; i < 100000; i++) {
+		sum += i;
+	}
+	stats_end_phase(&stats, STATS_PHASE_FIRST_PASS, &timer);
+
+	CU_ASSERT(stats.phases[STATS_PHASE_FIRST_PASS].wall_time > 0);
+	CU_ASSERT(stats.phases[STATS_PHASE_FIRST_PASS].cpu_time >= 0);
+	CU_ASSERT(stats.phases[STATS_PHASE_FIRST_PASS].peak_rss > 0);
+	CU_ASSERT(stats.phases[STATS_PHASE_SECOND_PASS].wall_time == 0);
+
+	// A phase timed in several parts accumulates its totals.
+	const double first_part = stats.phases[STATS_PHASE_FIRST_PASS].wall_time;
+	stats_begin_phase(&stats, &timer);
+	stats_end_phase(&stats, STATS_PHASE_FIRST_PASS, &timer);
+	CU_ASSERT(stats.phases[STATS_PHASE_FIRST_PASS].wall_time >= first_part);
+
+	CU_ASSERT(parse_stats_format(NULL, &format) == ASSEMBLER_STATUS_SUCCESS);
+	CU_ASSERT(format == STATS_FORMAT_TEXT);
+	CU_ASSERT(parse_stats_format("json", &format) == ASSEMBLER_STATUS_SUCCESS);
+	CU_ASSERT(format == STATS_FORMAT_JSON);
+	CU_ASSERT(parse_stats_format("jsonx", &format) == ASSEMBLER_STATUS_BAD_INPUT);
+}
+
+
+/**
+ * Uses CPU time on a job thread, storing the time used.
+ */
+static void* stats_test_job(void* cpu_time)
+{
+	const double start = stats_get_thread_cpu_time();
+	volatile size_t sum = 0;
+
+	while(stats_get_thread_cpu_time() - start < STATS_TEST_JOB_CPU_TIME) {
+		sum++;
+	}
+
+	*(double*)cpu_time = stats_get_thread_cpu_time() - start;
+
+	return NULL;
+}
+
+
+/**
+ * Tests that a phase's CPU time only includes that of the thread timing it,
+ * and that the time used by its jobs on other threads can be added.
+ */
+void test_stats_thread_cpu_time(void)
+{
+	Assembly_Stats stats;
+	Stats_Timer timer;
+	pthread_t thread;
+	double job_cpu_time = 0;
+
+	memset(&stats, 0, sizeof(Assembly_Stats));
+
+	stats_begin_phase(&stats, &timer);
+	CU_ASSERT_FATAL(pthread_create(&thread, NULL, stats_test_job,
+		&job_cpu_time) == 0);
+	pthread_join(thread, NULL);
+	stats_end_phase(&stats, STATS_PHASE_SECOND_PASS, &timer);
+
+	CU_ASSERT(job_cpu_time >= STATS_TEST_JOB_CPU_TIME);
+	CU_ASSERT(stats.phases[STATS_PHASE_SECOND_PASS].cpu_time <
+		STATS_TEST_JOB_CPU_TIME);
+
+	stats_add_cpu_time(&stats, STATS_PHASE_SECOND_PASS, job_cpu_time);
+	CU_ASSERT(stats.phases[STATS_PHASE_SECOND_PASS].cpu_time >= job_cpu_time);
+	CU_ASSERT(stats.phases[STATS_PHASE_FIRST_PASS].cpu_time == 0);
+
+	// Nothing is recorded when statistics are disabled.
+	stats_add_cpu_time(NULL, STATS_PHASE_SECOND_PASS, job_cpu_time);
+}
+
+
+/**
+ * Tests that phases and spans are written to the trace event file.
+ */
+void test_stats_trace_events(void)
+{
+	Assembly_Stats stats;
+	Stats_Timer timer;
+	char filename[] = "/tmp/stats_trace_XXXXXX";
+	char contents[1024];
+	FILE* file = NULL;
+	size_t len = 0;
+	int fd = mkstemp(filename);
+
+	CU_ASSERT_FATAL(fd != -1);
+	memset(&stats, 0, sizeof(Assembly_Stats));
+	stats.input_filename = "trace\"test\".S";
+
+	// Nothing is recorded before the trace event file is opened.
+	stats_begin_span(&timer);
+	stats_end_span(&timer, "ignored", "job", stats.input_filename);
+	CU_ASSERT(close_trace_event_file() == ASSEMBLER_ERROR_BAD_FUNCTION_ARGS);
+
+	CU_ASSERT_FATAL(open_trace_event_file(filename) == ASSEMBLER_STATUS_SUCCESS);
+	CU_ASSERT(trace_events_enabled);
+
+	stats_begin_span(&timer);
+	stats_begin_phase(&stats, &timer);
+	stats_end_phase(&stats, STATS_PHASE_PARSE, &timer);
+	stats_end_span(&timer, "assemble", "file", stats.input_filename);
+
+	CU_ASSERT(close_trace_event_file() == ASSEMBLER_STATUS_SUCCESS);
+	CU_ASSERT(!trace_events_enabled);
+
+	file = fdopen(fd, "r");
+	CU_ASSERT_FATAL(file != NULL);
+	len = fread(contents, 1, sizeof(contents) - 1, file);
+	contents[len] = '\0';
+	fclose(file);
+	remove(filename);
+
+	CU_ASSERT(strncmp(contents, "{\"traceEvents\":[", 16) == 0);
+	CU_ASSERT(strstr(contents, "\"name\":\"parse\",\"cat\":\"phase\",\"ph\":\"X\"") != NULL);
+	CU_ASSERT(strstr(contents, "\"name\":\"assemble\",\"cat\":\"file\"") != NULL);
+	CU_ASSERT(strstr(contents, "\"file\":\"trace\\\"test\\\".S\"") != NULL);
+	CU_ASSERT(strstr(contents, "ignored") == NULL);
+}
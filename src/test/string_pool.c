@@ -0,0 +1,92 @@
+#include <CUnit/CUError.h>
+#include <CUnit/Basic.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <as.h>
+#include <string_pool.h>
+#include <test.h>
+
+int init_string_pool_test_suite(void) {
+	return 0;
+}
+
+
+int teardown_string_pool_test_suite(void) {
+	return 0;
+}
+
+
+/**
+ * Tests that identical strings are interned once, and distinct strings are
+ * given distinct identifiers.
+ */
+void test_string_pool_deduplicate(void)
+{
+	String_Pool string_pool;
+	Assembler_Status status;
+	String_Id foo = 0;
+	String_Id foo_again = 0;
+	String_Id foobar = 0;
+	String_Id empty = 0;
+
+	status = initialise_string_pool(&string_pool);
+	CU_ASSERT(status == ASSEMBLER_STATUS_SUCCESS);
+
+	CU_ASSERT(string_pool_intern(&string_pool, "foo", 3, &foo) ==
+		ASSEMBLER_STATUS_SUCCESS);
+	CU_ASSERT(string_pool_intern(&string_pool, "foobar", 6, &foobar) ==
+		ASSEMBLER_STATUS_SUCCESS);
+	// Only the first three characters are interned.
+	CU_ASSERT(string_pool_intern(&string_pool, "foo:", 3, &foo_again) ==
+		ASSEMBLER_STATUS_SUCCESS);
+	CU_ASSERT(string_pool_intern(&string_pool, "", 0, &empty) ==
+		ASSEMBLER_STATUS_SUCCESS);
+
+	CU_ASSERT(foo == foo_again);
+	CU_ASSERT(foo != foobar);
+	CU_ASSERT(empty == 0);
+	CU_ASSERT(strcmp(string_pool_get(&string_pool, foo), "foo") == 0);
+	CU_ASSERT(strcmp(string_pool_get(&string_pool, foobar), "foobar") == 0);
+	CU_ASSERT(strcmp(string_pool_get(&string_pool, empty), "") == 0);
+
+	free_string_pool(&string_pool);
+}
+
+
+/**
+ * Tests that string identifiers remain valid as the pool grows.
+ */
+void test_string_pool_growth(void)
+{
+	String_Pool string_pool;
+	Assembler_Status status;
+	char name[32];
+	String_Id ids[5000];
+	String_Id id = 0;
+	bool all_match = true;
+
+	status = initialise_string_pool(&string_pool);
+	CU_ASSERT(status == ASSEMBLER_STATUS_SUCCESS);
+
+	for(size_t i = 0; i < 5000; i++) {
+		snprintf(name, sizeof(name), "symbol_name_%zu", i);
+		if(string_pool_intern(&string_pool, name, strlen(name), &ids[i]) !=
+			ASSEMBLER_STATUS_SUCCESS) {
+			all_match = false;
+		}
+	}
+
+	for(size_t i = 0; i < 5000; i++) {
+		snprintf(name, sizeof(name), "symbol_name_%zu", i);
+		string_pool_intern(&string_pool, name, strlen(name), &id);
+		if(id != ids[i] || strcmp(string_pool_get(&string_pool, id), name) != 0) {
+			all_match = false;
+		}
+	}
+
+	CU_ASSERT(all_match);
+	CU_ASSERT(string_pool.n_strings == 5001);
+
+	free_string_pool(&string_pool);
+}
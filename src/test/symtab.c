@@ -0,0 +1,162 @@
+#include <CUnit/CUError.h>
+#include <CUnit/Basic.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <as.h>
+#include <section.h>
+#include <string_pool.h>
+#include <symtab.h>
+#include <test.h>
+
+int init_symtab_test_suite(void) {
+	return 0;
+}
+
+
+int teardown_symtab_test_suite(void) {
+	return 0;
+}
+
+
+/**
+ * Interns a NUL terminated string, returning its identifier.
+ */
+static String_Id intern(String_Pool* string_pool,
+	const char* string)
+{
+	String_Id id = 0;
+	CU_ASSERT(string_pool_intern(string_pool, string, strlen(string), &id) ==
+		ASSEMBLER_STATUS_SUCCESS);
+
+	return id;
+}
+
+
+/**
+ * Tests that symbols are only found by an exact match of their name.
+ */
+void test_symtab_find_exact_match(void)
+{
+	Symbol_Table symbol_table;
+	String_Pool string_pool;
+	Section* section = NULL;
+	Assembler_Status status;
+
+	status = initialise_string_pool(&string_pool);
+	CU_ASSERT(status == ASSEMBLER_STATUS_SUCCESS);
+
+	status = initialise_symbol_table(&symbol_table, &string_pool);
+	CU_ASSERT(status == ASSEMBLER_STATUS_SUCCESS);
+
+	status = create_section(&section, ".text", SHT_PROGBITS, 0);
+	CU_ASSERT(status == ASSEMBLER_STATUS_SUCCESS);
+
+	CU_ASSERT(symtab_add_symbol(&symbol_table, intern(&string_pool, "foobar"),
+		section, 0x10) != NULL);
+	CU_ASSERT(symtab_add_symbol(&symbol_table, intern(&string_pool, "foo"),
+		section, 0x20) != NULL);
+
+	CU_ASSERT(symtab_find_symbol_index(&symbol_table, intern(&string_pool, "foo")) == 2);
+	CU_ASSERT(symtab_find_symbol_index(&symbol_table, intern(&string_pool, "foobar")) == 1);
+	CU_ASSERT(symtab_find_symbol(&symbol_table, intern(&string_pool, "foo"))->offset == 0x20);
+	CU_ASSERT(symtab_find_symbol(&symbol_table, intern(&string_pool, "fo")) == NULL);
+	CU_ASSERT(symtab_find_symbol(&symbol_table, intern(&string_pool, "foobarbaz")) == NULL);
+
+	free_symbol_table(&symbol_table);
+	free_string_pool(&string_pool);
+	free_section(section);
+}
+
+
+/**
+ * Tests that every symbol can still be found after the symbol table index has
+ * been resized many times.
+ */
+void test_symtab_find_after_growth(void)
+{
+	Symbol_Table symbol_table;
+	String_Pool string_pool;
+	Section* section = NULL;
+	Assembler_Status status;
+	char name[32];
+	bool all_found = true;
+	const size_t n_symbols = 1000;
+
+	status = initialise_string_pool(&string_pool);
+	CU_ASSERT(status == ASSEMBLER_STATUS_SUCCESS);
+
+	status = initialise_symbol_table(&symbol_table, &string_pool);
+	CU_ASSERT(status == ASSEMBLER_STATUS_SUCCESS);
+
+	status = create_section(&section, ".text", SHT_PROGBITS, 0);
+	CU_ASSERT(status == ASSEMBLER_STATUS_SUCCESS);
+
+	for(size_t i = 0; i < n_symbols; i++) {
+		snprintf(name, sizeof(name), "label_%zu", i);
+		if(!symtab_add_symbol(&symbol_table, intern(&string_pool, name), section, i * 4)) {
+			all_found = false;
+		}
+	}
+
+	for(size_t i = 0; i < n_symbols; i++) {
+		snprintf(name, sizeof(name), "label_%zu", i);
+		if(symtab_find_symbol_index(&symbol_table, intern(&string_pool, name)) !=
+			(ssize_t)(i + 1)) {
+			all_found = false;
+		}
+	}
+
+	CU_ASSERT(all_found);
+	CU_ASSERT(symbol_table.n_entries == n_symbols + 1);
+	CU_ASSERT(symtab_find_symbol(&symbol_table, intern(&string_pool, "label_1000")) == NULL);
+
+	free_symbol_table(&symbol_table);
+	free_string_pool(&string_pool);
+	free_section(section);
+}
+
+
+/**
+ * Tests that symbol pointers remain valid after space has been reserved for
+ * all of the symbols being added.
+ */
+void test_symtab_reserve(void)
+{
+	Symbol_Table symbol_table;
+	String_Pool string_pool;
+	Section* section = NULL;
+	Assembler_Status status;
+	Symbol* first_symbol = NULL;
+	char name[32];
+	const size_t n_symbols = 1000;
+
+	status = initialise_string_pool(&string_pool);
+	CU_ASSERT(status == ASSEMBLER_STATUS_SUCCESS);
+
+	status = initialise_symbol_table(&symbol_table, &string_pool);
+	CU_ASSERT(status == ASSEMBLER_STATUS_SUCCESS);
+
+	status = create_section(&section, ".text", SHT_PROGBITS, 0);
+	CU_ASSERT(status == ASSEMBLER_STATUS_SUCCESS);
+
+	status = symtab_reserve(&symbol_table, n_symbols + 1);
+	CU_ASSERT(status == ASSEMBLER_STATUS_SUCCESS);
+	CU_ASSERT(symbol_table.capacity >= n_symbols + 1);
+
+	first_symbol = symtab_add_symbol(&symbol_table, intern(&string_pool, "label_0"),
+		section, 0);
+	for(size_t i = 1; i < n_symbols; i++) {
+		snprintf(name, sizeof(name), "label_%zu", i);
+		symtab_add_symbol(&symbol_table, intern(&string_pool, name), section, i * 4);
+	}
+
+	CU_ASSERT(symtab_find_symbol(&symbol_table, intern(&string_pool, "label_0")) ==
+		first_symbol);
+	CU_ASSERT(symtab_find_symbol(&symbol_table, intern(&string_pool, "label_999"))->offset ==
+		999 * 4);
+
+	free_symbol_table(&symbol_table);
+	free_string_pool(&string_pool);
+	free_section(section);
+}
@@ -0,0 +1,59 @@
+#include <CUnit/CUnit.h>
+#include <CUnit/CUError.h>
+#include <CUnit/Basic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <as.h>
+#include <trace.h>
+#include <test.h>
+
+int init_trace_test_suite(void) {
+	trace_enabled_channels = 0;
+	return 0;
+}
+
+
+int teardown_trace_test_suite(void) {
+	trace_enabled_channels = 0;
+	return 0;
+}
+
+
+/**
+ * Tests enabling trace channels by name, and rejecting unknown channel names.
+ */
+void test_trace_enable_channels(void)
+{
+	Assembler_Status status;
+
+	trace_enabled_channels = 0;
+	CU_ASSERT(!trace_is_enabled(TRACE_CHANNEL_CODEGEN));
+
+	status = trace_enable_channels("codegen,symbols");
+	CU_ASSERT(status == ASSEMBLER_STATUS_SUCCESS);
+	CU_ASSERT(trace_is_enabled(TRACE_CHANNEL_CODEGEN));
+	CU_ASSERT(trace_is_enabled(TRACE_CHANNEL_SYMBOLS));
+	CU_ASSERT(!trace_is_enabled(TRACE_CHANNEL_ASSEMBLER));
+
+	// Channel names must match exactly. A list with any unknown name enables
+	// none of its channels.
+	status = trace_enable_channels("output,code");
+	CU_ASSERT(status == ASSEMBLER_STATUS_BAD_INPUT);
+	CU_ASSERT(!trace_is_enabled(TRACE_CHANNEL_OUTPUT));
+
+	status = trace_enable_channels("lexer,");
+	CU_ASSERT(status == ASSEMBLER_STATUS_BAD_INPUT);
+	CU_ASSERT(!trace_is_enabled(TRACE_CHANNEL_LEXER));
+
+	trace_enable_channel(TRACE_CHANNEL_MACRO);
+	CU_ASSERT(trace_is_enabled(TRACE_CHANNEL_MACRO));
+
+	trace_enabled_channels = 0;
+	status = trace_enable_channels("all");
+	CU_ASSERT(status == ASSEMBLER_STATUS_SUCCESS);
+	for(size_t i = 0; i < TRACE_CHANNEL_COUNT; i++) {
+		CU_ASSERT(trace_is_enabled(i));
+	}
+
+	trace_enabled_channels = 0;
+}